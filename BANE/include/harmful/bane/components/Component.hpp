@@ -1,7 +1,6 @@
 #ifndef __BANE_COMPONENT__
 #define __BANE_COMPONENT__
 
-#include <functional>
 #include <harmful/doom/utils/Platform.hpp>
 #include "harmful/bane/entities/Entity.hpp"
 #include "harmful/bane/components/ComponentData.hpp"
@@ -9,9 +8,14 @@
 namespace Bane {
 	/// <summary>
 	/// Component of the ECS architecture.
-	/// It is a very simple structure that contains data in a composite 
-	/// ComponentData class.
+	/// It is a very simple structure that gives access to the data of a
+	/// Component, stored by its ComponentFactory.
 	/// </summary>
+	/// <remarks>
+	/// A Component is only a view on the data of its ComponentFactory: it is
+	/// invalidated as soon as Components are added to or removed from the
+	/// ComponentFactory.
+	/// </remarks>
 	class Component final {
 		friend class ComponentFactory;
 
@@ -24,32 +28,23 @@ namespace Bane {
 			/// <summary>
 			/// Data the Component contains for its process.
 			/// </summary>
-			std::unique_ptr<ComponentData> m_data = nullptr;
+			ComponentData* m_data = nullptr;
 
 		protected:
 			/// <summary>
 			/// Create a new Component instance.
 			/// </summary>
-			/// <param name="entity">
-			/// Entity to which the new Component is attached to.
+			/// <param name="entityID">
+			/// ID of the Entity to which the new Component is attached to.
 			/// </param>
 			/// <param name="data">Data of the new Component.</param>
-			Component(
-				const Entity& entity,
-				std::unique_ptr<ComponentData>&& data
-			);
+			Component(const id_t entityID, ComponentData* data);
 
 		public:
 			/// <summary>
-			/// Move constructor.
+			/// Create an invalid Component, attached to no Entity.
 			/// </summary>
-			/// <param name="other">Component to be moved.</param>
-			exported Component(Component&& other) = default;
-
-			/// <summary>
-			/// Destruction of the current Component instance.
-			/// </summary>
-			exported ~Component() = default;
+			exported Component() = default;
 
 			/// <summary>
 			/// Get the ID of the Entity the current Component is attached to.
@@ -65,19 +60,17 @@ namespace Bane {
 			/// <returns>Raw pointer to the inner ComponentData.</returns>
 			/// <remarks>Do not try to delete the data!</remarks>
 			exported ComponentData* data() const {
-				return m_data.get();
+				return m_data;
 			}
 
 			/// <summary>
-			/// Move operator.
+			/// Check if the Component is attached to an Entity (true) or not
+			/// (false).
 			/// </summary>
-			/// <param name="other">Component to be moved.</param>
-			exported Component& operator=(Component&& other) = default;
-
-		private:
-			// Disable copy.
-			Component(const Component& other) = delete;
-			Component& operator=(const Component& other) = delete;
+			/// <returns>true if valid; false otherwise.</returns>
+			exported bool isValid() const {
+				return m_data != nullptr;
+			}
 	};
 }
 
@@ -0,0 +1,524 @@
+#ifndef __BANE_COMPONENT_COLUMN__
+#define __BANE_COMPONENT_COLUMN__
+
+#include <harmful/doom/utils/Platform.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+#include "harmful/bane/entities/Entity.hpp"
+#include "harmful/bane/components/ComponentData.hpp"
+#include "harmful/bane/components/TypeIndex.hpp"
+
+namespace Bane {
+	class WorkerPool;
+
+	/// <summary>
+	/// Dense storage of the ComponentData of a single data type.
+	/// The data are packed one after the other in a single aligned buffer,
+	/// next to a column of the IDs of the Entities bearing them (structure of
+	/// arrays), so that a range of Components can be processed linearly.
+	/// 
+	/// Each data has a version at which it was added and a version at which
+	/// it was last changed, and each chunk of VersionChunkSize data has the
+	/// latest change version of its data, so that unchanged ranges can be
+	/// skipped at once.
+	/// </summary>
+	class ComponentColumn final {
+		public:
+			/// <summary>
+			/// Operations on the ComponentData type stored in a column, so
+			/// that the column does not need to know the concrete type.
+			/// </summary>
+			struct DataType {
+				/// <summary>
+				/// Run-time type information of the data type.
+				/// </summary>
+				const std::type_info* info;
+
+				/// <summary>
+				/// Dense identifier of the data type (see TypeIndex).
+				/// </summary>
+				uint32_t id;
+
+				/// <summary>
+				/// Size in bytes of one data.
+				/// </summary>
+				size_t size;
+
+				/// <summary>
+				/// Alignment in bytes of one data.
+				/// </summary>
+				size_t alignment;
+
+				/// <summary>
+				/// true if the data can be moved with a memcpy and does not
+				/// need to be destroyed.
+				/// </summary>
+				bool trivial;
+
+				/// <summary>
+				/// Move construct a data at the destination address from the
+				/// source address.
+				/// </summary>
+				void (*moveConstruct)(void* destination, void* source);
+
+				/// <summary>
+				/// Destroy the data at the given address.
+				/// </summary>
+				void (*destroy)(void* data);
+
+				/// <summary>
+				/// Get the DataType of a ComponentData subclass.
+				/// </summary>
+				/// <typeparam name="DataClass">
+				/// Subclass of ComponentData.
+				/// </typeparam>
+				/// <returns>The operations on the DataClass.</returns>
+				template <class DataClass>
+				static DataType Of() {
+					static_assert(
+						std::is_base_of_v<ComponentData, DataClass>,
+						"Only derived class from ComponentData can be used here."
+					);
+
+					return {
+						&typeid(DataClass),
+						TypeIndex<ComponentData>::Of<DataClass>(),
+						sizeof(DataClass),
+						alignof(DataClass),
+						std::is_trivially_copyable_v<DataClass>,
+						[](void* destination, void* source) {
+							new (destination) DataClass(
+								std::move(*static_cast<DataClass*>(source))
+							);
+						},
+						[](void* data) {
+							static_cast<DataClass*>(data) -> ~DataClass();
+						}
+					};
+				}
+			};
+
+			/// <summary>
+			/// Memory used by a column.
+			/// </summary>
+			struct MemoryStatistics {
+				/// <summary>
+				/// Amount of data stored.
+				/// </summary>
+				size_t amountData = 0;
+
+				/// <summary>
+				/// Amount of data that can be stored without allocation.
+				/// </summary>
+				size_t capacity = 0;
+
+				/// <summary>
+				/// Bytes used by the stored data.
+				/// </summary>
+				size_t usedBytes = 0;
+
+				/// <summary>
+				/// Bytes allocated for the data, used or not.
+				/// </summary>
+				size_t reservedBytes = 0;
+
+				/// <summary>
+				/// Bytes allocated for the bookkeeping of the data (Entity IDs,
+				/// versions, indices).
+				/// </summary>
+				size_t metadataBytes = 0;
+
+				/// <summary>
+				/// Amount of allocations of the data buffer since the creation
+				/// of the column.
+				/// </summary>
+				size_t amountAllocations = 0;
+			};
+
+			/// <summary>
+			/// Amount of data sharing a chunk version.
+			/// </summary>
+			static constexpr size_t VersionChunkSize = 64;
+
+		private:
+			/// <summary>
+			/// Minimal amount of data a column can store once it allocated
+			/// its buffer.
+			/// </summary>
+			static constexpr size_t MinimalCapacity = 16;
+
+			/// <summary>
+			/// Version used until the column is bound to the version of a
+			/// World.
+			/// </summary>
+			static inline const std::atomic<uint32_t> InitialVersion { 1 };
+
+			/// <summary>
+			/// Minimal size of a buffer, in bytes, to have it first touched by
+			/// the bound WorkerPool.
+			/// </summary>
+			static constexpr size_t MinimalTouchedSize = 1 << 20;
+
+			/// <summary>
+			/// Size of the chunks of a buffer first touched by the threads of
+			/// the bound WorkerPool, in bytes (a multiple of the page size).
+			/// </summary>
+			static constexpr size_t TouchedChunkSize = 256 << 10;
+
+			/// <summary>
+			/// Operations on the stored data type.
+			/// </summary>
+			DataType m_type;
+
+			/// <summary>
+			/// Buffer containing the data, aligned on the data type.
+			/// </summary>
+			std::byte* m_data = nullptr;
+
+			/// <summary>
+			/// Amount of data stored in the column.
+			/// </summary>
+			size_t m_count = 0;
+
+			/// <summary>
+			/// Amount of data the buffer can store without reallocation.
+			/// </summary>
+			size_t m_capacity = 0;
+
+			/// <summary>
+			/// Amount of allocations of the data buffer.
+			/// </summary>
+			size_t m_amountAllocations = 0;
+
+			/// <summary>
+			/// IDs of the Entities bearing the data, in the same order as the
+			/// data.
+			/// </summary>
+			std::vector<id_t> m_entities;
+
+			/// <summary>
+			/// Version given to the added and changed data, shared with the
+			/// World.
+			/// </summary>
+			const std::atomic<uint32_t>* m_version = &InitialVersion;
+
+			/// <summary>
+			/// Version at which each data was added.
+			/// </summary>
+			std::vector<uint32_t> m_addedVersions;
+
+			/// <summary>
+			/// Version at which each data was last changed.
+			/// </summary>
+			std::vector<uint32_t> m_changedVersions;
+
+			/// <summary>
+			/// Latest change version of the data of each chunk. Several
+			/// threads may change the data of a same chunk, so it is only
+			/// accessed atomically while the data are processed.
+			/// </summary>
+			std::vector<uint32_t> m_chunkVersions;
+
+			/// <summary>
+			/// Threads that first touch each new buffer; nullptr to allocate
+			/// it on the current thread.
+			/// </summary>
+			WorkerPool* m_workers = nullptr;
+
+		public:
+			/// <summary>
+			/// Create a new ComponentColumn instance.
+			/// </summary>
+			/// <param name="type">Operations on the stored data type.</param>
+			exported ComponentColumn(const DataType& type);
+
+			/// <summary>
+			/// Destruction of the ComponentColumn instance.
+			/// </summary>
+			exported ~ComponentColumn() noexcept;
+
+			/// <summary>
+			/// Reserve room in the column for the given amount of data.
+			/// </summary>
+			/// <param name="capacity">Wanted amount of data.</param>
+			exported void reserve(const size_t capacity);
+
+			/// <summary>
+			/// Append an uninitialized slot at the end of the column.
+			/// </summary>
+			/// <param name="entity">Entity bearing the new data.</param>
+			/// <returns>
+			/// Address of the new slot where the data must be constructed.
+			/// </returns>
+			/// <remarks>
+			/// The data MUST be constructed in the slot before any other
+			/// operation on the column, or the slot must be discarded with
+			/// discardBack().
+			/// </remarks>
+			exported void* allocateBack(const Entity& entity);
+
+			/// <summary>
+			/// Append uninitialized slots at the end of the column, one per
+			/// Entity, with at most one allocation.
+			/// </summary>
+			/// <param name="entities">Entities bearing the new data.</param>
+			/// <returns>
+			/// Address of the first new slot. The slots are contiguous.
+			/// </returns>
+			/// <remarks>
+			/// Same as allocateBack(const Entity&amp;) for each slot.
+			/// </remarks>
+			exported void* allocateBack(std::span<const Entity> entities);
+
+			/// <summary>
+			/// Remove the last slots without destroying their data. Used when
+			/// the construction of the data in slots from allocateBack()
+			/// failed.
+			/// </summary>
+			/// <param name="amount">Amount of slots to remove.</param>
+			exported void discardBack(const size_t amount = 1);
+
+			/// <summary>
+			/// Destroy the data at the given index. The last data of the
+			/// column is moved in place of it to keep the column dense.
+			/// </summary>
+			/// <param name="index">Index of the data to destroy.</param>
+			exported void swapAndPop(const size_t index);
+
+			/// <summary>
+			/// Move the data in a new order, with their Entities and
+			/// versions. The data are moved into a new buffer of the same
+			/// capacity.
+			/// </summary>
+			/// <param name="order">
+			/// Current index of the data to put at each index: a permutation
+			/// of the indices of the column.
+			/// </param>
+			exported void reorder(std::span<const uint32_t> order);
+
+			/// <summary>
+			/// Destroy all the data of the column. The buffer is kept.
+			/// </summary>
+			exported void clear();
+
+			/// <summary>
+			/// Get the amount of data stored in the column.
+			/// </summary>
+			/// <returns>Amount of data in the column.</returns>
+			exported size_t size() const {
+				return m_count;
+			}
+
+			/// <summary>
+			/// Get the amount of data the column can store without
+			/// reallocation.
+			/// </summary>
+			/// <returns>Capacity of the column.</returns>
+			exported size_t capacity() const {
+				return m_capacity;
+			}
+
+			/// <summary>
+			/// Get the memory used by the column.
+			/// </summary>
+			/// <returns>Memory statistics of the column.</returns>
+			exported MemoryStatistics memory() const;
+
+			/// <summary>
+			/// Get the operations on the stored data type.
+			/// </summary>
+			/// <returns>The stored data type.</returns>
+			exported const DataType& type() const {
+				return m_type;
+			}
+
+			/// <summary>
+			/// Get the ID of the Entity bearing the data at the given index.
+			/// </summary>
+			/// <param name="index">Index of the data.</param>
+			/// <returns>ID of the Entity.</returns>
+			exported id_t entityAt(const size_t index) const {
+				return m_entities[index];
+			}
+
+			/// <summary>
+			/// Get the IDs of the Entities bearing the data, in the order of
+			/// the data.
+			/// </summary>
+			/// <returns>IDs of the Entities.</returns>
+			exported std::span<const id_t> entities() const {
+				return std::span<const id_t>(m_entities);
+			}
+
+			/// <summary>
+			/// Get the data at the given index.
+			/// </summary>
+			/// <param name="index">Index of the data.</param>
+			/// <returns>The data at the given index.</returns>
+			exported ComponentData* dataAt(const size_t index) const {
+				return reinterpret_cast<ComponentData*>(
+					m_data + (index * m_type.size)
+				);
+			}
+
+			/// <summary>
+			/// Get all the data of the column with their concrete type.
+			/// </summary>
+			/// <typeparam name="DataClass">
+			/// Type of the data stored in the column.
+			/// </typeparam>
+			/// <returns>Contiguous range of all the data.</returns>
+			template <class DataClass>
+			exported std::span<DataClass> as() const {
+				return std::span<DataClass>(
+					std::launder(reinterpret_cast<DataClass*>(m_data)),
+					m_count
+				);
+			}
+
+			/// <summary>
+			/// Get the data at the given index to change it. The data is
+			/// marked as changed.
+			/// </summary>
+			/// <typeparam name="DataClass">
+			/// Type of the data stored in the column.
+			/// </typeparam>
+			/// <param name="index">Index of the data.</param>
+			/// <returns>The data at the given index.</returns>
+			template <class DataClass>
+			exported DataClass& write(const size_t index) {
+				markChanged(index);
+				return as<DataClass>()[index];
+			}
+
+			/// <summary>
+			/// Mark the data at the given index as changed at the current
+			/// version.
+			/// </summary>
+			/// <param name="index">Index of the data.</param>
+			exported void markChanged(const size_t index) {
+				const uint32_t currentVersion = version();
+				m_changedVersions[index] = currentVersion;
+				std::atomic_ref<uint32_t>(m_chunkVersions[index / VersionChunkSize])
+					.store(currentVersion, std::memory_order_relaxed);
+			}
+
+			/// <summary>
+			/// Mark a range of data as changed at the current version.
+			/// </summary>
+			/// <param name="fromIndex">Start index of the range.</param>
+			/// <param name="toIndex">End index (excluded) of the range.</param>
+			exported void markChanged(const size_t fromIndex, const size_t toIndex);
+
+			/// <summary>
+			/// Set the counter giving the version of the added and changed
+			/// data.
+			/// </summary>
+			/// <param name="version">
+			/// Version counter. It must outlive the column.
+			/// </param>
+			exported void bindVersion(const std::atomic<uint32_t>& version) {
+				m_version = &version;
+			}
+
+			/// <summary>
+			/// Set the threads that first touch each new buffer of trivially
+			/// copyable data (copy of the stored data, zeros in the remaining
+			/// capacity), so that the operating system places its pages on
+			/// their NUMA node. Small buffers are allocated on the current
+			/// thread anyway.
+			/// </summary>
+			/// <param name="workers">
+			/// Threads touching the buffers, that must outlive the column;
+			/// nullptr to use the current thread.
+			/// </param>
+			exported void bindWorkers(WorkerPool* workers) {
+				m_workers = workers;
+			}
+
+			/// <summary>
+			/// Get the version given to the added and changed data.
+			/// </summary>
+			/// <returns>Current version.</returns>
+			exported uint32_t version() const {
+				return m_version -> load(std::memory_order_relaxed);
+			}
+
+			/// <summary>
+			/// Get the version at which the data at the given index was
+			/// added.
+			/// </summary>
+			/// <param name="index">Index of the data.</param>
+			/// <returns>Version of the addition.</returns>
+			exported uint32_t addedVersionAt(const size_t index) const {
+				return m_addedVersions[index];
+			}
+
+			/// <summary>
+			/// Get the version at which the data at the given index was last
+			/// changed.
+			/// </summary>
+			/// <param name="index">Index of the data.</param>
+			/// <returns>Version of the last change.</returns>
+			exported uint32_t changedVersionAt(const size_t index) const {
+				return m_changedVersions[index];
+			}
+
+			/// <summary>
+			/// Get the latest change version of the chunk containing the data
+			/// at the given index. An added data is also changed.
+			/// </summary>
+			/// <param name="index">Index of a data of the chunk.</param>
+			/// <returns>Latest change version of the chunk.</returns>
+			exported uint32_t chunkVersionAt(const size_t index) const {
+				return m_chunkVersions[index / VersionChunkSize];
+			}
+
+		private:
+			/// <summary>
+			/// Move the data into a new buffer of the given capacity.
+			/// </summary>
+			/// <param name="capacity">Capacity of the new buffer.</param>
+			void reallocate(const size_t capacity);
+
+			/// <summary>
+			/// Make room for the given amount of data, growing geometrically.
+			/// </summary>
+			/// <param name="amount">Amount of data to store.</param>
+			void grow(const size_t amount);
+
+			/// <summary>
+			/// Copy the stored data into a new buffer and fill the remaining
+			/// capacity with zeros, on the threads of the bound WorkerPool.
+			/// </summary>
+			/// <param name="newData">New buffer.</param>
+			/// <param name="capacity">Capacity of the new buffer.</param>
+			/// <returns>
+			/// true if done; false if the buffer must be filled on the
+			/// current thread.
+			/// </returns>
+			bool touchInParallel(std::byte* newData, const size_t capacity);
+
+			/// <summary>
+			/// Move a data from a slot to another one, then destroy the source.
+			/// </summary>
+			/// <param name="destination">Address of the destination.</param>
+			/// <param name="source">Address of the source.</param>
+			void relocate(void* destination, void* source);
+
+			// Disable copy and move.
+			ComponentColumn(const ComponentColumn& other) = delete;
+			ComponentColumn(ComponentColumn&& other) = delete;
+			ComponentColumn& operator=(const ComponentColumn& other) = delete;
+			ComponentColumn& operator=(ComponentColumn&& other) = delete;
+	};
+}
+
+#endif
\ No newline at end of file
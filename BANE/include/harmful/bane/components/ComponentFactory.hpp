@@ -2,7 +2,13 @@
 #define __BANE_COMPONENT_FACTORY__
 
 #include <harmful/doom/utils/Platform.hpp>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+#include "harmful/bane/entities/SparseSet.hpp"
 #include "harmful/bane/components/Component.hpp"
+#include "harmful/bane/components/ComponentColumn.hpp"
 #include "harmful/bane/components/ComponentData.hpp"
 
 namespace Bane {
@@ -12,19 +18,128 @@ namespace Bane {
     class ComponentFactory {
 		private:
 			/// <summary>
-			/// List of all the created Components by the current ComponentFactory.
+			/// Index used to tell that there is no Component.
 			/// </summary>
-			std::unordered_set<Component*> m_components;
+			static constexpr uint32_t NoComponent = std::numeric_limits<uint32_t>::max();
 
 			/// <summary>
-			/// List of all the created Components by the current
-			/// ComponentFactory. They are listed per Entity in the order of
-			/// the Entity ID.
-			/// m_componentsPerEntity[entity_id][list_of_components]
+			/// Components of an Entity, chained in m_links.
 			/// </summary>
-			std::vector<std::vector<Component>> m_componentsPerEntity;
+			struct EntityComponents {
+				uint32_t first;
+				uint32_t last;
+				uint32_t count;
+			};
+
+			/// <summary>
+			/// Links between the Components of a same Entity (more than one
+			/// Component per Entity is allowed by Quantity::Many).
+			/// </summary>
+			struct ComponentLinks {
+				uint32_t previous;
+				uint32_t next;
+			};
 
 		public:
+			/// <summary>
+			/// Range over the Components attached to an Entity, walked
+			/// without any allocation.
+			/// </summary>
+			class ComponentRange final {
+				public:
+					/// <summary>
+					/// Iterator over the Components of an Entity.
+					/// </summary>
+					class Iterator final {
+						private:
+							const ComponentFactory* m_factory;
+							uint32_t m_index;
+
+						public:
+							Iterator(const ComponentFactory* factory, const uint32_t index)
+								: m_factory(factory),
+								  m_index(index) {}
+
+							Component operator*() const {
+								return m_factory -> componentAt(m_index);
+							}
+
+							Iterator& operator++() {
+								m_index = m_factory -> m_links[m_index].next;
+								return *this;
+							}
+
+							bool operator==(const Iterator& other) const {
+								return m_index == other.m_index;
+							}
+
+							bool operator!=(const Iterator& other) const {
+								return m_index != other.m_index;
+							}
+					};
+
+				private:
+					const ComponentFactory* m_factory;
+					uint32_t m_first;
+					size_t m_count;
+
+				public:
+					ComponentRange(
+						const ComponentFactory* factory,
+						const uint32_t first,
+						const size_t count
+					) : m_factory(factory),
+						m_first(first),
+						m_count(count) {}
+
+					Iterator begin() const {
+						return Iterator(m_factory, m_first);
+					}
+
+					Iterator end() const {
+						return Iterator(m_factory, NoComponent);
+					}
+
+					size_t size() const {
+						return m_count;
+					}
+
+					bool empty() const {
+						return m_count == 0;
+					}
+			};
+
+		private:
+			/// <summary>
+			/// Data of all the created Components by the current
+			/// ComponentFactory, packed densely.
+			/// </summary>
+			ComponentColumn m_components;
+
+			/// <summary>
+			/// Links between the Components of a same Entity, in the order of
+			/// m_components.
+			/// </summary>
+			std::vector<ComponentLinks> m_links;
+
+			/// <summary>
+			/// Entities bearing at least one Component of the current
+			/// ComponentFactory.
+			/// </summary>
+			SparseSet m_entities;
+
+			/// <summary>
+			/// Components of each Entity, in the order of the dense part of
+			/// m_entities.
+			/// </summary>
+			std::vector<EntityComponents> m_componentsPerEntity;
+
+		public:
+			/// <summary>
+			/// Destruction of the ComponentFactory instance.
+			/// </summary>
+			exported virtual ~ComponentFactory() noexcept = default;
+
 			/// <summary>
 			/// Create a new Component instance, attached to a given Entity
 			/// and store it in the ComponentFactory.
@@ -37,7 +152,67 @@ namespace Bane {
 			/// the already attached Component in case a new one cannot be
 			/// added to the Entity.
 			/// </returns>
-			exported Component* createComponentFor(const Entity& entity);
+			exported Component createComponentFor(const Entity& entity);
+
+			/// <summary>
+			/// Create a new Component for each of the given Entities, at the
+			/// end of the storage. The storage grows at most once and the
+			/// data are constructed in a single pass.
+			/// </summary>
+			/// <param name="entities">
+			/// Entities the new Components are attached to. Each Entity must
+			/// appear once.
+			/// </param>
+			/// <returns>
+			/// Amount of created Components. Entities that already bear a
+			/// Component and cannot bear more are skipped. The created
+			/// Components are the last ones of components().
+			/// </returns>
+			exported size_t createComponentsFor(std::span<const Entity> entities);
+
+			/// <summary>
+			/// Create a new Component for each of the given Entities, at the
+			/// end of the storage, whose data are copies of a template. The
+			/// data are not constructed: the template is copied byte by byte
+			/// in blocks doubling in size, so the data type must be trivially
+			/// copyable.
+			/// </summary>
+			/// <param name="entities">
+			/// Entities the new Components are attached to. Each Entity must
+			/// appear once.
+			/// </param>
+			/// <param name="data">Data copied in each new Component.</param>
+			/// <returns>
+			/// Amount of created Components. Entities that already bear a
+			/// Component and cannot bear more are skipped. The created
+			/// Components are the last ones of components().
+			/// </returns>
+			/// <exception cref="std::runtime_error">
+			/// The data type is not trivially copyable.
+			/// </exception>
+			exported size_t cloneComponentsFor(
+				std::span<const Entity> entities,
+				const void* data
+			);
+
+			/// <summary>
+			/// Fill an empty ComponentFactory with Components whose data are
+			/// copied from a packed blob at once, without constructing them
+			/// one by one. The data type must be trivially copyable.
+			/// </summary>
+			/// <param name="entities">
+			/// Entity of each Component, in the order of the blob. An Entity
+			/// appears several times only if it can bear several Components.
+			/// </param>
+			/// <param name="data">Data of the Components, packed.</param>
+			/// <exception cref="std::runtime_error">
+			/// The data type is not trivially copyable or the ComponentFactory
+			/// is not empty.
+			/// </exception>
+			exported void restoreComponents(
+				std::span<const Entity> entities,
+				const void* data
+			);
 
 			/// <summary>
 			/// Get the amount of Components for all Entities.
@@ -62,16 +237,103 @@ namespace Bane {
 			/// </returns>
 			exported size_t countFor(const Entity& entity) const;
 
+			/// <summary>
+			/// Get the Entities bearing at least one Component of the current
+			/// ComponentFactory.
+			/// </summary>
+			/// <returns>Packed IDs of the Entities.</returns>
+			exported std::span<const id_t> entities() const {
+				return m_entities.dense();
+			}
+
+			/// <summary>
+			/// Check if an Entity bears at least one Component of the current
+			/// ComponentFactory.
+			/// </summary>
+			/// <param name="entity">Entity to be checked.</param>
+			/// <returns>true if it does; false otherwise.</returns>
+			exported bool contains(const Entity& entity) const {
+				return m_entities.contains(entity.id());
+			}
+
+			/// <summary>
+			/// Get the index in components() of the first Component attached to
+			/// an Entity.
+			/// </summary>
+			/// <param name="entity">Entity to get the Component.</param>
+			/// <returns>
+			/// Index of the Component; SparseSet::InvalidIndex if the Entity
+			/// bears no Component of the current ComponentFactory.
+			/// </returns>
+			exported size_t indexOf(const Entity& entity) const {
+				auto entityIndex = m_entities.indexOf(entity.id());
+
+				if (entityIndex == SparseSet::InvalidIndex) {
+					return SparseSet::InvalidIndex;
+				}
+
+				return m_componentsPerEntity[entityIndex].first;
+			}
+
 			/// <summary>
 			/// Get all the active Components in the current ComponentFactory.
 			/// </summary>
 			/// <returns>
-			/// All the Components in the current ComponentFactory.
+			/// All the Components in the current ComponentFactory, stored
+			/// contiguously.
 			/// </returns>
-			exported const std::unordered_set<Component*>& components() const {
+			exported const ComponentColumn& components() const {
 				return m_components;
 			}
 
+			/// <summary>
+			/// Mark the Component at the given index in components() as
+			/// changed.
+			/// </summary>
+			/// <param name="index">Index of the Component.</param>
+			exported void markChanged(const size_t index) {
+				m_components.markChanged(index);
+			}
+
+			/// <summary>
+			/// Mark a range of Components in components() as changed.
+			/// </summary>
+			/// <param name="fromIndex">Start index of the range.</param>
+			/// <param name="toIndex">End index (excluded) of the range.</param>
+			exported void markChanged(const size_t fromIndex, const size_t toIndex) {
+				m_components.markChanged(fromIndex, toIndex);
+			}
+
+			/// <summary>
+			/// Set the counter giving the version of the added and changed
+			/// Components.
+			/// </summary>
+			/// <param name="version">
+			/// Version counter. It must outlive the ComponentFactory.
+			/// </param>
+			exported void bindVersion(const std::atomic<uint32_t>& version) {
+				m_components.bindVersion(version);
+			}
+
+			/// <summary>
+			/// Set the threads that first touch the storage of the Components
+			/// (see ComponentColumn::bindWorkers()).
+			/// </summary>
+			/// <param name="workers">
+			/// Threads touching the storage, that must outlive the
+			/// ComponentFactory; nullptr to use the current thread.
+			/// </param>
+			exported void bindWorkers(WorkerPool* workers) {
+				m_components.bindWorkers(workers);
+			}
+
+			/// <summary>
+			/// Get the memory used by the ComponentFactory. The bookkeeping of
+			/// the Entities is counted in the metadata.
+			/// </summary>
+			/// <returns>Memory statistics of the ComponentFactory.</returns>
+			exported ComponentColumn::MemoryStatistics memory() const;
+
 			/// <summary>
 			/// Get all the Components attached to an Entity.
 			/// </summary>
@@ -81,7 +343,7 @@ namespace Bane {
 			/// <returns>
 			/// All the Components attached to the Entity.
 			/// </returns>
-			exported std::list<Component*> componentsOf(const Entity& entity);
+			exported ComponentRange componentsOf(const Entity& entity) const;
 
 			/// <summary>
 			/// Get the first Component in the list of the ones attached to an
@@ -91,10 +353,10 @@ namespace Bane {
 			/// Entity for which getting the first Component.
 			/// </param>
 			/// <returns>
-			/// The first Component attached to the Entity; nullptr if the
-			/// Entity is not found.
+			/// The first Component attached to the Entity; an invalid
+			/// Component if the Entity is not found.
 			/// </returns>
-			exported Component* firstOf(const Entity& entity);
+			exported Component firstOf(const Entity& entity) const;
 
 			/// <summary>
 			/// Delete the Component instances born by the Entity and remove
@@ -105,6 +367,25 @@ namespace Bane {
 			/// </param>
 			exported void destroyComponentsOf(const Entity& entity);
 
+			/// <summary>
+			/// Move the Components in a new order, for example to store them
+			/// in their processing order. The Components of each Entity stay
+			/// chained in the same order.
+			/// </summary>
+			/// <param name="order">
+			/// Current index in components() of the Component to put at each
+			/// index: a permutation of the indices of components().
+			/// </param>
+			/// <exception cref="std::runtime_error">
+			/// The order does not have one index per Component.
+			/// </exception>
+			exported void reorder(std::span<const uint32_t> order);
+
+			/// <summary>
+			/// Delete all the Component instances of the ComponentFactory.
+			/// </summary>
+			exported void clear();
+
 			/// <summary>
 			/// Get the allowed quantity of Component with the data type the
 			/// current ComponentFactory deals with on a single Entity.
@@ -115,39 +396,125 @@ namespace Bane {
 			virtual ComponentData::Quantity allowedQuantity() = 0;
 
 		protected:
+			/// <summary>
+			/// Create a new ComponentFactory instance.
+			/// </summary>
+			/// <param name="type">
+			/// Operations on the data type the ComponentFactory deals with.
+			/// </param>
+			exported ComponentFactory(const ComponentColumn::DataType& type);
+
 			/// <summary>
 			/// Create the ComponentData for a new Component instance.
 			/// </summary>
+			/// <param name="storage">
+			/// Address where the ComponentData instance must be constructed.
+			/// It is aligned and sized for the data type the current
+			/// ComponentFactory deals with.
+			/// </param>
 			/// <param name="entity">
 			/// Entity for which the ComponentData instance is created.
 			/// </param>
 			/// <returns>
-			/// A new instance of ComponentData of the data type the current
-			/// ComponentFactory deals with.
+			/// The new instance of ComponentData of the data type the current
+			/// ComponentFactory deals with, constructed in the storage.
 			/// </returns>
-			virtual std::unique_ptr<ComponentData>&& createDataFor(const Entity& entity) = 0;
+			virtual ComponentData* createDataFor(
+				void* storage,
+				const Entity& entity
+			) = 0;
+
+			/// <summary>
+			/// Create the ComponentData of several new Components, stored one
+			/// after the other. By default, calls createDataFor() for each
+			/// Component.
+			/// </summary>
+			/// <param name="storage">
+			/// Address of the first ComponentData instance to construct.
+			/// </param>
+			/// <param name="entities">
+			/// Entities for which the ComponentData instances are created.
+			/// </param>
+			/// <remarks>
+			/// If a construction fails, the already constructed instances
+			/// MUST be destroyed before throwing.
+			/// </remarks>
+			virtual void createDataRange(
+				void* storage,
+				std::span<const Entity> entities
+			);
+
+			/// <summary>
+			/// Get the storage of the Components, for subclasses aware of
+			/// the concrete data type.
+			/// </summary>
+			/// <returns>The storage of the Components.</returns>
+			ComponentColumn& storage() {
+				return m_components;
+			}
 
 		private:
 			/// <summary>
-			/// Generic algorithm for checking if the given Entity can bear
-			/// another Component with the data type the current
-			/// ComponentFactory deals with.
+			/// Get the Component at the given index in the storage.
 			/// </summary>
-			/// <param name="entity">Entity to be checked.</param>
-			/// <returns>
-			/// true if the creation is allowed for the given Entity; false
-			/// otherwise.
-			/// </returns>
-			bool isCreationAllowedFor(const Entity& entity);
+			/// <param name="index">Index of the Component.</param>
+			/// <returns>The Component at the given index.</returns>
+			Component componentAt(const size_t index) const {
+				return Component(
+					m_components.entityAt(index),
+					m_components.dataAt(index)
+				);
+			}
 
 			/// <summary>
-			/// Get the position of an IDObject in a zero-based container.
+			/// Destroy the Component at the given index in the storage and
+			/// update the links of the Component moved in place of it.
 			/// </summary>
-			/// <param name="object">Object to get the position.</param>
-			/// <returns>
-			/// The position of the object in a zero-based container.
-			/// </returns>
-			size_t position(const Doom::IDObject& object) const;
+			/// <param name="index">Index of the Component to destroy.</param>
+			/// <remarks>
+			/// The Component must have been unlinked from the Components of
+			/// its Entity before.
+			/// </remarks>
+			void removeAt(const uint32_t index);
+
+			/// <summary>
+			/// Get the Entities that can bear a new Component, after checking
+			/// they are all valid.
+			/// </summary>
+			/// <param name="entities">Entities to bear a new Component.</param>
+			/// <param name="accepted">
+			/// Storage of the accepted Entities, if some are left apart.
+			/// </param>
+			/// <returns>The Entities that can bear a new Component.</returns>
+			/// <exception cref="std::runtime_error">
+			/// An Entity is not valid.
+			/// </exception>
+			std::span<const Entity> acceptedOf(
+				std::span<const Entity> entities,
+				std::vector<Entity>& accepted
+			);
+
+			/// <summary>
+			/// Attach the Components stored from the given index to the
+			/// Components of their Entity.
+			/// </summary>
+			/// <param name="entities">Entities bearing the Components.</param>
+			/// <param name="firstIndex">Index of the first Component.</param>
+			void attach(std::span<const Entity> entities, const uint32_t firstIndex);
+
+			/// <summary>
+			/// Attach the Component at the given index in the storage to the
+			/// Components of its Entity.
+			/// </summary>
+			/// <param name="entity">Entity bearing the Component.</param>
+			/// <param name="index">Index of the Component.</param>
+			void attach(const Entity& entity, const uint32_t index);
+
+			// Disable copy and move.
+			ComponentFactory(const ComponentFactory& other) = delete;
+			ComponentFactory(ComponentFactory&& other) = delete;
+			ComponentFactory& operator=(const ComponentFactory& other) = delete;
+			ComponentFactory& operator=(ComponentFactory&& other) = delete;
     };
 }
 
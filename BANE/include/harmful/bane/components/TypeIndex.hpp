@@ -0,0 +1,114 @@
+#ifndef __BANE_TYPE_INDEX__
+#define __BANE_TYPE_INDEX__
+
+#include <harmful/doom/utils/Platform.hpp>
+#include <cstdint>
+#include <type_traits>
+#include <typeinfo>
+
+namespace Bane {
+	/// <summary>
+	/// Counters of the identifiers given by TypeIndex. They are defined in
+	/// BANE so that BANE and the application share them when BANE is a
+	/// shared library.
+	/// </summary>
+	class TypeRegistry final {
+		public:
+			/// <summary>
+			/// Get the identifier of a type, giving it the next identifier of
+			/// its family if it has none yet.
+			/// </summary>
+			/// <param name="family">Family of the type.</param>
+			/// <param name="type">The type.</param>
+			/// <returns>Identifier of the type in its family, from 0.</returns>
+			exported static uint32_t Register(
+				const std::type_info& family,
+				const std::type_info& type
+			);
+
+			/// <summary>
+			/// Get the amount of types of a family identified so far.
+			/// </summary>
+			/// <param name="family">Family of the types.</param>
+			/// <returns>Amount of types.</returns>
+			exported static uint32_t Size(const std::type_info& family);
+
+			/// <summary>
+			/// Get the name of a type, for the diagnostics.
+			/// </summary>
+			/// <param name="family">Family of the type.</param>
+			/// <param name="id">Identifier of the type.</param>
+			/// <returns>
+			/// Implementation-defined name of the type; an empty string if
+			/// the identifier is unknown.
+			/// </returns>
+			exported static const char* NameOf(
+				const std::type_info& family,
+				const uint32_t id
+			);
+
+		private:
+			// Only static methods.
+			TypeRegistry() = delete;
+	};
+
+	/// <summary>
+	/// Dense identifiers of the types of a family (ComponentData types,
+	/// System classes, events...), so that the data per type are found by
+	/// indexing an array instead of hashing a name or a std::type_info.
+	/// </summary>
+	/// <typeparam name="Family">
+	/// Family of the types: each family numbers its types from 0.
+	/// </typeparam>
+	/// <remarks>
+	/// A type gets its identifier the first time it is asked for, once per
+	/// process: the identifiers depend on the order of these first uses, so
+	/// they must not be saved. The cv-qualified versions of a type share its
+	/// identifier. The names of the types are kept for the diagnostics only.
+	/// </remarks>
+	template <class Family>
+	class TypeIndex final {
+		public:
+			/// <summary>
+			/// Get the identifier of a type.
+			/// </summary>
+			/// <typeparam name="Type">Type of the family.</typeparam>
+			/// <returns>Identifier of the type, from 0.</returns>
+			template <class Type>
+			exported static uint32_t Of() {
+				using BareType = std::remove_cv_t<Type>;
+
+				// Each module gets its own copy of Id, but the registry gives
+				// them all the same value.
+				static const uint32_t Id = TypeRegistry::Register(typeid(Family), typeid(BareType));
+				return Id;
+			}
+
+			/// <summary>
+			/// Get the amount of types identified so far, an upper bound of
+			/// their identifiers.
+			/// </summary>
+			/// <returns>Amount of types.</returns>
+			exported static uint32_t Size() {
+				return TypeRegistry::Size(typeid(Family));
+			}
+
+			/// <summary>
+			/// Get the name of a type, for the diagnostics.
+			/// </summary>
+			/// <param name="id">Identifier of the type.</param>
+			/// <returns>
+			/// Implementation-defined name of the type; an empty string if
+			/// the identifier is unknown.
+			/// </returns>
+			exported static const char* NameOf(const uint32_t id) {
+				return TypeRegistry::NameOf(typeid(Family), id);
+			}
+
+		private:
+			// Only static methods.
+			TypeIndex() = delete;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,90 @@
+#ifndef __BANE_TYPED_COMPONENT_FACTORY__
+#define __BANE_TYPED_COMPONENT_FACTORY__
+
+#include <harmful/doom/utils/Platform.hpp>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include "harmful/bane/components/ComponentFactory.hpp"
+
+namespace Bane {
+	/// <summary>
+	/// ComponentFactory for a known ComponentData subclass. The data are
+	/// default constructed, the allowed quantity is given by the static
+	/// AllowedQuantity() function of the data type.
+	/// </summary>
+	/// <typeparam name="DataClass">
+	/// Subclass of ComponentData the ComponentFactory deals with.
+	/// </typeparam>
+	template <class DataClass>
+	class TypedComponentFactory : public ComponentFactory {
+		static_assert(
+			std::is_base_of_v<ComponentData, DataClass>,
+			"Only derived class from ComponentData can be used here."
+		);
+
+		public:
+			/// <summary>
+			/// Create a new TypedComponentFactory instance.
+			/// </summary>
+			exported TypedComponentFactory()
+				: ComponentFactory(ComponentColumn::DataType::Of<DataClass>()) {}
+
+			/// <summary>
+			/// Get the allowed quantity of Component with the DataClass on
+			/// a single Entity.
+			/// </summary>
+			/// <returns>
+			/// Allowed quantity of Component on a single Entity.
+			/// </returns>
+			exported ComponentData::Quantity allowedQuantity() override {
+				return DataClass::AllowedQuantity();
+			}
+
+			/// <summary>
+			/// Get all the data of the Components, in the order of the
+			/// Components in the ComponentFactory.
+			/// </summary>
+			/// <returns>Contiguous range of all the data.</returns>
+			exported std::span<DataClass> data() {
+				return storage().template as<DataClass>();
+			}
+
+		protected:
+			/// <summary>
+			/// Create the ComponentData for a new Component instance.
+			/// </summary>
+			/// <param name="storage">
+			/// Address where the ComponentData instance must be constructed.
+			/// </param>
+			/// <returns>The new instance of DataClass.</returns>
+			ComponentData* createDataFor(
+				void* storage,
+				const Entity&
+			) override {
+				return new (storage) DataClass();
+			}
+
+			/// <summary>
+			/// Create the DataClass instances of several new Components in a
+			/// single pass.
+			/// </summary>
+			/// <param name="storage">
+			/// Address of the first DataClass instance to construct.
+			/// </param>
+			/// <param name="entities">
+			/// Entities for which the DataClass instances are created.
+			/// </param>
+			void createDataRange(
+				void* storage,
+				std::span<const Entity> entities
+			) override {
+				std::uninitialized_value_construct_n(
+					static_cast<DataClass*>(storage),
+					entities.size()
+				);
+			}
+	};
+}
+
+#endif
\ No newline at end of file
@@ -3,17 +3,154 @@
 
 #include <harmful/doom/utils/Platform.hpp>
 #include <harmful/doom/utils/IDObject.hpp>
+#include <cstdint>
 
 namespace Bane {
 	/// <summary>
 	/// Obscur ID type for an Entity.
+	/// The ID is a 32-bit handle made of an index (low bits) and a generation
+	/// (high bits). The index is reused once the Entity is destroyed, with
+	/// another generation, so that stale handles can be detected.
 	/// </summary>
-	class Entity final : public Doom::IDObject {
+	class Entity final {
 		public:
 			/// <summary>
-			/// Create a new Entity instance.
+			/// Amount of bits of the ID used for the index.
 			/// </summary>
-			exported Entity();
+			static constexpr uint32_t IndexBits = 22;
+
+			/// <summary>
+			/// Amount of bits of the ID used for the generation.
+			/// </summary>
+			static constexpr uint32_t GenerationBits = 32 - IndexBits;
+
+			/// <summary>
+			/// Mask of the index in the ID.
+			/// </summary>
+			static constexpr uint32_t IndexMask = (1u << IndexBits) - 1;
+
+			/// <summary>
+			/// Mask of the generation, once shifted to the low bits.
+			/// </summary>
+			static constexpr uint32_t GenerationMask = (1u << GenerationBits) - 1;
+
+			/// <summary>
+			/// Invalid ID. As generations start at 1, no valid Entity can have
+			/// this ID.
+			/// </summary>
+			static constexpr id_t InvalidID = 0;
+
+		private:
+			/// <summary>
+			/// Value of the Entity ID.
+			/// </summary>
+			id_t m_id = InvalidID;
+
+		public:
+			/// <summary>
+			/// Create an invalid Entity.
+			/// </summary>
+			/// <remarks>
+			/// Valid Entities are created by the EntityFactory.
+			/// </remarks>
+			exported constexpr Entity() = default;
+
+			/// <summary>
+			/// Create an Entity from its ID.
+			/// </summary>
+			/// <param name="id">ID of the Entity.</param>
+			exported constexpr explicit Entity(const id_t id)
+				: m_id(id) {}
+
+			/// <summary>
+			/// Create an Entity from its index and its generation.
+			/// </summary>
+			/// <param name="index">Index of the Entity.</param>
+			/// <param name="generation">Generation of the Entity.</param>
+			exported constexpr Entity(const uint32_t index, const uint32_t generation)
+				: m_id((generation << IndexBits) | (index & IndexMask)) {}
+
+			/// <summary>
+			/// Get the value of the ID of the Entity.
+			/// </summary>
+			/// <returns>Entity ID value.</returns>
+			exported constexpr id_t id() const {
+				return m_id;
+			}
+
+			/// <summary>
+			/// Get the index of the Entity, unique among the living Entities.
+			/// </summary>
+			/// <returns>Index of the Entity.</returns>
+			exported constexpr uint32_t index() const {
+				return m_id & IndexMask;
+			}
+
+			/// <summary>
+			/// Get the generation of the Entity.
+			/// </summary>
+			/// <returns>Generation of the Entity.</returns>
+			exported constexpr uint32_t generation() const {
+				return m_id >> IndexBits;
+			}
+
+			/// <summary>
+			/// Check if the Entity ID is valid (true) or not (false).
+			/// </summary>
+			/// <returns>true if valid; false otherwise.</returns>
+			/// <remarks>
+			/// A valid Entity may have been destroyed: use
+			/// EntityFactory::contains() to know if it is alive.
+			/// </remarks>
+			exported constexpr bool isValid() const {
+				return m_id != InvalidID;
+			}
+
+			/// <summary>
+			/// Check if two Entities are equal.
+			/// </summary>
+			/// <param name="left">First Entity to compare.</param>
+			/// <param name="right">Second Entity to compare.</param>
+			/// <returns>true if the IDs are equal; false otherwise.</returns>
+			friend constexpr bool operator==(const Entity& left, const Entity& right) {
+				return left.m_id == right.m_id;
+			}
+
+			/// <summary>
+			/// Check if two Entities are different.
+			/// </summary>
+			/// <param name="left">First Entity to compare.</param>
+			/// <param name="right">Second Entity to compare.</param>
+			/// <returns>true if the IDs are different; false otherwise.</returns>
+			friend constexpr bool operator!=(const Entity& left, const Entity& right) {
+				return left.m_id != right.m_id;
+			}
+
+			/// <summary>
+			/// Ordering operator.
+			/// </summary>
+			/// <param name="first">First Entity to compare.</param>
+			/// <param name="second">Second Entity to compare.</param>
+			/// <returns>
+			/// true if the ID of the first Entity is lower than the ID of the
+			/// second Entity; false on the contrary.
+			/// </returns>
+			friend constexpr bool operator<(const Entity& first, const Entity& second) {
+				return first.m_id < second.m_id;
+			}
+
+			/// <summary>
+			/// Ordering operator.
+			/// </summary>
+			/// <param name="first">First Entity to compare.</param>
+			/// <param name="second">Second Entity to compare.</param>
+			/// <returns>
+			/// true if the ID of the first Entity is greater than the ID of the
+			/// second Entity; false on the contrary.
+			/// </returns>
+			friend constexpr bool operator>(const Entity& first, const Entity& second) {
+				return first.m_id > second.m_id;
+			}
 	};
 }
 
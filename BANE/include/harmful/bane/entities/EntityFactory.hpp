@@ -3,32 +3,127 @@
 
 #include "harmful/bane/entities/Entity.hpp"
 #include <harmful/doom/utils/Platform.hpp>
-#include <unordered_set>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <vector>
 
 namespace Bane {
 	/// <summary>
 	/// Factory to generate and destroy Entity instances.
+	/// The creation, destruction and lookup of Entities are lock-free so
+	/// that they can be performed from several threads at the same time.
 	/// </summary>
+	/// <remarks>
+	/// The Entity indices are stored in a paged dense array of slots, holding
+	/// the current generation of each index. The free indices are chained
+	/// through their slot (embedded free list) to be reused.
+	///
+	/// For the Entities created by several threads to get the same IDs from
+	/// a run to another, a reservation gives each thread its own stream of
+	/// IDs (see beginReservation()).
+	/// </remarks>
 	class EntityFactory final {
 		private:
 			/// <summary>
-			/// List of the available entities in the application.
+			/// Amount of slots in a page (power of two).
 			/// </summary>
-			std::unordered_set<id_t> m_entities;
+			static constexpr uint32_t PageSize = 4096;
+
+			/// <summary>
+			/// Maximal amount of pages, covering all the Entity indices.
+			/// </summary>
+			static constexpr uint32_t MaxPages = (Entity::IndexMask + 1) / PageSize;
+
+			/// <summary>
+			/// Flag set in the state of a slot bearing a living Entity.
+			/// </summary>
+			static constexpr uint32_t AliveFlag = 1u << 31;
+
+			/// <summary>
+			/// Value of the free list head when it is empty.
+			/// </summary>
+			static constexpr uint32_t EndOfList = 0;
+
+			/// <summary>
+			/// Amount of consecutive positions of a stream in the sequence of
+			/// the indices of a reservation.
+			/// </summary>
+			static constexpr uint32_t ReservationBlockSize = 64;
+
+			/// <summary>
+			/// Slot of an Entity index.
+			/// </summary>
+			struct Slot {
+				/// <summary>
+				/// Generation of the Entity using the index, with AliveFlag
+				/// if it is alive. When the index is free, this is the
+				/// generation of the next Entity using it.
+				/// </summary>
+				std::atomic<uint32_t> state{ 1 };
+
+				/// <summary>
+				/// Next free index + 1 in the free list (EndOfList for the
+				/// last one), only meaningful when the index is free.
+				/// </summary>
+				std::atomic<uint32_t> nextFree{ EndOfList };
+			};
+
+			/// <summary>
+			/// Pages of slots, allocated on demand and never released before
+			/// the destruction of the EntityFactory.
+			/// </summary>
+			std::array<std::atomic<Slot*>, MaxPages> m_pages{};
+
+			/// <summary>
+			/// Next index never used so far.
+			/// </summary>
+			std::atomic<uint32_t> m_nextIndex{ 0 };
+
+			/// <summary>
+			/// Head of the free list: the low 32 bits are the first free index
+			/// + 1 (EndOfList if empty), the high 32 bits are a tag changed at
+			/// each update to prevent the ABA problem.
+			/// </summary>
+			std::atomic<uint64_t> m_freeHead{ EndOfList };
+
+			/// <summary>
+			/// Amount of living Entities.
+			/// </summary>
+			std::atomic<size_t> m_count{ 0 };
+
+			/// <summary>
+			/// First free indices when the current reservation began, in
+			/// their reuse order. They start the sequence of the indices of
+			/// the reservation, followed by the never used indices.
+			/// </summary>
+			std::vector<uint32_t> m_reservedFreeIndices;
+
+			/// <summary>
+			/// First never used index when the current reservation began.
+			/// </summary>
+			uint32_t m_reservationBase = 0;
+
+			/// <summary>
+			/// Amount of Entities reserved by each stream of the current
+			/// reservation. Each stream only updates its own amount.
+			/// </summary>
+			std::vector<uint32_t> m_amountsReserved;
 
 		public:
 			/// <summary>
 			/// Create a new EntityFactory instance.
 			/// </summary>
 			/// <remarks>
-			/// There should be only one EntityFactory by application.
+			/// There should be only one EntityFactory by World.
 			/// </remarks>
 			exported EntityFactory() = default;
 
 			/// <summary>
 			/// Destruction of the EntityFactory instance.
 			/// </summary>
-			exported virtual ~EntityFactory() noexcept = default;
+			exported virtual ~EntityFactory() noexcept;
 
 			/// <summary>
 			/// Create a new Entity instance and store it in the EntityFactory.
@@ -36,22 +131,80 @@ namespace Bane {
 			/// <returns>The newly created Entity.</returns>
 			exported Entity create();
 
+			/// <summary>
+			/// Create several new Entity instances at once. The freed indices
+			/// are reused first, then the new indices are reserved in a
+			/// single atomic operation.
+			/// </summary>
+			/// <param name="entities">Receives the created Entities.</param>
+			exported void create(std::span<Entity> entities);
+
+			/// <summary>
+			/// Begin a reservation: until endReservation(), the Entities are
+			/// created by reserve() from several streams, each used by a
+			/// single thread at a time. The Entity got by a stream only
+			/// depends on the state of the EntityFactory at the beginning of
+			/// the reservation and on the amount of Entities the stream
+			/// reserved before, not on the other streams.
+			/// </summary>
+			/// <param name="amountStreams">Amount of streams.</param>
+			/// <exception cref="std::runtime_error">
+			/// A reservation is already running.
+			/// </exception>
+			/// <remarks>
+			/// The streams take blocks of ReservationBlockSize positions in
+			/// turn in the sequence of the free indices then of the never
+			/// used ones. create() must not be called during a reservation.
+			/// </remarks>
+			exported void beginReservation(const uint32_t amountStreams);
+
+			/// <summary>
+			/// Create a new Entity from a stream of the current reservation.
+			/// </summary>
+			/// <param name="stream">Index of the stream.</param>
+			/// <returns>The newly created Entity.</returns>
+			/// <exception cref="std::out_of_range">
+			/// The stream is not part of the current reservation.
+			/// </exception>
+			/// <exception cref="std::overflow_error">
+			/// The indices of the stream are exhausted.
+			/// </exception>
+			exported Entity reserve(const uint32_t stream);
+
+			/// <summary>
+			/// End the current reservation: the positions skipped by the
+			/// streams are freed to be reused first, in their order in the
+			/// sequence. Nothing is done if no reservation is running.
+			/// </summary>
+			exported void endReservation();
+
 			/// <summary>
 			/// Destroy an Entity instance and remove it from the
-			/// EntityFactory.
+			/// EntityFactory. Nothing is done if the Entity is not alive.
 			/// </summary>
 			/// <param name="entity">Entity to delete.</param>
-			exported void destroy(const Entity& entity);
+			/// <returns>
+			/// true if the Entity has been destroyed; false if it was not
+			/// alive.
+			/// </returns>
+			exported bool destroy(const Entity& entity);
 
 			/// <summary>
 			/// Destroy an Entity instance and remove it from the
 			/// EntityFactory.
 			/// </summary>
 			/// <param name="entity">ID of the Entity to delete.</param>
-			exported void destroy(const id_t& entity);
+			/// <returns>
+			/// true if the Entity has been destroyed; false if it was not
+			/// alive.
+			/// </returns>
+			exported bool destroy(const id_t& entity) {
+				return destroy(Entity(entity));
+			}
 
 			/// <summary>
-			/// Check if the given Entity exists.
+			/// Check if the given Entity exists. A stale Entity (destroyed,
+			/// its index possibly reused) does not exist.
 			/// </summary>
 			/// <param name="entity">Entity to be checked.</param>
 			/// <returns>true if the Entity exists; false otherwise.</returns>
@@ -62,9 +215,153 @@ namespace Bane {
 			/// </summary>
 			/// <param name="entity">ID of the Entity to be checked.</param>
 			/// <returns>true if the Entity exists; false otherwise.</returns>
-			exported bool contains(const id_t& entity) const;
+			exported bool contains(const id_t& entity) const {
+				return contains(Entity(entity));
+			}
+
+			/// <summary>
+			/// Get the amount of living Entities.
+			/// </summary>
+			/// <returns>Amount of living Entities.</returns>
+			exported size_t count() const {
+				return m_count.load(std::memory_order_relaxed);
+			}
+
+			/// <summary>
+			/// Get the amount of Entity indices used so far. All the living
+			/// Entities have an index lower than this value.
+			/// </summary>
+			/// <returns>Amount of Entity indices used so far.</returns>
+			exported uint32_t indexCount() const {
+				return m_nextIndex.load(std::memory_order_acquire);
+			}
+
+			/// <summary>
+			/// Get the whole state of the EntityFactory, to be restored later
+			/// by restore(). Must not be called while Entities are created or
+			/// destroyed.
+			/// </summary>
+			/// <param name="states">
+			/// Receives the generation of each index used so far, with the
+			/// highest bit set if its Entity is alive.
+			/// </param>
+			/// <param name="freeIndices">
+			/// Receives the free indices, in the order they will be reused.
+			/// </param>
+			exported void snapshot(
+				std::vector<uint32_t>& states,
+				std::vector<uint32_t>& freeIndices
+			) const;
+
+			/// <summary>
+			/// Restore a state got from snapshot(). The Entities created
+			/// afterwards are the same as the ones that would have been
+			/// created after the call to snapshot(). Must not be called while
+			/// Entities are created or destroyed.
+			/// </summary>
+			/// <param name="states">Generation of each index.</param>
+			/// <param name="freeIndices">Free indices, in reuse order.</param>
+			/// <exception cref="std::overflow_error">
+			/// There are more states than Entity indices.
+			/// </exception>
+			/// <exception cref="std::runtime_error">
+			/// The free indices are invalid (see Validate()).
+			/// </exception>
+			exported void restore(
+				std::span<const uint32_t> states,
+				std::span<const uint32_t> freeIndices
+			);
+
+			/// <summary>
+			/// Check a state got from snapshot() without restoring it, so that
+			/// restore() cannot fail once called.
+			/// </summary>
+			/// <param name="states">Generation of each index.</param>
+			/// <param name="freeIndices">Free indices, in reuse order.</param>
+			/// <exception cref="std::overflow_error">
+			/// There are more states than Entity indices.
+			/// </exception>
+			/// <exception cref="std::runtime_error">
+			/// A free index is out of the states, alive or present twice.
+			/// </exception>
+			exported static void Validate(
+				std::span<const uint32_t> states,
+				std::span<const uint32_t> freeIndices
+			);
+
+			/// <summary>
+			/// Check if an Entity is alive in a state got from snapshot().
+			/// </summary>
+			/// <param name="states">Generation of each index.</param>
+			/// <param name="entity">Entity to be checked.</param>
+			/// <returns>
+			/// true if the state of its index is alive with its generation;
+			/// false otherwise.
+			/// </returns>
+			exported static bool IsAlive(
+				std::span<const uint32_t> states,
+				const Entity& entity
+			) {
+				return entity.isValid()
+					&& (entity.index() < states.size())
+					&& (states[entity.index()] == (entity.generation() | AliveFlag));
+			}
 
 		private:
+			/// <summary>
+			/// Get the slot of an index, allocating its page if needed.
+			/// </summary>
+			/// <param name="index">Index of the slot.</param>
+			/// <returns>The slot of the index.</returns>
+			Slot& slot(const uint32_t index);
+
+			/// <summary>
+			/// Get the slot of an index if its page has been allocated.
+			/// </summary>
+			/// <param name="index">Index of the slot.</param>
+			/// <returns>The slot of the index; nullptr otherwise.</returns>
+			const Slot* findSlot(const uint32_t index) const;
+
+			/// <summary>
+			/// Pop a free index from the free list.
+			/// </summary>
+			/// <param name="index">Popped index.</param>
+			/// <returns>true if an index has been popped; false if empty.</returns>
+			bool popFreeIndex(uint32_t& index);
+
+			/// <summary>
+			/// Push a free index in the free list.
+			/// </summary>
+			/// <param name="index">Index to push.</param>
+			void pushFreeIndex(const uint32_t index);
+
+			/// <summary>
+			/// Get the position in the sequence of the current reservation of
+			/// an Entity reserved by a stream.
+			/// </summary>
+			/// <param name="stream">Index of the stream.</param>
+			/// <param name="ordinal">
+			/// Amount of Entities reserved by the stream before this one.
+			/// </param>
+			/// <returns>Position in the sequence.</returns>
+			uint64_t reservedPosition(const uint32_t stream, const uint32_t ordinal) const {
+				uint64_t round = ordinal / ReservationBlockSize;
+				uint64_t block = (round * m_amountsReserved.size()) + stream;
+				return (block * ReservationBlockSize) + (ordinal % ReservationBlockSize);
+			}
+
+			/// <summary>
+			/// Get the index at a position in the sequence of the current
+			/// reservation.
+			/// </summary>
+			/// <param name="position">Position in the sequence.</param>
+			/// <returns>Index at this position.</returns>
+			uint64_t reservedIndex(const uint64_t position) const {
+				return (position < m_reservedFreeIndices.size())
+					? m_reservedFreeIndices[position]
+					: m_reservationBase + (position - m_reservedFreeIndices.size());
+			}
+
 			// Disable copy and move.
 			EntityFactory(const EntityFactory& other) = delete;
 			EntityFactory(EntityFactory&& other) = delete;
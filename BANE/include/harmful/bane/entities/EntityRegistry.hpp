@@ -0,0 +1,183 @@
+#ifndef __BANE_ENTITY_REGISTRY__
+#define __BANE_ENTITY_REGISTRY__
+
+#include <harmful/doom/utils/Platform.hpp>
+#include <bitset>
+#include <span>
+#include <vector>
+#include "harmful/bane/entities/Entity.hpp"
+#include "harmful/bane/entities/SparseSet.hpp"
+
+namespace Bane {
+	/// <summary>
+	/// Dense registry of the living Entities of a World. Each Entity bears a
+	/// signature: a bit per System, set when the System may hold Components
+	/// for the Entity.
+	/// </summary>
+	/// <remarks>
+	/// The signatures are packed in the order of the Entity IDs of the
+	/// SparseSet, and follow its swap and pop on removal.
+	/// </remarks>
+	class EntityRegistry final {
+		public:
+			/// <summary>
+			/// Maximal amount of Systems a signature can describe.
+			/// </summary>
+			static constexpr size_t MaxSignatureSize = 128;
+
+			/// <summary>
+			/// Set of Systems holding Components for an Entity.
+			/// </summary>
+			using Signature = std::bitset<MaxSignatureSize>;
+
+		private:
+			/// <summary>
+			/// IDs of the living Entities.
+			/// </summary>
+			SparseSet m_entities;
+
+			/// <summary>
+			/// Signature of each Entity, in the order of m_entities.
+			/// </summary>
+			std::vector<Signature> m_signatures;
+
+		public:
+			/// <summary>
+			/// Create a new EntityRegistry instance.
+			/// </summary>
+			exported EntityRegistry() = default;
+
+			/// <summary>
+			/// Add an Entity with an empty signature. Nothing is done if the
+			/// Entity is already registered.
+			/// </summary>
+			/// <param name="entity">Entity to add.</param>
+			exported void insert(const Entity& entity);
+
+			/// <summary>
+			/// Add several Entities with an empty signature.
+			/// </summary>
+			/// <param name="entities">Entities to add.</param>
+			exported void insert(std::span<const Entity> entities);
+
+			/// <summary>
+			/// Add several Entities with the same signature, for Entities
+			/// whose Components are known beforehand (see Prefab). The
+			/// signature of an already registered Entity is merged.
+			/// </summary>
+			/// <param name="entities">Entities to add.</param>
+			/// <param name="signature">Signature of the Entities.</param>
+			exported void insert(
+				std::span<const Entity> entities,
+				const Signature& signature
+			);
+
+			/// <summary>
+			/// Remove an Entity.
+			/// </summary>
+			/// <param name="entity">Entity to remove.</param>
+			/// <returns>
+			/// Signature the Entity had; an empty one if it was not
+			/// registered.
+			/// </returns>
+			exported Signature erase(const Entity& entity);
+
+			/// <summary>
+			/// Remove all the Entities. The memory is kept.
+			/// </summary>
+			exported void clear();
+
+			/// <summary>
+			/// Mark that a System holds Components for an Entity. Nothing is
+			/// done if the Entity is not registered.
+			/// </summary>
+			/// <param name="entity">Entity bearing the Components.</param>
+			/// <param name="bit">Bit of the System.</param>
+			exported void set(const Entity& entity, const size_t bit) {
+				auto index = m_entities.indexOf(entity.id());
+
+				if (index != SparseSet::InvalidIndex) {
+					m_signatures[index].set(bit);
+				}
+			}
+
+			/// <summary>
+			/// Mark that a System no longer holds Components for an Entity.
+			/// Nothing is done if the Entity is not registered.
+			/// </summary>
+			/// <param name="entity">Entity bearing no more Components.</param>
+			/// <param name="bit">Bit of the System.</param>
+			exported void reset(const Entity& entity, const size_t bit) {
+				auto index = m_entities.indexOf(entity.id());
+
+				if (index != SparseSet::InvalidIndex) {
+					m_signatures[index].reset(bit);
+				}
+			}
+
+			/// <summary>
+			/// Check if an Entity is registered. A stale Entity is not.
+			/// </summary>
+			/// <param name="entity">Entity to be checked.</param>
+			/// <returns>true if registered; false otherwise.</returns>
+			exported bool contains(const Entity& entity) const {
+				return m_entities.contains(entity.id());
+			}
+
+			/// <summary>
+			/// Get the signature of an Entity.
+			/// </summary>
+			/// <param name="entity">Entity to get the signature.</param>
+			/// <returns>
+			/// Signature of the Entity; an empty one if it is not registered.
+			/// </returns>
+			exported Signature signatureOf(const Entity& entity) const {
+				auto index = m_entities.indexOf(entity.id());
+
+				if (index == SparseSet::InvalidIndex) {
+					return Signature();
+				}
+
+				return m_signatures[index];
+			}
+
+			/// <summary>
+			/// Get the amount of registered Entities.
+			/// </summary>
+			/// <returns>Amount of Entities.</returns>
+			exported size_t size() const {
+				return m_entities.size();
+			}
+
+			/// <summary>
+			/// Get the packed IDs of the registered Entities.
+			/// </summary>
+			/// <returns>Contiguous range of the Entity IDs.</returns>
+			exported std::span<const id_t> entities() const {
+				return m_entities.dense();
+			}
+
+			/// <summary>
+			/// Get the amount of bytes allocated by the registry.
+			/// </summary>
+			/// <returns>Allocated bytes.</returns>
+			exported size_t memoryBytes() const {
+				return m_entities.memoryBytes() + (m_signatures.capacity() * sizeof(Signature));
+			}
+
+		private:
+			/// <summary>
+			/// Make room for more Entities, at least doubling the capacity
+			/// when it is exceeded so that repeated bulk insertions of a few
+			/// Entities stay linear.
+			/// </summary>
+			/// <param name="amount">Amount of Entities to add.</param>
+			void reserveFor(const size_t amount);
+
+			// Disable copy.
+			EntityRegistry(const EntityRegistry& other) = delete;
+			EntityRegistry& operator=(const EntityRegistry& other) = delete;
+	};
+}
+
+#endif
\ No newline at end of file
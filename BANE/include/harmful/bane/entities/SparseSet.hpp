@@ -0,0 +1,198 @@
+#ifndef __BANE_SPARSE_SET__
+#define __BANE_SPARSE_SET__
+
+#include <harmful/doom/utils/Platform.hpp>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <vector>
+#include "harmful/bane/entities/Entity.hpp"
+
+namespace Bane {
+	/// <summary>
+	/// Set of Entity IDs with O(1) insertion, removal and lookup, and a
+	/// dense packing of the IDs for iteration.
+	/// The sparse part maps the position of an Entity to its index in the
+	/// dense part. It is split in pages so that high IDs do not allocate the
+	/// whole range below them.
+	/// </summary>
+	/// <remarks>
+	/// The removal moves the last dense ID in place of the removed one (swap
+	/// and pop). Containers indexed as the dense part must apply the same
+	/// operation on the returned index to stay in sync.
+	/// </remarks>
+	class SparseSet final {
+		public:
+			/// <summary>
+			/// Index returned when an Entity is not in the set.
+			/// </summary>
+			static constexpr size_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+		private:
+			/// <summary>
+			/// Amount of entries in a page of the sparse part (power of two).
+			/// </summary>
+			static constexpr size_t PageSize = 4096;
+
+			/// <summary>
+			/// Pages of the sparse part. A missing page means that no Entity
+			/// of its range is in the set.
+			/// </summary>
+			std::vector<std::unique_ptr<uint32_t[]>> m_sparse;
+
+			/// <summary>
+			/// IDs of the Entities in the set, packed.
+			/// </summary>
+			std::vector<id_t> m_dense;
+
+		public:
+			/// <summary>
+			/// Create a new SparseSet instance.
+			/// </summary>
+			exported SparseSet() = default;
+
+			/// <summary>
+			/// Move constructor.
+			/// </summary>
+			/// <param name="other">SparseSet to be moved.</param>
+			exported SparseSet(SparseSet&& other) = default;
+
+			/// <summary>
+			/// Add an Entity ID to the set.
+			/// </summary>
+			/// <param name="entity">ID of the Entity to add.</param>
+			/// <returns>
+			/// Index of the Entity ID in the dense part. If the Entity was
+			/// already in the set, its current index is returned.
+			/// </returns>
+			exported size_t insert(const id_t entity);
+
+			/// <summary>
+			/// Remove an Entity ID from the set.
+			/// </summary>
+			/// <param name="entity">ID of the Entity to remove.</param>
+			/// <returns>
+			/// Index the Entity ID had in the dense part, now occupied by the
+			/// previously last ID; InvalidIndex if the Entity was not in the
+			/// set.
+			/// </returns>
+			exported size_t erase(const id_t entity);
+
+			/// <summary>
+			/// Remove all the Entity IDs from the set. The memory is kept.
+			/// </summary>
+			exported void clear();
+
+			/// <summary>
+			/// Reserve room in the dense part.
+			/// </summary>
+			/// <param name="capacity">Wanted amount of Entity IDs.</param>
+			exported void reserve(const size_t capacity) {
+				m_dense.reserve(capacity);
+			}
+
+			/// <summary>
+			/// Get the index of an Entity ID in the dense part.
+			/// </summary>
+			/// <param name="entity">ID of the Entity to find.</param>
+			/// <returns>
+			/// Index in the dense part; InvalidIndex if the Entity is not in
+			/// the set.
+			/// </returns>
+			exported size_t indexOf(const id_t entity) const {
+				const size_t position = Position(entity);
+				const size_t page = position / PageSize;
+
+				if ((page >= m_sparse.size()) || !m_sparse[page]) {
+					return InvalidIndex;
+				}
+
+				const size_t index = m_sparse[page][position % PageSize];
+
+				if ((index == InvalidIndex) || (m_dense[index] != entity)) {
+					return InvalidIndex;
+				}
+
+				return index;
+			}
+
+			/// <summary>
+			/// Check if the given Entity ID is in the set.
+			/// </summary>
+			/// <param name="entity">ID of the Entity to be checked.</param>
+			/// <returns>true if in the set; false otherwise.</returns>
+			exported bool contains(const id_t entity) const {
+				return indexOf(entity) != InvalidIndex;
+			}
+
+			/// <summary>
+			/// Get the amount of Entity IDs in the set.
+			/// </summary>
+			/// <returns>Amount of Entity IDs.</returns>
+			exported size_t size() const {
+				return m_dense.size();
+			}
+
+			/// <summary>
+			/// Check if the set is empty.
+			/// </summary>
+			/// <returns>true if empty; false otherwise.</returns>
+			exported bool empty() const {
+				return m_dense.empty();
+			}
+
+			/// <summary>
+			/// Get the Entity ID at the given index in the dense part.
+			/// </summary>
+			/// <param name="index">Index in the dense part.</param>
+			/// <returns>ID of the Entity.</returns>
+			exported id_t at(const size_t index) const {
+				return m_dense[index];
+			}
+
+			/// <summary>
+			/// Get the packed Entity IDs.
+			/// </summary>
+			/// <returns>Contiguous range of the Entity IDs.</returns>
+			exported std::span<const id_t> dense() const {
+				return std::span<const id_t>(m_dense);
+			}
+
+			/// <summary>
+			/// Get the amount of bytes allocated by the set.
+			/// </summary>
+			/// <returns>Allocated bytes.</returns>
+			exported size_t memoryBytes() const;
+
+			/// <summary>
+			/// Move operator.
+			/// </summary>
+			/// <param name="other">SparseSet to be moved.</param>
+			exported SparseSet& operator=(SparseSet&& other) = default;
+
+		private:
+			/// <summary>
+			/// Get the position of an Entity ID in the sparse part.
+			/// </summary>
+			/// <param name="entity">ID of the Entity.</param>
+			/// <returns>Zero-based position in the sparse part.</returns>
+			static size_t Position(const id_t entity) {
+				return Entity(entity).index();
+			}
+
+			/// <summary>
+			/// Get the entry of the sparse part for a position, allocating its
+			/// page if needed.
+			/// </summary>
+			/// <param name="position">Position in the sparse part.</param>
+			/// <returns>Reference to the entry.</returns>
+			uint32_t& sparseEntry(const size_t position);
+
+			// Disable copy.
+			SparseSet(const SparseSet& other) = delete;
+			SparseSet& operator=(const SparseSet& other) = delete;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,224 @@
+#ifndef __BANE_ASYNC_IO__
+#define __BANE_ASYNC_IO__
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+#include <harmful/doom/utils/Platform.hpp>
+#include "harmful/bane/jobs/SystemTask.hpp"
+#include "harmful/bane/systems/System.hpp"
+
+namespace Bane {
+    /// <summary>
+    /// Threads running the blocking operations awaited by SystemTasks (file
+    /// reads, asset decoding...), so that the threads of the Jobs keep
+    /// processing the Systems meanwhile.
+    /// </summary>
+    /// <remarks>
+    /// co_await on an operation suspends the SystemTask and queues the
+    /// operation; once run by an I/O thread, the SystemTask is scheduled back
+    /// on its System and resumed at its next processing, with the result of
+    /// the operation or its exception.
+    /// </remarks>
+    class AsyncIO final {
+        public:
+            /// <summary>
+            /// Awaitable running a function on an I/O thread.
+            /// </summary>
+            /// <typeparam name="Function">Type of the function.</typeparam>
+            template <class Function>
+            class Operation final {
+                public:
+                    /// <summary>
+                    /// Type returned by the function.
+                    /// </summary>
+                    using Result = std::invoke_result_t<Function&>;
+
+                private:
+                    /// <summary>
+                    /// Type storing the result, void being stored as nothing.
+                    /// </summary>
+                    using Storage = std::conditional_t<std::is_void_v<Result>, std::monostate, Result>;
+
+                    /// <summary>
+                    /// AsyncIO running the function.
+                    /// </summary>
+                    AsyncIO* m_io;
+
+                    /// <summary>
+                    /// Function to run.
+                    /// </summary>
+                    Function m_function;
+
+                    /// <summary>
+                    /// Result of the function, once run.
+                    /// </summary>
+                    std::optional<Storage> m_result;
+
+                    /// <summary>
+                    /// Exception thrown by the function, if any.
+                    /// </summary>
+                    std::exception_ptr m_error;
+
+                public:
+                    /// <summary>
+                    /// Create a new Operation instance.
+                    /// </summary>
+                    /// <param name="io">AsyncIO running the function.</param>
+                    /// <param name="function">Function to run.</param>
+                    Operation(AsyncIO& io, Function function)
+                        : m_io(&io), m_function(std::move(function)) {}
+
+                    bool await_ready() const noexcept {
+                        return false;
+                    }
+
+                    void await_suspend(SystemTask::Handle task) {
+                        // The Operation lives in the frame of the SystemTask,
+                        // which is not resumed before being scheduled.
+                        m_io -> post([this, task]() {
+                            try {
+                                if constexpr (std::is_void_v<Result>) {
+                                    m_function();
+                                    m_result.emplace();
+                                }
+                                else {
+                                    m_result.emplace(m_function());
+                                }
+                            }
+                            catch (...) {
+                                m_error = std::current_exception();
+                            }
+
+                            task.promise().system -> schedule(task);
+                        });
+                    }
+
+                    Result await_resume() {
+                        if (m_error) {
+                            std::rethrow_exception(m_error);
+                        }
+
+                        if constexpr (!std::is_void_v<Result>) {
+                            return std::move(*m_result);
+                        }
+                    }
+            };
+
+            /// <summary>
+            /// Awaitable reading a whole file.
+            /// </summary>
+            using ReadOperation = Operation<std::function<std::vector<std::byte>()>>;
+
+        private:
+            /// <summary>
+            /// I/O threads, started at the first request.
+            /// </summary>
+            std::vector<std::thread> m_threads;
+
+            /// <summary>
+            /// Amount of I/O threads to start.
+            /// </summary>
+            uint8_t m_threadCount;
+
+            /// <summary>
+            /// Protects m_threads (until stopped), m_requests and m_running.
+            /// </summary>
+            std::mutex m_mutex;
+
+            /// <summary>
+            /// Condition to wake up the I/O threads.
+            /// </summary>
+            std::condition_variable m_wakeUp;
+
+            /// <summary>
+            /// Requests not taken yet by an I/O thread, in their posting
+            /// order.
+            /// </summary>
+            std::deque<std::function<void()>> m_requests;
+
+            /// <summary>
+            /// false once stopped.
+            /// </summary>
+            bool m_running = true;
+
+        public:
+            /// <summary>
+            /// Create a new AsyncIO instance. Its threads are started at the
+            /// first request, so that an AsyncIO costs no thread until used.
+            /// </summary>
+            /// <param name="threadCount">Amount of I/O threads.</param>
+            exported AsyncIO(const uint8_t threadCount = 1);
+
+            /// <summary>
+            /// Destruction of the AsyncIO instance. The threads are stopped.
+            /// </summary>
+            exported ~AsyncIO() noexcept;
+
+            /// <summary>
+            /// Run a function on an I/O thread when awaited by a SystemTask.
+            /// </summary>
+            /// <typeparam name="Function">Type of the function.</typeparam>
+            /// <param name="function">Function to run.</param>
+            /// <returns>
+            /// Awaitable giving the result of the function, or rethrowing its
+            /// exception.
+            /// </returns>
+            template <class Function>
+            exported Operation<Function> run(Function function) {
+                return Operation<Function>(*this, std::move(function));
+            }
+
+            /// <summary>
+            /// Read a whole file on an I/O thread when awaited by a
+            /// SystemTask. The file is mapped in memory with Spite::MappedFile.
+            /// </summary>
+            /// <param name="path">Path of the file.</param>
+            /// <returns>
+            /// Awaitable giving the content of the file, or throwing
+            /// std::ios_base::failure if it cannot be read.
+            /// </returns>
+            exported ReadOperation read(const std::filesystem::path& path);
+
+            /// <summary>
+            /// Queue a request to run on an I/O thread. Can be called from
+            /// any thread.
+            /// </summary>
+            /// <param name="request">Request to run.</param>
+            /// <exception cref="std::runtime_error">
+            /// The AsyncIO is stopped.
+            /// </exception>
+            exported void post(std::function<void()> request);
+
+            /// <summary>
+            /// Stop the I/O threads once the queued requests are run. Nothing
+            /// can be posted anymore.
+            /// </summary>
+            exported void stop();
+
+        private:
+            /// <summary>
+            /// Run the requests until stopped.
+            /// </summary>
+            void work();
+
+            // Disable copy and move.
+            AsyncIO(const AsyncIO& other) = delete;
+            AsyncIO(AsyncIO&& other) = delete;
+            AsyncIO& operator=(const AsyncIO& other) = delete;
+            AsyncIO& operator=(AsyncIO&& other) = delete;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,84 @@
+#ifndef __BANE_ASYNC_SIGNAL__
+#define __BANE_ASYNC_SIGNAL__
+
+#include <mutex>
+#include <vector>
+#include <harmful/doom/utils/Platform.hpp>
+#include "harmful/bane/jobs/SystemTask.hpp"
+
+namespace Bane {
+    /// <summary>
+    /// Signal awaited by SystemTasks: co_await suspends a SystemTask until
+    /// the next call to raise(), which schedules it back on its System. Each
+    /// Job raises its own signal at the end of its frames (see
+    /// Job::completion()).
+    /// </summary>
+    class AsyncSignal final {
+        public:
+            /// <summary>
+            /// Awaitable suspending a SystemTask until the signal is raised.
+            /// </summary>
+            struct Awaiter {
+                /// <summary>
+                /// Awaited signal.
+                /// </summary>
+                AsyncSignal* signal;
+
+                bool await_ready() const noexcept {
+                    return false;
+                }
+
+                void await_suspend(SystemTask::Handle task) {
+                    signal -> wait(task);
+                }
+
+                void await_resume() const noexcept {}
+            };
+
+        private:
+            /// <summary>
+            /// Protects m_waitingTasks.
+            /// </summary>
+            std::mutex m_mutex;
+
+            /// <summary>
+            /// SystemTasks suspended until the next raise().
+            /// </summary>
+            std::vector<SystemTask::Handle> m_waitingTasks;
+
+        public:
+            /// <summary>
+            /// Create a new AsyncSignal instance.
+            /// </summary>
+            exported AsyncSignal() = default;
+
+            /// <summary>
+            /// Suspend a SystemTask until the next raise().
+            /// </summary>
+            /// <returns>Awaitable of the signal.</returns>
+            exported Awaiter operator co_await() {
+                return Awaiter { this };
+            }
+
+            /// <summary>
+            /// Schedule the waiting SystemTasks on their Systems. Can be
+            /// called from any thread.
+            /// </summary>
+            exported void raise();
+
+        private:
+            /// <summary>
+            /// Add a suspended SystemTask to the waiting ones.
+            /// </summary>
+            /// <param name="task">Suspended SystemTask.</param>
+            void wait(SystemTask::Handle task);
+
+            // Disable copy and move.
+            AsyncSignal(const AsyncSignal& other) = delete;
+            AsyncSignal(AsyncSignal&& other) = delete;
+            AsyncSignal& operator=(const AsyncSignal& other) = delete;
+            AsyncSignal& operator=(AsyncSignal&& other) = delete;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,254 @@
+#ifndef __BANE_CHUNK_BALANCER__
+#define __BANE_CHUNK_BALANCER__
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include <harmful/doom/utils/Platform.hpp>
+#include "harmful/bane/systems/System.hpp"
+
+namespace Bane {
+    /// <summary>
+    /// Split the Components of the Systems of a Job into chunks processed
+    /// by its threads.
+    /// </summary>
+    /// <remarks>
+    /// In adaptive mode, the execution time of each chunk is measured and
+    /// kept in a cost profile per System (cost per Component over the range
+    /// of Components, smoothed over the frames). The next chunks are cut so
+    /// that they have the same cost: the most expensive chunk stays short
+    /// compared to the work of each thread, which keeps the critical path
+    /// close to the total cost divided by the amount of threads.
+    /// </remarks>
+    class ChunkBalancer final {
+        public:
+            /// <summary>
+            /// How the Components are split into chunks.
+            /// </summary>
+            enum class Mode : uint8_t {
+                /// <summary>
+                /// Same amount of Components in each chunk, a few chunks per
+                /// thread.
+                /// </summary>
+                Static,
+
+                /// <summary>
+                /// Decreasing chunk sizes (half of the remaining work per
+                /// thread), so that the last chunks fill the gaps.
+                /// </summary>
+                Guided,
+
+                /// <summary>
+                /// Chunks of the same measured cost, from the previous
+                /// frames. Guided until the first measures are available.
+                /// </summary>
+                Adaptive,
+
+                /// <summary>
+                /// Chunks of FixedChunkSize Components, whatever the amount
+                /// of threads and the measures: the chunks only depend on the
+                /// amount of Components (deterministic execution).
+                /// </summary>
+                Fixed
+            };
+
+            /// <summary>
+            /// Amount of Components in a chunk in fixed mode.
+            /// </summary>
+            static constexpr size_t FixedChunkSize = 4096;
+
+            /// <summary>
+            /// Range of Components of a System processed at once.
+            /// </summary>
+            struct Chunk {
+                size_t fromIndex;
+                size_t toIndex;
+            };
+
+            /// <summary>
+            /// Measure of the execution time of a chunk.
+            /// </summary>
+            struct ChunkTiming {
+                /// <summary>
+                /// System of the chunk.
+                /// </summary>
+                System* system;
+
+                /// <summary>
+                /// Amount of Components of the System when the chunk has been
+                /// processed.
+                /// </summary>
+                size_t amountComponents;
+
+                /// <summary>
+                /// Start index of the chunk.
+                /// </summary>
+                size_t fromIndex;
+
+                /// <summary>
+                /// End index (excluded) of the chunk.
+                /// </summary>
+                size_t toIndex;
+
+                /// <summary>
+                /// Execution time of the chunk, in nanoseconds.
+                /// </summary>
+                std::int64_t duration;
+
+                /// <summary>
+                /// Index of the thread that processed the chunk.
+                /// </summary>
+                size_t thread;
+
+                /// <summary>
+                /// End of the execution of the chunk, in nanoseconds on the
+                /// steady clock.
+                /// </summary>
+                std::int64_t end;
+            };
+
+        private:
+            /// <summary>
+            /// Amount of chunks each thread gets per System, so that the
+            /// threads finishing early can steal work from the others.
+            /// </summary>
+            static constexpr size_t ChunksPerThread = 4;
+
+            /// <summary>
+            /// Minimal amount of Components in a chunk, so that the cost of a
+            /// chunk is not dominated by its scheduling.
+            /// </summary>
+            static constexpr size_t MinimalChunkSize = 64;
+
+            /// <summary>
+            /// Minimal cost of a chunk in adaptive mode, in nanoseconds.
+            /// </summary>
+            static constexpr double MinimalChunkCost = 20000.;
+
+            /// <summary>
+            /// Amount of ranges the Components of a System are split into in
+            /// a cost profile.
+            /// </summary>
+            static constexpr size_t AmountBuckets = 64;
+
+            /// <summary>
+            /// Weight of the last frame in the cost profiles.
+            /// </summary>
+            static constexpr double Smoothing = 0.5;
+
+            /// <summary>
+            /// Cost of the Components of a System.
+            /// </summary>
+            struct Profile {
+                /// <summary>
+                /// Cost per Component in each range of Components, in
+                /// nanoseconds.
+                /// </summary>
+                std::array<double, AmountBuckets> costs{};
+
+                /// <summary>
+                /// true once at least one frame has been measured.
+                /// </summary>
+                bool isMeasured = false;
+            };
+
+            /// <summary>
+            /// How the Components are split into chunks.
+            /// </summary>
+            Mode m_mode = Mode::Adaptive;
+
+            /// <summary>
+            /// Cost profile of each System.
+            /// </summary>
+            std::unordered_map<const System*, Profile> m_profiles;
+
+        public:
+            /// <summary>
+            /// Create a new ChunkBalancer instance.
+            /// </summary>
+            exported ChunkBalancer() = default;
+
+            /// <summary>
+            /// Split the Components of a System into chunks.
+            /// </summary>
+            /// <param name="system">System to split.</param>
+            /// <param name="amountThreads">
+            /// Amount of threads processing the chunks.
+            /// </param>
+            /// <param name="chunks">List the chunks are added to.</param>
+            exported void split(
+                const System* system,
+                const size_t amountThreads,
+                std::vector<Chunk>& chunks
+            ) const;
+
+            /// <summary>
+            /// Update the cost profiles from the measures of the last frame.
+            /// </summary>
+            /// <param name="timings">Measures of the chunks.</param>
+            exported void update(std::span<const ChunkTiming> timings);
+
+            /// <summary>
+            /// Forget the cost profiles.
+            /// </summary>
+            exported void reset() {
+                m_profiles.clear();
+            }
+
+            /// <summary>
+            /// Set how the Components are split into chunks.
+            /// </summary>
+            /// <param name="mode">Splitting mode.</param>
+            exported void setMode(const Mode mode) {
+                m_mode = mode;
+            }
+
+            /// <summary>
+            /// Get how the Components are split into chunks.
+            /// </summary>
+            /// <returns>Splitting mode.</returns>
+            exported Mode mode() const {
+                return m_mode;
+            }
+
+        private:
+            /// <summary>
+            /// Split into chunks of the same size.
+            /// </summary>
+            void splitStatic(
+                const size_t amountComponents,
+                const size_t amountThreads,
+                std::vector<Chunk>& chunks
+            ) const;
+
+            /// <summary>
+            /// Split into chunks of decreasing size.
+            /// </summary>
+            void splitGuided(
+                const size_t amountComponents,
+                const size_t amountThreads,
+                std::vector<Chunk>& chunks
+            ) const;
+
+            /// <summary>
+            /// Split into chunks of the same cost.
+            /// </summary>
+            void splitAdaptive(
+                const Profile& profile,
+                const size_t amountComponents,
+                const size_t amountThreads,
+                std::vector<Chunk>& chunks
+            ) const;
+
+            /// <summary>
+            /// Get the first Component index of a range of a cost profile.
+            /// </summary>
+            static size_t BucketStart(const size_t bucket, const size_t amountComponents) {
+                return (bucket * amountComponents) / AmountBuckets;
+            }
+    };
+}
+
+#endif
\ No newline at end of file
@@ -1,14 +1,19 @@
 #ifndef __BANE_JOB__
 #define __BANE_JOB__
 
-#include <list>
+#include <memory>
+#include <span>
 #include <vector>
-#include <unordered_map>
 #include <harmful/doom/utils/Platform.hpp>
-#include "harmful/bane/entities/Entity.hpp"
+#include "harmful/bane/entities/EntityFactory.hpp"
 #include "harmful/bane/systems/System.hpp"
-#include "harmful/bane/jobs/ThreadJob.hpp"
-#include "harmful/bane/jobs/JobSynchronization.hpp"
+#include "harmful/bane/jobs/AsyncSignal.hpp"
+#include "harmful/bane/jobs/ChunkBalancer.hpp"
+#include "harmful/bane/jobs/JobStatistics.hpp"
+#include "harmful/bane/jobs/ThreadPlacement.hpp"
+#include "harmful/bane/jobs/ThreadTask.hpp"
+#include "harmful/bane/jobs/WorkerPool.hpp"
+#include "harmful/bane/world/CommandBuffer.hpp"
 
 namespace Bane {
     /// <summary>
@@ -18,15 +23,47 @@ namespace Bane {
     class Job final {
         private:
             /// <summary>
-            /// Name of the Job.
+            /// What a chunk, or the resumption of a SystemTask of a
+            /// multithreadable System, needs to be processed.
             /// </summary>
-            std::string m_name;
+            struct ChunkContext {
+                /// <summary>
+                /// Job the chunk belongs to.
+                /// </summary>
+                Job* job;
+
+                /// <summary>
+                /// Measure of the chunk; nullptr for a resumption.
+                /// </summary>
+                ChunkBalancer::ChunkTiming* timing;
+
+                /// <summary>
+                /// CommandBuffer of the chunk in deterministic mode; nullptr
+                /// to use the one of the thread processing the chunk.
+                /// </summary>
+                CommandBuffer* commands;
+
+                /// <summary>
+                /// Seed of the random stream of the chunk.
+                /// </summary>
+                uint64_t seed;
+
+                /// <summary>
+                /// Index in m_readyTasks of the first SystemTask resumed by
+                /// the chunk before processing its Components.
+                /// </summary>
+                size_t firstTask;
+
+                /// <summary>
+                /// Amount of SystemTasks resumed by the chunk.
+                /// </summary>
+                size_t amountTasks;
+            };
 
             /// <summary>
-            /// Set of data for synchronizing the current Job with its
-            /// different ThreadJobs.
+            /// Name of the Job.
             /// </summary>
-            JobSynchronization m_syncData;
+            std::string m_name;
 
             /// <summary>
             /// Systems used by the Job.
@@ -34,14 +71,120 @@ namespace Bane {
             std::vector<System*> m_systems;
 
             /// <summary>
-            /// Threads for running the Job in parallel.
+            /// Threads for running the Job in parallel, possibly shared with
+            /// other Jobs.
+            /// </summary>
+            std::shared_ptr<WorkerPool> m_threads;
+
+            /// <summary>
+            /// true if m_threads are created by the Job, false if shared.
+            /// </summary>
+            bool m_ownsThreads = true;
+
+            /// <summary>
+            /// Where the threads run.
+            /// </summary>
+            ThreadPlacement m_placement;
+
+            /// <summary>
+            /// Chunks of Components to process at the current execution.
             /// </summary>
-            std::vector<ThreadJob> m_threads;
+            std::vector<ThreadTask> m_chunks;
 
             /// <summary>
-            /// List of entity IDs to be dropped.
+            /// Measures of the chunks of the current execution, in the same
+            /// order as the chunks. Each chunk only writes its own measure.
             /// </summary>
-            std::list<Entity> m_dropEntities;
+            std::vector<ChunkBalancer::ChunkTiming> m_timings;
+
+            /// <summary>
+            /// Context of the chunks of the current execution, in the same
+            /// order as the chunks, followed by the ones of the resumptions.
+            /// </summary>
+            std::vector<ChunkContext> m_contexts;
+
+            /// <summary>
+            /// SystemTasks of the Systems resumed by the current execution.
+            /// Those of a multithreadable System are resumed by their own
+            /// ThreadTask, the others by the single chunk of their System.
+            /// </summary>
+            std::vector<SystemTask::Handle> m_readyTasks;
+
+            /// <summary>
+            /// Split the Components of the Systems into chunks.
+            /// </summary>
+            ChunkBalancer m_balancer;
+
+            /// <summary>
+            /// Group of the chunks of the current execution.
+            /// </summary>
+            TaskGroup m_chunksGroup;
+
+            /// <summary>
+            /// Commands recorded by the Systems, one CommandBuffer per thread
+            /// so that recording needs no lock.
+            /// </summary>
+            std::vector<std::unique_ptr<CommandBuffer>> m_commands;
+
+            /// <summary>
+            /// Commands recorded by the Systems in deterministic mode, one
+            /// CommandBuffer per chunk and per resumption so that they are
+            /// collected in the order of the chunks. Kept from an execution
+            /// to another.
+            /// </summary>
+            std::vector<std::unique_ptr<CommandBuffer>> m_chunkCommands;
+
+            /// <summary>
+            /// Amount of m_chunkCommands used since the last collection.
+            /// </summary>
+            size_t m_amountChunkCommands = 0;
+
+            /// <summary>
+            /// Factory of the Entities created by the Systems.
+            /// </summary>
+            EntityFactory* m_entities;
+
+            /// <summary>
+            /// true if the results must not depend on the threads.
+            /// </summary>
+            bool m_isDeterministic = false;
+
+            /// <summary>
+            /// true if submit() began a reservation of m_entities, ended by
+            /// wait().
+            /// </summary>
+            bool m_ownsReservation = false;
+
+            /// <summary>
+            /// Splitting mode to use when leaving the deterministic mode.
+            /// </summary>
+            ChunkBalancer::Mode m_balancingMode = ChunkBalancer::Mode::Adaptive;
+
+            /// <summary>
+            /// Seed of the random streams of the next submitted chunks.
+            /// </summary>
+            uint64_t m_seed = 0;
+
+            /// <summary>
+            /// Submission time of the current execution, in nanoseconds on
+            /// the steady clock.
+            /// </summary>
+            std::int64_t m_submissionTime = 0;
+
+            /// <summary>
+            /// Timings of the executions since the last call to endFrame().
+            /// </summary>
+            JobStatistics m_frameStatistics;
+
+            /// <summary>
+            /// Timings of the last complete frame.
+            /// </summary>
+            JobStatistics m_statistics;
+
+            /// <summary>
+            /// Raised at the end of each frame.
+            /// </summary>
+            AsyncSignal m_completion;
 
         public:
             /// <summary>
@@ -50,10 +193,36 @@ namespace Bane {
             /// <param name="name">Name of the Job.</param>
             /// <param name="systems">Systems used by the Job.</param>
             /// <param name="threadCount">Amount of threads in the Job.</param>
+            /// <param name="entities">
+            /// Factory of the Entities created by the Systems.
+            /// </param>
+            /// <param name="placement">Where the threads run.</param>
+            exported Job(
+                const std::string& name,
+                const std::vector<System*> systems,
+                const uint8_t threadCount,
+                EntityFactory& entities,
+                const ThreadPlacement& placement = ThreadPlacement()
+            );
+
+            /// <summary>
+            /// Create a new Job instance running on shared threads, for
+            /// example the ones of several Worlds (see WorldGroup).
+            /// </summary>
+            /// <param name="name">Name of the Job.</param>
+            /// <param name="systems">Systems used by the Job.</param>
+            /// <param name="threads">
+            /// Threads running the Job. They are not stopped by stop().
+            /// </param>
+            /// <param name="entities">
+            /// Factory of the Entities created by the Systems.
+            /// </param>
+            /// <exception cref="std::runtime_error">The threads are null.</exception>
             exported Job(
                 const std::string& name,
                 const std::vector<System*> systems,
-                const uint8_t threadCount
+                std::shared_ptr<WorkerPool> threads,
+                EntityFactory& entities
             );
 
             /// <summary>
@@ -62,7 +231,91 @@ namespace Bane {
             exported void execute();
 
             /// <summary>
-            /// Stop the Job and all its threads.
+            /// Start processing some of the Systems of the Job, without
+            /// waiting for them to finish.
+            /// </summary>
+            /// <param name="systems">
+            /// Systems to process. Systems that do not belong to the Job are
+            /// ignored.
+            /// </param>
+            /// <remarks>
+            /// wait() must be called before submitting other Systems. In
+            /// deterministic mode, the Entities created by the Systems are
+            /// reserved from the EntityFactory until wait().
+            /// </remarks>
+            exported void submit(std::span<System* const> systems);
+
+            /// <summary>
+            /// Split some of the Systems of the Job into chunks, without
+            /// starting them: submit() in two steps, for several Jobs to
+            /// share a reservation of the EntityFactory.
+            /// </summary>
+            /// <param name="systems">
+            /// Systems to process. Systems that do not belong to the Job are
+            /// ignored.
+            /// </param>
+            /// <param name="firstStream">
+            /// Stream of the reservation of the first chunk, in deterministic
+            /// mode.
+            /// </param>
+            /// <returns>
+            /// Amount of streams used by the chunks; 0 if the deterministic
+            /// mode is disabled.
+            /// </returns>
+            /// <remarks>
+            /// The reservation must be running when launch() is called, and
+            /// ended by the caller after wait().
+            /// </remarks>
+            exported uint32_t prepare(
+                std::span<System* const> systems,
+                const uint32_t firstStream
+            );
+
+            /// <summary>
+            /// Start processing the chunks split by prepare(), without
+            /// waiting for them to finish.
+            /// </summary>
+            exported void launch();
+
+            /// <summary>
+            /// Wait for the submitted Systems to be processed.
+            /// </summary>
+            exported void wait();
+
+            /// <summary>
+            /// Check if a System belongs to the Job.
+            /// </summary>
+            /// <param name="system">System to be checked.</param>
+            /// <returns>true if it belongs to the Job; false otherwise.</returns>
+            exported bool contains(const System* system) const;
+
+            /// <summary>
+            /// Get the Systems used by the Job.
+            /// </summary>
+            /// <returns>Systems used by the Job.</returns>
+            exported const std::vector<System*>& systems() const {
+                return m_systems;
+            }
+
+            /// <summary>
+            /// Get the threads of the Job, to run other work on them between
+            /// two executions.
+            /// </summary>
+            /// <returns>Threads of the Job.</returns>
+            exported WorkerPool& threads() const {
+                return *m_threads;
+            }
+
+            /// <summary>
+            /// Get where the threads of the Job run.
+            /// </summary>
+            /// <returns>Placement of the threads.</returns>
+            exported const ThreadPlacement& placement() const {
+                return m_placement;
+            }
+
+            /// <summary>
+            /// Stop the Job and all its threads, unless they are shared.
             /// </summary>
             exported void stop();
 
@@ -75,47 +328,124 @@ namespace Bane {
             }
 
             /// <summary>
-            /// Get the Entities that the World should delete.
+            /// Move the commands recorded by the Systems since the last call
+            /// into another CommandBuffer, in the order of the threads (of the
+            /// chunks in deterministic mode).
             /// </summary>
-            /// <returns>List of Entities to be deleted.</returns>
-            exported std::list<Entity>& dropEntities() {
-                return m_dropEntities;
+            /// <param name="commands">CommandBuffer receiving the commands.</param>
+            exported void collectCommands(CommandBuffer& commands);
+
+            /// <summary>
+            /// Set how the Components of the Systems are split into chunks.
+            /// </summary>
+            /// <param name="mode">Splitting mode.</param>
+            /// <remarks>
+            /// In deterministic mode, the mode is used once the deterministic
+            /// mode is left.
+            /// </remarks>
+            exported void setBalancing(const ChunkBalancer::Mode mode);
+
+            /// <summary>
+            /// Get how the Components of the Systems are split into chunks.
+            /// </summary>
+            /// <returns>Splitting mode.</returns>
+            exported ChunkBalancer::Mode balancing() const {
+                return m_balancer.mode();
             }
 
-        private:
             /// <summary>
-            /// Create the threads of the Job.
+            /// Enable or disable the deterministic mode: the chunks only
+            /// depend on the amount of Components (ChunkBalancer::Mode::Fixed)
+            /// and each chunk records its commands in its own CommandBuffer,
+            /// collected in the order of the chunks, and creates its Entities
+            /// from its own stream of IDs. The threads still process the
+            /// chunks in parallel.
             /// </summary>
-            /// <param name="threadCount">Amount of threads in the Job.</param>
-            void createThreads(const uint8_t threadCount);
+            /// <param name="deterministic">true to enable.</param>
+            exported void setDeterministic(const bool deterministic);
+
+            /// <summary>
+            /// Check if the deterministic mode is enabled.
+            /// </summary>
+            /// <returns>true if enabled; false otherwise.</returns>
+            exported bool isDeterministic() const {
+                return m_isDeterministic;
+            }
 
             /// <summary>
-            /// Start the threads of the Job.
+            /// Set the seed of the random streams of the next submitted
+            /// chunks. Each chunk gets a stream seeded from this seed and its
+            /// position in the submission (see CommandBuffer::random()).
             /// </summary>
-            void startThreads();
+            /// <param name="seed">Seed of the submission.</param>
+            exported void seed(const uint64_t seed) {
+                m_seed = seed;
+            }
 
             /// <summary>
-            /// Define the work load for each ThreadJob on each system.
+            /// Close the current frame: its timings become the ones returned
+            /// by statistics() and completion() is raised. Called by execute()
+            /// and by the World at the end of each step running the Job.
             /// </summary>
-            void defineThreadsCharge();
+            exported void endFrame();
+
+            /// <summary>
+            /// Get the timings of the last complete frame, per System and per
+            /// thread.
+            /// </summary>
+            /// <returns>Timings of the last frame.</returns>
+            exported const JobStatistics& statistics() const {
+                return m_statistics;
+            }
 
             /// <summary>
-            /// Define the amount of Components processed by each threads (the
-            /// thread #0 gets the extra amount of Components).
+            /// Get the signal raised at the end of each frame of the Job, for
+            /// SystemTasks to wait for the Job.
             /// </summary>
-            /// <param name="threadCharge">
-            /// Workload for each thread on each System.
+            /// <returns>Signal of the end of the frames.</returns>
+            exported AsyncSignal& completion() {
+                return m_completion;
+            }
+
+        private:
+            /// <summary>
+            /// Split the Components of each System into chunks, processed
+            /// by the threads. A System that is not multithreadable gets a
+            /// single chunk, which also resumes its scheduled SystemTasks;
+            /// the SystemTasks of the other Systems get a ThreadTask each.
+            /// </summary>
+            /// <param name="systems">Systems to process.</param>
+            /// <param name="firstStream">
+            /// Stream of the reservation of the first chunk, in deterministic
+            /// mode.
             /// </param>
-            void computeThreadCharge(std::unordered_map<System*, std::vector<uint32_t>>& threadCharge);
+            void computeChunks(
+                std::span<System* const> systems,
+                const uint32_t firstStream
+            );
+
+            /// <summary>
+            /// Process a chunk of Components of a System.
+            /// </summary>
+            /// <param name="worker">ThreadJob processing the chunk.</param>
+            /// <param name="task">The chunk to process.</param>
+            static void ProcessChunk(ThreadJob& worker, const ThreadTask& task);
 
             /// <summary>
-            /// Set the bounds of processing for each ThreadJob (start and end
-            /// indices of Components to process).
+            /// Resume SystemTasks of multithreadable Systems.
             /// </summary>
-            /// <param name="threadCharge">
-            /// Workload for each thread on each System.
+            /// <param name="worker">ThreadJob resuming the SystemTasks.</param>
+            /// <param name="task">
+            /// ThreadTask whose context is a ChunkContext and whose range is
+            /// in m_readyTasks.
             /// </param>
-            void computeThreadChargeBounds(std::unordered_map<System*, std::vector<uint32_t>>& threadCharge);
+            static void ResumeTasks(ThreadJob& worker, const ThreadTask& task);
+
+            /// <summary>
+            /// Get the current time of the steady clock.
+            /// </summary>
+            /// <returns>Current time in nanoseconds.</returns>
+            static std::int64_t Now();
     };
 }
 
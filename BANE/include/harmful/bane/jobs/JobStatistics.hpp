@@ -0,0 +1,186 @@
+#ifndef __BANE_JOB_STATISTICS__
+#define __BANE_JOB_STATISTICS__
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+#include <harmful/doom/utils/Platform.hpp>
+#include "harmful/bane/jobs/ChunkBalancer.hpp"
+
+namespace Bane {
+    /// <summary>
+    /// Timings of the executions of a Job during a frame, per System and per
+    /// thread.
+    /// </summary>
+    /// <remarks>
+    /// The measures come from the chunks already timed for the ChunkBalancer
+    /// and are gathered once the chunks are done, so the threads do not
+    /// share any counter. The wait time of a thread is the part of an
+    /// execution (from the submission to the end of its last chunk) it did
+    /// not spend processing chunks: waiting for the other threads to finish
+    /// or for work to steal.
+    /// </remarks>
+    class JobStatistics final {
+        public:
+            /// <summary>
+            /// Thread index of the timings summed over all the threads.
+            /// </summary>
+            static constexpr size_t AllThreads = std::numeric_limits<size_t>::max();
+
+            /// <summary>
+            /// Timings of a System on a thread.
+            /// </summary>
+            struct SystemTimings {
+                /// <summary>
+                /// Measured System.
+                /// </summary>
+                const System* system;
+
+                /// <summary>
+                /// Index of the thread in the Job.
+                /// </summary>
+                size_t thread;
+
+                /// <summary>
+                /// Time spent processing the Components, in nanoseconds.
+                /// </summary>
+                std::int64_t busyTime;
+
+                /// <summary>
+                /// Amount of processed Components.
+                /// </summary>
+                size_t amountComponents;
+
+                /// <summary>
+                /// Amount of processed chunks.
+                /// </summary>
+                size_t amountChunks;
+            };
+
+            /// <summary>
+            /// Timings of a thread, all Systems included.
+            /// </summary>
+            struct ThreadTimings {
+                /// <summary>
+                /// Time spent processing Components, in nanoseconds.
+                /// </summary>
+                std::int64_t busyTime = 0;
+
+                /// <summary>
+                /// Time spent without Components to process while the Job was
+                /// executing, in nanoseconds.
+                /// </summary>
+                std::int64_t waitTime = 0;
+
+                /// <summary>
+                /// Amount of processed Components.
+                /// </summary>
+                size_t amountComponents = 0;
+
+                /// <summary>
+                /// Amount of processed chunks.
+                /// </summary>
+                size_t amountChunks = 0;
+            };
+
+        private:
+            /// <summary>
+            /// Timings of each System on each thread that processed it, in
+            /// their order of first execution.
+            /// </summary>
+            std::vector<SystemTimings> m_systems;
+
+            /// <summary>
+            /// Timings of each thread of the Job.
+            /// </summary>
+            std::vector<ThreadTimings> m_threads;
+
+            /// <summary>
+            /// Busy time of each thread during the recorded execution.
+            /// </summary>
+            std::vector<std::int64_t> m_executionBusyTimes;
+
+            /// <summary>
+            /// Time from the submissions to the end of their last chunk,
+            /// summed over the executions, in nanoseconds.
+            /// </summary>
+            std::int64_t m_wallTime = 0;
+
+            /// <summary>
+            /// Amount of recorded executions.
+            /// </summary>
+            size_t m_amountExecutions = 0;
+
+        public:
+            /// <summary>
+            /// Create a new JobStatistics instance.
+            /// </summary>
+            /// <param name="amountThreads">Amount of threads of the Job.</param>
+            exported JobStatistics(const size_t amountThreads = 0);
+
+            /// <summary>
+            /// Add the measures of an execution of the Job.
+            /// </summary>
+            /// <param name="timings">Measures of the chunks of the execution.</param>
+            /// <param name="start">
+            /// Submission time of the chunks, in nanoseconds on the steady
+            /// clock.
+            /// </param>
+            exported void record(
+                std::span<const ChunkBalancer::ChunkTiming> timings,
+                const std::int64_t start
+            );
+
+            /// <summary>
+            /// Reset the measures, keeping the amount of threads.
+            /// </summary>
+            exported void clear();
+
+            /// <summary>
+            /// Get the timings of each System on each thread that processed
+            /// it.
+            /// </summary>
+            /// <returns>Timings per System and per thread.</returns>
+            exported const std::vector<SystemTimings>& systems() const {
+                return m_systems;
+            }
+
+            /// <summary>
+            /// Get the timings of each thread of the Job.
+            /// </summary>
+            /// <returns>Timings per thread, in the order of the threads.</returns>
+            exported const std::vector<ThreadTimings>& threads() const {
+                return m_threads;
+            }
+
+            /// <summary>
+            /// Get the timings of a System, summed over the threads.
+            /// </summary>
+            /// <param name="system">Measured System.</param>
+            /// <returns>
+            /// Timings of the System, with AllThreads as thread. All zeros if
+            /// the System has not been processed.
+            /// </returns>
+            exported SystemTimings system(const System* system) const;
+
+            /// <summary>
+            /// Get the time from the submissions to the end of their last
+            /// chunk, summed over the executions.
+            /// </summary>
+            /// <returns>Wall time in nanoseconds.</returns>
+            exported std::int64_t wallTime() const {
+                return m_wallTime;
+            }
+
+            /// <summary>
+            /// Get the amount of recorded executions.
+            /// </summary>
+            /// <returns>Amount of executions.</returns>
+            exported size_t amountExecutions() const {
+                return m_amountExecutions;
+            }
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,116 @@
+#ifndef __BANE_RANDOM_STREAM__
+#define __BANE_RANDOM_STREAM__
+
+#include <cstdint>
+#include <limits>
+#include <harmful/doom/utils/Platform.hpp>
+
+namespace Bane {
+    /// <summary>
+    /// Small pseudo-random generator (SplitMix64) whose sequence only depends
+    /// on its seed, on every platform. Each chunk of Components processed by
+    /// a Job gets its own stream, so that the drawn values do not depend on
+    /// the thread running the chunk.
+    /// </summary>
+    /// <remarks>
+    /// It meets the requirements of UniformRandomBitGenerator, but the
+    /// distributions of the standard library may differ between
+    /// implementations: nextNormalizedFloat() and nextInteger() do not.
+    /// </remarks>
+    class RandomStream final {
+        public:
+            using result_type = uint64_t;
+
+        private:
+            /// <summary>
+            /// Current state of the generator.
+            /// </summary>
+            uint64_t m_state = 0;
+
+        public:
+            /// <summary>
+            /// Create a new RandomStream instance.
+            /// </summary>
+            /// <param name="seed">Seed of the stream.</param>
+            exported RandomStream(const uint64_t seed = 0)
+                : m_state(seed) {}
+
+            /// <summary>
+            /// Restart the stream from a seed.
+            /// </summary>
+            /// <param name="seed">Seed of the stream.</param>
+            exported void seed(const uint64_t seed) {
+                m_state = seed;
+            }
+
+            /// <summary>
+            /// Get the next value of the stream.
+            /// </summary>
+            /// <returns>The generated value.</returns>
+            exported uint64_t next() {
+                m_state += 0x9E3779B97F4A7C15ull;
+                return Finalize(m_state);
+            }
+
+            /// <summary>
+            /// Get the next value of the stream as a float in [0, 1).
+            /// </summary>
+            /// <returns>The generated value.</returns>
+            exported float nextNormalizedFloat() {
+                return static_cast<float>(next() >> 40) * (1.0f / static_cast<float>(1ull << 24));
+            }
+
+            /// <summary>
+            /// Get the next value of the stream in an interval.
+            /// </summary>
+            /// <param name="min">Minimal value of the interval.</param>
+            /// <param name="max">Maximal value of the interval (included).</param>
+            /// <returns>
+            /// The generated value. If min >= max, min is returned.
+            /// </returns>
+            exported int64_t nextInteger(const int64_t min, const int64_t max) {
+                if (min >= max) {
+                    return min;
+                }
+
+                uint64_t range = static_cast<uint64_t>(max - min) + 1;
+                uint64_t value = (range == 0) ? next() : (next() % range);
+                return min + static_cast<int64_t>(value);
+            }
+
+            exported uint64_t operator()() {
+                return next();
+            }
+
+            exported static constexpr uint64_t min() {
+                return 0;
+            }
+
+            exported static constexpr uint64_t max() {
+                return std::numeric_limits<uint64_t>::max();
+            }
+
+            /// <summary>
+            /// Combine two values into a seed, so that close values give
+            /// unrelated streams.
+            /// </summary>
+            /// <param name="seed">First value.</param>
+            /// <param name="value">Second value.</param>
+            /// <returns>The combined seed.</returns>
+            exported static constexpr uint64_t Mix(const uint64_t seed, const uint64_t value) {
+                return Finalize(seed ^ Finalize(value + 0x9E3779B97F4A7C15ull));
+            }
+
+        private:
+            /// <summary>
+            /// Scramble the bits of a value.
+            /// </summary>
+            static constexpr uint64_t Finalize(uint64_t value) {
+                value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+                value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+                return value ^ (value >> 31);
+            }
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,149 @@
+#ifndef __BANE_SYSTEM_TASK__
+#define __BANE_SYSTEM_TASK__
+
+#include <coroutine>
+#include <utility>
+#include <harmful/doom/utils/Platform.hpp>
+
+namespace Bane {
+    class CommandBuffer;
+    class System;
+
+    /// <summary>
+    /// Coroutine run on behalf of a System, for work waiting on long-latency
+    /// operations (file reads with AsyncIO, completion of another Job with
+    /// AsyncSignal) without blocking a thread of a Job.
+    /// </summary>
+    /// <remarks>
+    /// A SystemTask is started by System::spawn(). Each time it is suspended
+    /// by an awaited operation, the operation schedules it back on its System
+    /// once complete, and it is resumed by the Job running the System at its
+    /// next processing, on any of the threads of the Job. It therefore
+    /// accesses the Components of its System under the same rules as the
+    /// processing.
+    ///
+    /// The CommandBuffer of the thread resuming the SystemTask is given by
+    /// co_await SystemTask::Commands(); it is valid until the next
+    /// suspension. In deterministic mode, each resumption gets its own
+    /// CommandBuffer and random stream instead, collected in the order of
+    /// the resumptions. The completion order of the awaited operations
+    /// still depends on the threads: a SystemTask awaiting them is not
+    /// deterministic.
+    /// </remarks>
+    class SystemTask final {
+        public:
+            /// <summary>
+            /// State shared by the SystemTask and its coroutine.
+            /// </summary>
+            struct promise_type {
+                /// <summary>
+                /// System the coroutine runs for.
+                /// </summary>
+                System* system = nullptr;
+
+                /// <summary>
+                /// CommandBuffer of the thread (of the resumption in
+                /// deterministic mode) currently resuming the coroutine.
+                /// </summary>
+                CommandBuffer* commands = nullptr;
+
+                SystemTask get_return_object() {
+                    return SystemTask(std::coroutine_handle<promise_type>::from_promise(*this));
+                }
+
+                // Started by System::spawn() only.
+                std::suspend_always initial_suspend() noexcept {
+                    return {};
+                }
+
+                // Destroyed by the System once finished.
+                std::suspend_always final_suspend() noexcept {
+                    return {};
+                }
+
+                void return_void() {}
+
+                // Rethrown by System::spawn() or by the processing of the
+                // System.
+                void unhandled_exception() {
+                    throw;
+                }
+            };
+
+            /// <summary>
+            /// Handle of the coroutine of a SystemTask.
+            /// </summary>
+            using Handle = std::coroutine_handle<promise_type>;
+
+            /// <summary>
+            /// Awaitable giving the CommandBuffer of the thread resuming the
+            /// coroutine, without suspending it.
+            /// </summary>
+            struct Commands {
+                /// <summary>
+                /// The CommandBuffer, once awaited.
+                /// </summary>
+                CommandBuffer* commands = nullptr;
+
+                bool await_ready() const noexcept {
+                    return false;
+                }
+
+                bool await_suspend(Handle task) noexcept {
+                    commands = task.promise().commands;
+                    return false;
+                }
+
+                CommandBuffer& await_resume() const noexcept {
+                    return *commands;
+                }
+            };
+
+        private:
+            /// <summary>
+            /// Coroutine of the SystemTask; nullptr once given to a System.
+            /// </summary>
+            Handle m_handle;
+
+        public:
+            /// <summary>
+            /// Create a new SystemTask instance from a moved one.
+            /// </summary>
+            /// <param name="other">Moved SystemTask.</param>
+            exported SystemTask(SystemTask&& other) noexcept
+                : m_handle(std::exchange(other.m_handle, nullptr)) {}
+
+            /// <summary>
+            /// Destruction of the SystemTask instance. The coroutine is
+            /// destroyed if it has not been given to a System.
+            /// </summary>
+            exported ~SystemTask() noexcept {
+                if (m_handle) {
+                    m_handle.destroy();
+                }
+            }
+
+            /// <summary>
+            /// Give up the ownership of the coroutine.
+            /// </summary>
+            /// <returns>Handle of the coroutine.</returns>
+            exported Handle release() {
+                return std::exchange(m_handle, nullptr);
+            }
+
+        private:
+            /// <summary>
+            /// Create a new SystemTask instance.
+            /// </summary>
+            /// <param name="handle">Coroutine of the SystemTask.</param>
+            explicit SystemTask(Handle handle)
+                : m_handle(handle) {}
+
+            // Disable copy.
+            SystemTask(const SystemTask& other) = delete;
+            SystemTask& operator=(const SystemTask& other) = delete;
+            SystemTask& operator=(SystemTask&& other) = delete;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -2,124 +2,141 @@
 #define __BANE_THREAD_JOB__
 
 #include <thread>
-#include <list>
-#include <unordered_map>
-#include <unordered_set>
+#include <deque>
+#include <mutex>
+#include <vector>
 #include <harmful/doom/utils/Platform.hpp>
-#include "harmful/bane/entities/Entity.hpp"
-#include "harmful/bane/systems/System.hpp"
-#include "harmful/bane/jobs/JobSynchronization.hpp"
+#include "harmful/bane/jobs/ThreadTask.hpp"
 
 namespace Bane {
+    class WorkerPool;
+
     /// <summary>
-    /// Encapsulates a thread and the related stuff for running Job processing
-    /// Systems itself.
+    /// Encapsulates a thread of a WorkerPool and its own queue of
+    /// ThreadTasks. The ThreadJob executes the ThreadTasks of its queue
+    /// first, then steals ThreadTasks from the other ThreadJobs of the pool
+    /// when it runs out of work.
     /// </summary>
     class ThreadJob final {
         private:
             /// <summary>
-            /// Structure for setting the indices of start and end for the
-            /// ThreadJob to process some of the Components in the list of
-            /// Components to process.
+            /// ThreadJob running on the current thread, if any.
             /// </summary>
-            struct FromToIndices {
-                size_t fromIndex;
-                size_t toIndex;
-            };
+            static thread_local ThreadJob* CurrentThreadJob;
 
             /// <summary>
-            /// Used to stop the ThreadJob when set to false.
-            /// true by default.
+            /// WorkerPool the ThreadJob belongs to.
             /// </summary>
-            bool m_continue{ true };
+            WorkerPool& m_pool;
 
             /// <summary>
-            /// The inner thread that will run the Job execution.
+            /// Index of the ThreadJob in its WorkerPool.
             /// </summary>
-            std::thread m_innerThread;
+            size_t m_index;
 
             /// <summary>
-            /// Set of data for synchronizing the current ThreadJob with others
-            /// in the complete Job.
+            /// The inner thread that will run the ThreadTasks.
             /// </summary>
-            JobSynchronizationRW m_syncData;
+            std::thread m_innerThread;
 
             /// <summary>
-            /// Systems that are processed by the ThreadJob.
+            /// Protects the queue of ThreadTasks. It is only held to push, pop
+            /// or steal a ThreadTask, never while executing it.
             /// </summary>
-            std::unordered_set<System*> m_systems;
+            std::mutex m_tasksMutex;
 
             /// <summary>
-            /// Indices of start and end for the ThreadJob to process some of
-            /// the Components in the list of Components to process by the
-            /// related System.
+            /// Queue of ThreadTasks. The owner pops from the back, thieves
+            /// steal from the front.
             /// </summary>
-            std::unordered_map<System*, FromToIndices> m_fromToComponents;
+            std::deque<ThreadTask> m_tasks;
 
             /// <summary>
-            /// List of Entity IDs to drop after the processing of the
-            /// Components by the current ThreadJob.
+            /// Logical cores the inner thread is pinned to; empty to leave it
+            /// to the operating system.
             /// </summary>
-            std::list<Entity> m_dropEntities;
+            std::vector<uint32_t> m_cores;
 
         public:
-             /// <summary>
-             /// Create a new ThreadJob instance.
-             /// </summary>
-             /// <param name="sync">
-             /// Data required to synchronize threads in Jobs.
-             /// </param>
-             exported ThreadJob(const JobSynchronizationRW& sync);
-
-            /**
-             * Add Systems to be processed by the ThreadJob.
-             * @param systems List of the Systems that will be processed by the
-             *                ThreadJob.
-             */
-
-             /// <summary>
-             /// Add Systems to be processed by the ThreadJob.
-             /// </summary>
-             /// <param name="systems">
-             /// List of the Systems that will be processed by the ThreadJob.
-             /// </param>
-             exported void setProcessedSystems(const std::vector<System*>& systems);
-
-             /// <summary>
-             /// Set the limits of Component execution of the thread for a
-             /// System.
-             /// </summary>
-             /// <param name="system">
-             /// System for which defining the limits.
-             /// </param>
-             /// <param name="fromIndex">
-             /// Start index in the list of Components.
-             /// </param>
-             /// <param name="toIndex">
-             /// End index in the list of Components.
-             /// </param>
-             exported void setFromToComponents(
-                System* system,
-                const size_t fromIndex,
-                const size_t toIndex
+            /// <summary>
+            /// Create a new ThreadJob instance.
+            /// </summary>
+            /// <param name="pool">WorkerPool the ThreadJob belongs to.</param>
+            /// <param name="index">Index of the ThreadJob in the pool.</param>
+            /// <param name="cores">
+            /// Logical cores to pin the inner thread to (see
+            /// Doom::CPUTopology); empty to leave it to the operating system.
+            /// </param>
+            exported ThreadJob(
+                WorkerPool& pool,
+                const size_t index,
+                const std::vector<uint32_t>& cores = {}
             );
 
-             /// <summary>
-             /// Start the ThreadJob.
-             /// </summary>
-             exported void start();
-
-             /// <summary>
-             /// Stop the ThreadJob as soon as possible.
-             /// </summary>
-             exported void stop();
-
-             /// <summary>
-             /// Get the ID of Entities to be removed.
-             /// </summary>
-             /// <returns>The list of ID of Entities to be removed.</returns>
-             exported std::list<Entity> dropEntities() const {
-                return m_dropEntities;
+            /// <summary>
+            /// Start the ThreadJob.
+            /// </summary>
+            exported void start();
+
+            /// <summary>
+            /// Wait for the inner thread to finish, once the WorkerPool is
+            /// stopped.
+            /// </summary>
+            exported void join();
+
+            /// <summary>
+            /// Add a ThreadTask to the queue of the ThreadJob.
+            /// </summary>
+            /// <param name="task">ThreadTask to add.</param>
+            exported void push(const ThreadTask& task);
+
+            /// <summary>
+            /// Take the most recently added ThreadTask of the queue.
+            /// </summary>
+            /// <param name="task">The taken ThreadTask.</param>
+            /// <returns>true if a ThreadTask was taken; false if empty.</returns>
+            exported bool pop(ThreadTask& task);
+
+            /// <summary>
+            /// Take the oldest ThreadTask of the queue, for another ThreadJob.
+            /// </summary>
+            /// <param name="task">The taken ThreadTask.</param>
+            /// <returns>true if a ThreadTask was taken; false if empty.</returns>
+            exported bool steal(ThreadTask& task);
+
+            /// <summary>
+            /// Execute a ThreadTask of the queue or stolen from the other
+            /// ThreadJobs of the pool, if any. Called on the inner thread
+            /// while it waits for other ThreadTasks, instead of blocking.
+            /// </summary>
+            /// <returns>true if a ThreadTask was executed; false otherwise.</returns>
+            exported bool help();
+
+            /// <summary>
+            /// Get the index of the ThreadJob in its WorkerPool.
+            /// </summary>
+            /// <returns>Index of the ThreadJob.</returns>
+            exported size_t index() const {
+                return m_index;
+            }
+
+            /// <summary>
+            /// Get the WorkerPool the ThreadJob belongs to.
+            /// </summary>
+            /// <returns>WorkerPool of the ThreadJob.</returns>
+            exported WorkerPool& pool() const {
+                return m_pool;
+            }
+
+            /// <summary>
+            /// Get the ThreadJob running on the current thread.
+            /// </summary>
+            /// <returns>
+            /// The ThreadJob of the current thread; nullptr if the current
+            /// thread does not belong to a WorkerPool.
+            /// </returns>
+            exported static ThreadJob* Current() {
+                return CurrentThreadJob;
             }
 
         private:
@@ -129,9 +146,16 @@ namespace Bane {
             void run();
 
             /// <summary>
-            /// Process the Systems in the Component index bounds.
+            /// Execute a ThreadTask and notify its group.
             /// </summary>
-            void processSystems();
+            /// <param name="task">ThreadTask to execute.</param>
+            void execute(const ThreadTask& task);
+
+            // Disable copy and move.
+            ThreadJob(const ThreadJob& other) = delete;
+            ThreadJob(ThreadJob&& other) = delete;
+            ThreadJob& operator=(const ThreadJob& other) = delete;
+            ThreadJob& operator=(ThreadJob&& other) = delete;
     };
 }
 
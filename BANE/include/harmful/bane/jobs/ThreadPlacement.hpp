@@ -0,0 +1,148 @@
+#ifndef __BANE_THREAD_PLACEMENT__
+#define __BANE_THREAD_PLACEMENT__
+
+#include <cstdint>
+#include <vector>
+#include <harmful/doom/utils/CPUTopology.hpp>
+#include <harmful/doom/utils/Platform.hpp>
+
+namespace Bane {
+    /// <summary>
+    /// Where the threads of a Job run on the processor.
+    /// </summary>
+    /// <remarks>
+    /// With any policy but None, the Components of the Systems of the Job are
+    /// first touched by its threads when their storage is allocated, so that
+    /// the operating system places the memory on their NUMA node. Give each
+    /// NUMA node its own Job (NumaNode policy) to avoid cross-node traffic.
+    /// </remarks>
+    class ThreadPlacement final {
+        public:
+            /// <summary>
+            /// How the threads are placed.
+            /// </summary>
+            enum class Policy : uint8_t {
+                /// <summary>
+                /// Left to the operating system.
+                /// </summary>
+                None,
+
+                /// <summary>
+                /// Each thread is pinned to a given logical core, in turn.
+                /// </summary>
+                Cores,
+
+                /// <summary>
+                /// Each thread is pinned to a logical core of a different
+                /// physical core, alternating packages. The SMT siblings are
+                /// only used once all the physical cores have a thread.
+                /// </summary>
+                SpreadPhysicalCores,
+
+                /// <summary>
+                /// Each thread is pinned to the first logical core of a
+                /// physical core, alternating packages: the SMT siblings are
+                /// never used, even with more threads than physical cores.
+                /// </summary>
+                AvoidSMT,
+
+                /// <summary>
+                /// The threads run on any logical core of a NUMA node.
+                /// </summary>
+                NumaNode
+            };
+
+        private:
+            /// <summary>
+            /// How the threads are placed.
+            /// </summary>
+            Policy m_policy = Policy::None;
+
+            /// <summary>
+            /// Logical cores of the Cores policy.
+            /// </summary>
+            std::vector<uint32_t> m_cores;
+
+            /// <summary>
+            /// Node of the NumaNode policy.
+            /// </summary>
+            uint32_t m_numaNode = 0;
+
+        public:
+            /// <summary>
+            /// Create a ThreadPlacement leaving the threads to the operating
+            /// system.
+            /// </summary>
+            exported ThreadPlacement() = default;
+
+            /// <summary>
+            /// Pin the threads to given logical cores: the thread i runs on
+            /// cores[i % cores.size()].
+            /// </summary>
+            /// <param name="cores">
+            /// Indices of the logical cores (see Doom::CPUTopology).
+            /// </param>
+            /// <returns>The ThreadPlacement.</returns>
+            exported static ThreadPlacement Cores(const std::vector<uint32_t>& cores);
+
+            /// <summary>
+            /// Spread the threads across the physical cores.
+            /// </summary>
+            /// <returns>The ThreadPlacement.</returns>
+            exported static ThreadPlacement SpreadPhysicalCores();
+
+            /// <summary>
+            /// Spread the threads across the physical cores, without using
+            /// their SMT siblings.
+            /// </summary>
+            /// <returns>The ThreadPlacement.</returns>
+            exported static ThreadPlacement AvoidSMT();
+
+            /// <summary>
+            /// Bind the threads to a NUMA node.
+            /// </summary>
+            /// <param name="node">Index of the NUMA node.</param>
+            /// <returns>The ThreadPlacement.</returns>
+            exported static ThreadPlacement NumaNode(const uint32_t node);
+
+            /// <summary>
+            /// Get how the threads are placed.
+            /// </summary>
+            /// <returns>Placement policy.</returns>
+            exported Policy policy() const {
+                return m_policy;
+            }
+
+            /// <summary>
+            /// Get the logical cores a thread may run on.
+            /// </summary>
+            /// <param name="threadIndex">Index of the thread in its Job.</param>
+            /// <param name="topology">Topology of the processor.</param>
+            /// <returns>
+            /// Indices of the logical cores; empty to leave the thread to the
+            /// operating system.
+            /// </returns>
+            exported std::vector<uint32_t> coresOf(
+                const size_t threadIndex,
+                const Doom::CPUTopology& topology
+            ) const;
+
+        private:
+            /// <summary>
+            /// Sort the logical cores so that consecutive threads get
+            /// different physical cores and alternate packages.
+            /// </summary>
+            /// <param name="topology">Topology of the processor.</param>
+            /// <param name="withSiblings">
+            /// false to only keep the first logical core of each physical
+            /// core.
+            /// </param>
+            /// <returns>Indices of the sorted logical cores.</returns>
+            static std::vector<uint32_t> SpreadOrder(
+                const Doom::CPUTopology& topology,
+                const bool withSiblings
+            );
+    };
+}
+
+#endif
\ No newline at end of file
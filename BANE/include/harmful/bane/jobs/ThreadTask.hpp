@@ -0,0 +1,113 @@
+#ifndef __BANE_THREAD_TASK__
+#define __BANE_THREAD_TASK__
+
+#include <harmful/doom/utils/Platform.hpp>
+#include <atomic>
+#include <cstddef>
+
+namespace Bane {
+    class ThreadJob;
+
+    /// <summary>
+    /// Counter of the ThreadTasks submitted together, to wait for their
+    /// completion.
+    /// </summary>
+    class TaskGroup final {
+        private:
+            /// <summary>
+            /// Amount of ThreadTasks of the group not finished yet.
+            /// </summary>
+            std::atomic<size_t> m_pending{ 0 };
+
+        public:
+            /// <summary>
+            /// Create a new TaskGroup instance.
+            /// </summary>
+            exported TaskGroup() = default;
+
+            /// <summary>
+            /// Add ThreadTasks to the group, before submitting them.
+            /// </summary>
+            /// <param name="amount">Amount of ThreadTasks to add.</param>
+            exported void add(const size_t amount) {
+                m_pending.fetch_add(amount, std::memory_order_relaxed);
+            }
+
+            /// <summary>
+            /// Notify that a ThreadTask of the group has finished.
+            /// </summary>
+            exported void done() {
+                if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    m_pending.notify_all();
+                }
+            }
+
+            /// <summary>
+            /// Check if all the ThreadTasks of the group have finished.
+            /// </summary>
+            /// <returns>true if finished; false otherwise.</returns>
+            exported bool isFinished() const {
+                return m_pending.load(std::memory_order_acquire) == 0;
+            }
+
+            /// <summary>
+            /// Wait until all the ThreadTasks of the group have finished.
+            /// </summary>
+            exported void wait() const {
+                size_t pending = m_pending.load(std::memory_order_acquire);
+
+                while (pending != 0) {
+                    m_pending.wait(pending, std::memory_order_acquire);
+                    pending = m_pending.load(std::memory_order_acquire);
+                }
+            }
+
+        private:
+            // Disable copy and move.
+            TaskGroup(const TaskGroup& other) = delete;
+            TaskGroup(TaskGroup&& other) = delete;
+            TaskGroup& operator=(const TaskGroup& other) = delete;
+            TaskGroup& operator=(TaskGroup&& other) = delete;
+    };
+
+    /// <summary>
+    /// Unit of work executed by a ThreadJob of a WorkerPool: a function
+    /// applied on a range of indices. It does not allocate memory, so that
+    /// many of them can be submitted at each frame.
+    /// </summary>
+    struct ThreadTask {
+        /// <summary>
+        /// Function executing a ThreadTask.
+        /// </summary>
+        /// <param name="worker">ThreadJob executing the ThreadTask.</param>
+        /// <param name="task">The ThreadTask to execute.</param>
+        using Function = void (*)(ThreadJob& worker, const ThreadTask& task);
+
+        /// <summary>
+        /// Function to execute.
+        /// </summary>
+        Function function = nullptr;
+
+        /// <summary>
+        /// Data used by the function (a System for example).
+        /// </summary>
+        void* context = nullptr;
+
+        /// <summary>
+        /// Start index of the range to process.
+        /// </summary>
+        size_t fromIndex = 0;
+
+        /// <summary>
+        /// End index (excluded) of the range to process.
+        /// </summary>
+        size_t toIndex = 0;
+
+        /// <summary>
+        /// Group notified when the ThreadTask has been executed, if any.
+        /// </summary>
+        TaskGroup* group = nullptr;
+    };
+}
+
+#endif
\ No newline at end of file
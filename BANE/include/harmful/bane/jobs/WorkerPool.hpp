@@ -0,0 +1,170 @@
+#ifndef __BANE_WORKER_POOL__
+#define __BANE_WORKER_POOL__
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+#include <harmful/doom/utils/Platform.hpp>
+#include "harmful/bane/jobs/ThreadJob.hpp"
+#include "harmful/bane/jobs/ThreadPlacement.hpp"
+#include "harmful/bane/jobs/ThreadTask.hpp"
+
+namespace Bane {
+    /// <summary>
+    /// Pool of ThreadJobs executing ThreadTasks with work stealing: each
+    /// ThreadJob has its own queue, and idle ThreadJobs steal ThreadTasks
+    /// from the loaded ones. No lock is held while a ThreadTask is executed.
+    /// </summary>
+    class WorkerPool final {
+        friend class ThreadJob;
+
+        private:
+            /// <summary>
+            /// Threads of the pool.
+            /// </summary>
+            std::vector<std::unique_ptr<ThreadJob>> m_workers;
+
+            /// <summary>
+            /// false once the pool is stopped.
+            /// </summary>
+            std::atomic<bool> m_running{ true };
+
+            /// <summary>
+            /// Amount of ThreadTasks submitted and not taken yet by a
+            /// ThreadJob.
+            /// </summary>
+            std::atomic<size_t> m_pendingTasks{ 0 };
+
+            /// <summary>
+            /// Index of the ThreadJob receiving the next ThreadTask submitted
+            /// from outside of the pool.
+            /// </summary>
+            std::atomic<size_t> m_nextWorker{ 0 };
+
+            /// <summary>
+            /// Mutex used to make the idle ThreadJobs sleep.
+            /// </summary>
+            std::mutex m_sleepMutex;
+
+            /// <summary>
+            /// Condition to wake up the idle ThreadJobs.
+            /// </summary>
+            std::condition_variable m_wakeUp;
+
+        public:
+            /// <summary>
+            /// Create a new WorkerPool instance and start its threads.
+            /// </summary>
+            /// <param name="threadCount">Amount of threads in the pool.</param>
+            /// <param name="placement">Where the threads run.</param>
+            exported WorkerPool(
+                const uint8_t threadCount,
+                const ThreadPlacement& placement = ThreadPlacement()
+            );
+
+            /// <summary>
+            /// Destruction of the WorkerPool instance. The threads are
+            /// stopped.
+            /// </summary>
+            exported ~WorkerPool() noexcept;
+
+            /// <summary>
+            /// Submit a ThreadTask to the pool. When submitted from a
+            /// ThreadJob of the pool, the ThreadTask goes to its own queue.
+            /// </summary>
+            /// <param name="task">ThreadTask to execute.</param>
+            exported void submit(const ThreadTask& task);
+
+            /// <summary>
+            /// Submit several ThreadTasks to the pool. They are spread over
+            /// the queues of the ThreadJobs.
+            /// </summary>
+            /// <param name="tasks">ThreadTasks to execute.</param>
+            exported void submit(std::span<const ThreadTask> tasks);
+
+            /// <summary>
+            /// Wait until all the ThreadTasks of a group have finished. On a
+            /// ThreadJob of the pool, the ThreadTasks of the pool are executed
+            /// meanwhile, so that a ThreadTask can wait for the ones it
+            /// submitted without starving the pool.
+            /// </summary>
+            /// <param name="group">Group of the awaited ThreadTasks.</param>
+            exported void wait(const TaskGroup& group);
+
+            /// <summary>
+            /// Stop the threads of the pool as soon as possible. The
+            /// ThreadTasks not started yet are not executed.
+            /// </summary>
+            exported void stop();
+
+            /// <summary>
+            /// Check if the pool is running.
+            /// </summary>
+            /// <returns>true if running; false once stopped.</returns>
+            exported bool isRunning() const {
+                return m_running.load(std::memory_order_acquire);
+            }
+
+            /// <summary>
+            /// Get the amount of threads in the pool.
+            /// </summary>
+            /// <returns>Amount of threads.</returns>
+            exported size_t size() const {
+                return m_workers.size();
+            }
+
+            /// <summary>
+            /// Get a ThreadJob of the pool.
+            /// </summary>
+            /// <param name="index">Index of the ThreadJob.</param>
+            /// <returns>The ThreadJob at the given index.</returns>
+            exported ThreadJob& worker(const size_t index) {
+                return *m_workers[index];
+            }
+
+        private:
+            /// <summary>
+            /// Steal a ThreadTask from the other ThreadJobs of the pool.
+            /// </summary>
+            /// <param name="thief">ThreadJob looking for work.</param>
+            /// <param name="task">The stolen ThreadTask.</param>
+            /// <returns>true if a ThreadTask was stolen; false otherwise.</returns>
+            bool steal(ThreadJob& thief, ThreadTask& task);
+
+            /// <summary>
+            /// Make the calling ThreadJob sleep until ThreadTasks are
+            /// submitted or the pool is stopped.
+            /// </summary>
+            void sleep();
+
+            /// <summary>
+            /// Notify that a ThreadJob took a submitted ThreadTask.
+            /// </summary>
+            void onTaskTaken() {
+                m_pendingTasks.fetch_sub(1, std::memory_order_acq_rel);
+            }
+
+            /// <summary>
+            /// Get the ThreadJob receiving a ThreadTask submitted from the
+            /// current thread.
+            /// </summary>
+            /// <returns>The receiving ThreadJob.</returns>
+            ThreadJob& receiver();
+
+            /// <summary>
+            /// Wake up the sleeping ThreadJobs.
+            /// </summary>
+            void wakeUp();
+
+            // Disable copy and move.
+            WorkerPool(const WorkerPool& other) = delete;
+            WorkerPool(WorkerPool&& other) = delete;
+            WorkerPool& operator=(const WorkerPool& other) = delete;
+            WorkerPool& operator=(WorkerPool&& other) = delete;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,318 @@
+#ifndef __BANE_LOOSE_OCTREE__
+#define __BANE_LOOSE_OCTREE__
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+#include <harmful/doom/utils/Platform.hpp>
+#include "harmful/bane/spatial/SpatialIndex.hpp"
+
+namespace Bane {
+    /// <summary>
+    /// SpatialIndex splitting a bounded space into a loose octree: each node
+    /// covers twice the size of its cell, so that an Entity is stored in the
+    /// deepest node whose cell contains its position and that is at least
+    /// twice as large as the Entity. An Entity never spans several nodes.
+    /// </summary>
+    /// <remarks>
+    /// Suited to Entities of very different sizes or spread unevenly. The
+    /// Entities out of the bounds of the octree are kept in its root.
+    /// </remarks>
+    class LooseOctree final : public SpatialIndex {
+        private:
+            /// <summary>
+            /// Index used to tell that a node has no children, or that an
+            /// Entity is not in the octree.
+            /// </summary>
+            static constexpr uint32_t NoNode = std::numeric_limits<uint32_t>::max();
+
+            /// <summary>
+            /// Node of the octree.
+            /// </summary>
+            struct Node {
+                /// <summary>
+                /// Center of the cell of the node.
+                /// </summary>
+                std::array<float, 3> center;
+
+                /// <summary>
+                /// Half of the side of the cell of the node. The node covers
+                /// twice this distance around its center.
+                /// </summary>
+                float halfSize;
+
+                /// <summary>
+                /// Depth of the node, 0 for the root.
+                /// </summary>
+                uint32_t depth;
+
+                /// <summary>
+                /// Index of the parent; NoNode for the root.
+                /// </summary>
+                uint32_t parent = NoNode;
+
+                /// <summary>
+                /// Index of the first of the eight children, which are
+                /// contiguous; NoNode for a leaf.
+                /// </summary>
+                uint32_t firstChild = NoNode;
+
+                /// <summary>
+                /// Amount of Entities in the node and its descendants, so that
+                /// the queries skip the empty branches.
+                /// </summary>
+                uint32_t amountEntries = 0;
+
+                /// <summary>
+                /// Entities stored in the node.
+                /// </summary>
+                std::vector<Entry> entries;
+            };
+
+            /// <summary>
+            /// Where an Entity is stored.
+            /// </summary>
+            struct Location {
+                /// <summary>
+                /// Index of the node; NoNode if not in the octree.
+                /// </summary>
+                uint32_t node = NoNode;
+
+                /// <summary>
+                /// Index of the Entity in the node.
+                /// </summary>
+                uint32_t index = 0;
+            };
+
+            /// <summary>
+            /// Maximal depth of the nodes.
+            /// </summary>
+            uint32_t m_maxDepth;
+
+            /// <summary>
+            /// Nodes of the octree, the root first.
+            /// </summary>
+            std::vector<Node> m_nodes;
+
+            /// <summary>
+            /// Location of each Entity, by Entity index.
+            /// </summary>
+            std::vector<Location> m_locations;
+
+            /// <summary>
+            /// Amount of Entities in the octree.
+            /// </summary>
+            size_t m_size = 0;
+
+            /// <summary>
+            /// Entries leaving their node during an update(). Kept from an
+            /// update to another.
+            /// </summary>
+            std::vector<Entry> m_moves;
+
+        public:
+            /// <summary>
+            /// Create a new LooseOctree instance.
+            /// </summary>
+            /// <param name="center">Center of the bounds of the octree.</param>
+            /// <param name="halfSize">
+            /// Half of the side of the bounds of the octree.
+            /// </param>
+            /// <param name="maxDepth">Maximal depth of the nodes.</param>
+            /// <exception cref="std::runtime_error">
+            /// The size is not strictly positive.
+            /// </exception>
+            exported LooseOctree(
+                const Mind::Point3Df& center,
+                const float halfSize,
+                const uint32_t maxDepth = 8
+            );
+
+            /// <summary>
+            /// Insert Entities in the octree, or move the ones already in it.
+            /// The Entities leaving their node are all removed before being
+            /// inserted again.
+            /// </summary>
+            /// <param name="entries">
+            /// New positions of the Entities. Each Entity must appear once.
+            /// </param>
+            exported void update(std::span<const Entry> entries) override;
+
+            /// <summary>
+            /// Remove an Entity from the octree, if in it.
+            /// </summary>
+            /// <param name="id">ID of the Entity.</param>
+            exported void remove(const id_t id) override;
+
+            /// <summary>
+            /// Remove all the Entities and nodes from the octree.
+            /// </summary>
+            exported void clear() override;
+
+            /// <summary>
+            /// Get the amount of Entities in the octree.
+            /// </summary>
+            /// <returns>Amount of Entities.</returns>
+            exported size_t size() const override {
+                return m_size;
+            }
+
+            /// <summary>
+            /// Get the amount of nodes of the octree.
+            /// </summary>
+            /// <returns>Amount of nodes, at least 1.</returns>
+            exported size_t amountNodes() const {
+                return m_nodes.size();
+            }
+
+            /// <summary>
+            /// Find the Entities whose sphere intersects an axis-aligned box.
+            /// </summary>
+            /// <param name="minimum">Minimal corner of the box.</param>
+            /// <param name="maximum">Maximal corner of the box.</param>
+            /// <param name="results">
+            /// List receiving the IDs of the Entities, in no particular order.
+            /// </param>
+            exported void queryBox(
+                const Mind::Point3Df& minimum,
+                const Mind::Point3Df& maximum,
+                std::vector<id_t>& results
+            ) const override;
+
+            /// <summary>
+            /// Find the Entities whose sphere intersects another sphere.
+            /// </summary>
+            /// <param name="center">Center of the sphere.</param>
+            /// <param name="radius">Radius of the sphere.</param>
+            /// <param name="results">
+            /// List receiving the IDs of the Entities, in no particular order.
+            /// </param>
+            exported void querySphere(
+                const Mind::Point3Df& center,
+                const float radius,
+                std::vector<id_t>& results
+            ) const override;
+
+            /// <summary>
+            /// Find the Entities whose position is the nearest to a point.
+            /// The nodes are visited from the nearest one.
+            /// </summary>
+            /// <param name="point">Point of the query.</param>
+            /// <param name="amount">Maximal amount of Entities to find.</param>
+            /// <param name="results">
+            /// List receiving the IDs of the Entities, from the nearest.
+            /// </param>
+            exported void nearest(
+                const Mind::Point3Df& point,
+                const size_t amount,
+                std::vector<id_t>& results
+            ) const override;
+
+        private:
+            /// <summary>
+            /// Check if an Entry can stay in a node.
+            /// </summary>
+            /// <param name="node">The node.</param>
+            /// <param name="entry">Entry to be checked.</param>
+            /// <returns>true if the node can hold the Entry.</returns>
+            bool fits(const Node& node, const Entry& entry) const;
+
+            /// <summary>
+            /// Insert an Entry in the deepest node that can hold it, creating
+            /// the nodes on the way.
+            /// </summary>
+            /// <param name="entry">Entry to insert.</param>
+            void insert(const Entry& entry);
+
+            /// <summary>
+            /// Remove an Entry from its node.
+            /// </summary>
+            /// <param name="location">Location of the Entry.</param>
+            void detach(Location& location);
+
+            /// <summary>
+            /// Get the bounds covered by a node and its descendants.
+            /// </summary>
+            /// <param name="node">The node.</param>
+            /// <param name="minimum">Minimal corner of the bounds.</param>
+            /// <param name="maximum">Maximal corner of the bounds.</param>
+            void boundsOf(
+                const Node& node,
+                std::array<float, 3>& minimum,
+                std::array<float, 3>& maximum
+            ) const;
+
+            /// <summary>
+            /// Call a function on the Entries of each node whose bounds
+            /// intersect a box.
+            /// </summary>
+            /// <param name="minimum">Minimal corner of the box.</param>
+            /// <param name="maximum">Maximal corner of the box.</param>
+            /// <param name="function">
+            /// Function called with the Entries of each node.
+            /// </param>
+            template <class Function>
+            void forEachNode(
+                const std::array<float, 3>& minimum,
+                const std::array<float, 3>& maximum,
+                Function function
+            ) const {
+                std::array<uint32_t, 64> pending;
+                std::vector<uint32_t> overflow;
+                size_t amountPending = 0;
+                pending[amountPending++] = 0;
+
+                while ((amountPending > 0) || !overflow.empty()) {
+                    uint32_t nodeIndex;
+
+                    if (!overflow.empty()) {
+                        nodeIndex = overflow.back();
+                        overflow.pop_back();
+                    }
+                    else {
+                        nodeIndex = pending[--amountPending];
+                    }
+
+                    auto& node = m_nodes[nodeIndex];
+                    function(node.entries);
+
+                    if (node.firstChild == NoNode) {
+                        continue;
+                    }
+
+                    for (uint32_t child = node.firstChild; child < node.firstChild + 8; child++) {
+                        if (m_nodes[child].amountEntries == 0) {
+                            continue;
+                        }
+
+                        std::array<float, 3> childMinimum;
+                        std::array<float, 3> childMaximum;
+                        boundsOf(m_nodes[child], childMinimum, childMaximum);
+
+                        bool isOverlapping = true;
+
+                        for (size_t axis = 0; axis < 3; axis++) {
+                            isOverlapping = isOverlapping
+                                && (childMinimum[axis] <= maximum[axis])
+                                && (childMaximum[axis] >= minimum[axis]);
+                        }
+
+                        if (!isOverlapping) {
+                            continue;
+                        }
+
+                        if (amountPending < pending.size()) {
+                            pending[amountPending++] = child;
+                        }
+                        else {
+                            overflow.push_back(child);
+                        }
+                    }
+                }
+            }
+    };
+}
+
+#endif
\ No newline at end of file
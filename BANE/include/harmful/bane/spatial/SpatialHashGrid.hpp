@@ -0,0 +1,248 @@
+#ifndef __BANE_SPATIAL_HASH_GRID__
+#define __BANE_SPATIAL_HASH_GRID__
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <harmful/doom/utils/Platform.hpp>
+#include "harmful/bane/spatial/SpatialIndex.hpp"
+
+namespace Bane {
+    /// <summary>
+    /// SpatialIndex splitting the space into cubic cells of the same size,
+    /// stored in a hash map so that the space is not bounded. Each Entity is
+    /// in the cell of its position; the queries are extended by the largest
+    /// radius in the grid.
+    /// </summary>
+    /// <remarks>
+    /// Suited to many Entities of similar sizes moving a lot: moving inside a
+    /// cell is a single write, and the entries of a cell are contiguous. The
+    /// cells should be about the size of the usual queries.
+    /// </remarks>
+    class SpatialHashGrid final : public SpatialIndex {
+        private:
+            /// <summary>
+            /// Where an Entity is stored.
+            /// </summary>
+            struct Location {
+                /// <summary>
+                /// Key of the cell.
+                /// </summary>
+                uint64_t key = 0;
+
+                /// <summary>
+                /// Entries of the cell, which do not move while the cell
+                /// exists; nullptr if the Entity is not in the grid.
+                /// </summary>
+                std::vector<Entry>* cell = nullptr;
+
+                /// <summary>
+                /// Index of the Entity in its cell.
+                /// </summary>
+                uint32_t index = 0;
+            };
+
+            /// <summary>
+            /// Amount of bits of a cell coordinate in a cell key.
+            /// </summary>
+            static constexpr uint32_t CoordinateBits = 21;
+
+            /// <summary>
+            /// Size of the side of a cell.
+            /// </summary>
+            float m_cellSize;
+
+            /// <summary>
+            /// Entries of each non-empty cell, by cell key.
+            /// </summary>
+            std::unordered_map<uint64_t, std::vector<Entry>> m_cells;
+
+            /// <summary>
+            /// Location of each Entity, by Entity index.
+            /// </summary>
+            std::vector<Location> m_locations;
+
+            /// <summary>
+            /// Amount of Entities in the grid.
+            /// </summary>
+            size_t m_size = 0;
+
+            /// <summary>
+            /// Largest radius of the Entities inserted since the last
+            /// clear().
+            /// </summary>
+            float m_maxRadius = 0.f;
+
+            /// <summary>
+            /// Entries changing of cell during an update(), with the key of
+            /// their new cell. Kept from an update to another.
+            /// </summary>
+            std::vector<std::pair<uint64_t, Entry>> m_moves;
+
+        public:
+            /// <summary>
+            /// Create a new SpatialHashGrid instance.
+            /// </summary>
+            /// <param name="cellSize">Size of the side of a cell.</param>
+            /// <exception cref="std::runtime_error">
+            /// The size is not strictly positive.
+            /// </exception>
+            exported SpatialHashGrid(const float cellSize);
+
+            /// <summary>
+            /// Insert Entities in the grid, or move the ones already in it.
+            /// Those changing of cell are moved together, cell by cell.
+            /// </summary>
+            /// <param name="entries">
+            /// New positions of the Entities. Each Entity must appear once.
+            /// </param>
+            exported void update(std::span<const Entry> entries) override;
+
+            /// <summary>
+            /// Remove an Entity from the grid, if in it.
+            /// </summary>
+            /// <param name="id">ID of the Entity.</param>
+            exported void remove(const id_t id) override;
+
+            /// <summary>
+            /// Remove all the Entities from the grid.
+            /// </summary>
+            exported void clear() override;
+
+            /// <summary>
+            /// Get the amount of Entities in the grid.
+            /// </summary>
+            /// <returns>Amount of Entities.</returns>
+            exported size_t size() const override {
+                return m_size;
+            }
+
+            /// <summary>
+            /// Get the size of the side of a cell.
+            /// </summary>
+            /// <returns>Size of a cell.</returns>
+            exported float cellSize() const {
+                return m_cellSize;
+            }
+
+            /// <summary>
+            /// Find the Entities whose sphere intersects an axis-aligned box.
+            /// </summary>
+            /// <param name="minimum">Minimal corner of the box.</param>
+            /// <param name="maximum">Maximal corner of the box.</param>
+            /// <param name="results">
+            /// List receiving the IDs of the Entities, in no particular order.
+            /// </param>
+            exported void queryBox(
+                const Mind::Point3Df& minimum,
+                const Mind::Point3Df& maximum,
+                std::vector<id_t>& results
+            ) const override;
+
+            /// <summary>
+            /// Find the Entities whose sphere intersects another sphere.
+            /// </summary>
+            /// <param name="center">Center of the sphere.</param>
+            /// <param name="radius">Radius of the sphere.</param>
+            /// <param name="results">
+            /// List receiving the IDs of the Entities, in no particular order.
+            /// </param>
+            exported void querySphere(
+                const Mind::Point3Df& center,
+                const float radius,
+                std::vector<id_t>& results
+            ) const override;
+
+            /// <summary>
+            /// Find the Entities whose position is the nearest to a point.
+            /// The cells are visited ring by ring around the point.
+            /// </summary>
+            /// <param name="point">Point of the query.</param>
+            /// <param name="amount">Maximal amount of Entities to find.</param>
+            /// <param name="results">
+            /// List receiving the IDs of the Entities, from the nearest.
+            /// </param>
+            exported void nearest(
+                const Mind::Point3Df& point,
+                const size_t amount,
+                std::vector<id_t>& results
+            ) const override;
+
+        private:
+            /// <summary>
+            /// Get the coordinates of the cell containing a position.
+            /// </summary>
+            /// <param name="position">The position.</param>
+            /// <returns>Coordinates of the cell.</returns>
+            std::array<int32_t, 3> cellOf(const std::array<float, 3>& position) const;
+
+            /// <summary>
+            /// Get the key of a cell.
+            /// </summary>
+            /// <param name="cell">Coordinates of the cell.</param>
+            /// <returns>Key of the cell.</returns>
+            static uint64_t KeyOf(const std::array<int32_t, 3>& cell);
+
+            /// <summary>
+            /// Add an Entry at the back of a cell.
+            /// </summary>
+            /// <param name="cell">Entries of the cell.</param>
+            /// <param name="key">Key of the cell.</param>
+            /// <param name="entry">Entry to add.</param>
+            void append(std::vector<Entry>& cell, const uint64_t key, const Entry& entry);
+
+            /// <summary>
+            /// Remove an Entry from its cell, the cell being removed once
+            /// empty.
+            /// </summary>
+            /// <param name="location">Location of the Entry.</param>
+            void detach(Location& location);
+
+            /// <summary>
+            /// Call a function on each non-empty cell of a range of
+            /// coordinates, or on each cell if there are fewer of them.
+            /// </summary>
+            /// <param name="minimum">Minimal cell coordinates.</param>
+            /// <param name="maximum">Maximal cell coordinates.</param>
+            /// <param name="function">
+            /// Function called with the entries of each cell.
+            /// </param>
+            template <class Function>
+            void forEachCell(
+                const std::array<int32_t, 3>& minimum,
+                const std::array<int32_t, 3>& maximum,
+                Function function
+            ) const {
+                double volume = 1.;
+
+                for (size_t axis = 0; axis < 3; axis++) {
+                    volume *= static_cast<double>(maximum[axis]) - static_cast<double>(minimum[axis]) + 1.;
+                }
+
+                if (volume > static_cast<double>(m_cells.size())) {
+                    for (auto& [key, cell] : m_cells) {
+                        function(cell);
+                    }
+
+                    return;
+                }
+
+                for (int32_t x = minimum[0]; x <= maximum[0]; x++) {
+                    for (int32_t y = minimum[1]; y <= maximum[1]; y++) {
+                        for (int32_t z = minimum[2]; z <= maximum[2]; z++) {
+                            auto found = m_cells.find(KeyOf({ x, y, z }));
+
+                            if (found != m_cells.end()) {
+                                function(found -> second);
+                            }
+                        }
+                    }
+                }
+            }
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,232 @@
+#ifndef __BANE_SPATIAL_INDEX__
+#define __BANE_SPATIAL_INDEX__
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+#include <harmful/doom/utils/Platform.hpp>
+#include <harmful/mind/geometry/points/Point3Df.hpp>
+#include "harmful/bane/entities/Entity.hpp"
+
+namespace Bane {
+    /// <summary>
+    /// Index of the positions of Entities, answering proximity queries
+    /// without scanning all of them. Each Entity is a sphere: a position and
+    /// a radius (0 for a point).
+    /// </summary>
+    /// <remarks>
+    /// The queries do not modify the index: they can be called from several
+    /// threads at the same time, as long as the index is not updated
+    /// meanwhile.
+    /// </remarks>
+    class SpatialIndex {
+        public:
+            /// <summary>
+            /// Position of an Entity in the index.
+            /// </summary>
+            struct Entry {
+                /// <summary>
+                /// ID of the Entity.
+                /// </summary>
+                id_t id;
+
+                /// <summary>
+                /// Position of the center of the sphere.
+                /// </summary>
+                std::array<float, 3> position;
+
+                /// <summary>
+                /// Radius of the sphere.
+                /// </summary>
+                float radius;
+            };
+
+            /// <summary>
+            /// Destruction of the SpatialIndex instance.
+            /// </summary>
+            exported virtual ~SpatialIndex() noexcept = default;
+
+            /// <summary>
+            /// Insert Entities in the index, or move the ones already in it.
+            /// The Entities staying in the same place of the index are only
+            /// updated.
+            /// </summary>
+            /// <param name="entries">
+            /// New positions of the Entities. Each Entity must appear once.
+            /// </param>
+            exported virtual void update(std::span<const Entry> entries) = 0;
+
+            /// <summary>
+            /// Remove an Entity from the index, if in it.
+            /// </summary>
+            /// <param name="id">ID of the Entity.</param>
+            exported virtual void remove(const id_t id) = 0;
+
+            /// <summary>
+            /// Remove all the Entities from the index.
+            /// </summary>
+            exported virtual void clear() = 0;
+
+            /// <summary>
+            /// Get the amount of Entities in the index.
+            /// </summary>
+            /// <returns>Amount of Entities.</returns>
+            exported virtual size_t size() const = 0;
+
+            /// <summary>
+            /// Find the Entities whose sphere intersects an axis-aligned box.
+            /// </summary>
+            /// <param name="minimum">Minimal corner of the box.</param>
+            /// <param name="maximum">Maximal corner of the box.</param>
+            /// <param name="results">
+            /// List receiving the IDs of the Entities, in no particular order.
+            /// </param>
+            exported virtual void queryBox(
+                const Mind::Point3Df& minimum,
+                const Mind::Point3Df& maximum,
+                std::vector<id_t>& results
+            ) const = 0;
+
+            /// <summary>
+            /// Find the Entities whose sphere intersects another sphere.
+            /// </summary>
+            /// <param name="center">Center of the sphere.</param>
+            /// <param name="radius">Radius of the sphere.</param>
+            /// <param name="results">
+            /// List receiving the IDs of the Entities, in no particular order.
+            /// </param>
+            exported virtual void querySphere(
+                const Mind::Point3Df& center,
+                const float radius,
+                std::vector<id_t>& results
+            ) const = 0;
+
+            /// <summary>
+            /// Find the Entities whose position is the nearest to a point.
+            /// </summary>
+            /// <param name="point">Point of the query.</param>
+            /// <param name="amount">Maximal amount of Entities to find.</param>
+            /// <param name="results">
+            /// List receiving the IDs of the Entities, from the nearest.
+            /// </param>
+            exported virtual void nearest(
+                const Mind::Point3Df& point,
+                const size_t amount,
+                std::vector<id_t>& results
+            ) const = 0;
+
+        protected:
+            /// <summary>
+            /// A candidate of a nearest query.
+            /// </summary>
+            struct Neighbour {
+                /// <summary>
+                /// Squared distance to the point of the query.
+                /// </summary>
+                float distance;
+
+                /// <summary>
+                /// ID of the Entity.
+                /// </summary>
+                id_t id;
+
+                /// <summary>
+                /// Order of the candidates by distance, then by ID so that
+                /// the results do not depend on the storage order.
+                /// </summary>
+                bool operator<(const Neighbour& other) const {
+                    return (distance < other.distance)
+                        || ((distance == other.distance) && (id < other.id));
+                }
+            };
+
+            /// <summary>
+            /// Convert a point to an array of coordinates.
+            /// </summary>
+            /// <param name="point">Point to convert.</param>
+            /// <returns>Coordinates of the point.</returns>
+            static std::array<float, 3> Coordinates(const Mind::Point3Df& point) {
+                return { point[0], point[1], point[2] };
+            }
+
+            /// <summary>
+            /// Check if the sphere of an Entry intersects a box.
+            /// </summary>
+            /// <param name="entry">Entry to be checked.</param>
+            /// <param name="minimum">Minimal corner of the box.</param>
+            /// <param name="maximum">Maximal corner of the box.</param>
+            /// <returns>true if they intersect; false otherwise.</returns>
+            static bool Intersects(
+                const Entry& entry,
+                const std::array<float, 3>& minimum,
+                const std::array<float, 3>& maximum
+            ) {
+                return DistanceToBox(entry.position, minimum, maximum) <= (entry.radius * entry.radius);
+            }
+
+            /// <summary>
+            /// Check if the sphere of an Entry intersects another sphere.
+            /// </summary>
+            /// <param name="entry">Entry to be checked.</param>
+            /// <param name="center">Center of the other sphere.</param>
+            /// <param name="radius">Radius of the other sphere.</param>
+            /// <returns>true if they intersect; false otherwise.</returns>
+            static bool Intersects(
+                const Entry& entry,
+                const std::array<float, 3>& center,
+                const float radius
+            ) {
+                float reach = entry.radius + radius;
+                return Distance(entry.position, center) <= (reach * reach);
+            }
+
+            /// <summary>
+            /// Get the squared distance between two points.
+            /// </summary>
+            /// <param name="first">First point.</param>
+            /// <param name="second">Second point.</param>
+            /// <returns>Squared distance.</returns>
+            static float Distance(
+                const std::array<float, 3>& first,
+                const std::array<float, 3>& second
+            ) {
+                float x = first[0] - second[0];
+                float y = first[1] - second[1];
+                float z = first[2] - second[2];
+                return (x * x) + (y * y) + (z * z);
+            }
+
+            /// <summary>
+            /// Get the squared distance between a point and a box.
+            /// </summary>
+            /// <param name="point">The point.</param>
+            /// <param name="minimum">Minimal corner of the box.</param>
+            /// <param name="maximum">Maximal corner of the box.</param>
+            /// <returns>Squared distance; 0 if the point is in the box.</returns>
+            static float DistanceToBox(
+                const std::array<float, 3>& point,
+                const std::array<float, 3>& minimum,
+                const std::array<float, 3>& maximum
+            ) {
+                float distance = 0.f;
+
+                for (size_t axis = 0; axis < 3; axis++) {
+                    float outside = 0.f;
+
+                    if (point[axis] < minimum[axis]) {
+                        outside = minimum[axis] - point[axis];
+                    }
+                    else if (point[axis] > maximum[axis]) {
+                        outside = point[axis] - maximum[axis];
+                    }
+
+                    distance += outside * outside;
+                }
+
+                return distance;
+            }
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,38 @@
+#ifndef __BANE_SPATIAL_PROXY__
+#define __BANE_SPATIAL_PROXY__
+
+#include <array>
+#include <harmful/doom/utils/Platform.hpp>
+#include "harmful/bane/components/ComponentData.hpp"
+
+namespace Bane {
+    /// <summary>
+    /// Position and size of an Entity in the SpatialIndex of a SpatialSystem.
+    /// </summary>
+    /// <remarks>
+    /// The position is copied from the Transform of the Entity when the
+    /// SpatialSystem tracks a TransformSystem; otherwise it is changed with
+    /// ComponentColumn::write() so that the change is detected.
+    /// </remarks>
+    struct SpatialProxy : public ComponentData {
+        /// <summary>
+        /// Position of the Entity.
+        /// </summary>
+        std::array<float, 3> position { 0.f, 0.f, 0.f };
+
+        /// <summary>
+        /// Radius of the sphere bounding the Entity; 0 for a point.
+        /// </summary>
+        float radius = 0.f;
+
+        /// <summary>
+        /// An Entity has a single SpatialProxy.
+        /// </summary>
+        /// <returns>Quantity::One.</returns>
+        static Quantity AllowedQuantity() {
+            return Quantity::One;
+        }
+    };
+}
+
+#endif
\ No newline at end of file
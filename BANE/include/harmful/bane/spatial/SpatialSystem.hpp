@@ -0,0 +1,133 @@
+#ifndef __BANE_SPATIAL_SYSTEM__
+#define __BANE_SPATIAL_SYSTEM__
+
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+#include <harmful/doom/utils/Platform.hpp>
+#include "harmful/bane/spatial/SpatialIndex.hpp"
+#include "harmful/bane/spatial/SpatialProxy.hpp"
+#include "harmful/bane/systems/System.hpp"
+#include "harmful/bane/transforms/TransformSystem.hpp"
+
+namespace Bane {
+    /// <summary>
+    /// System keeping a SpatialIndex in sync with the SpatialProxies of the
+    /// Entities, for proximity queries without scanning all of them.
+    /// </summary>
+    /// <remarks>
+    /// At each run, the SpatialProxies added or changed since the last run
+    /// are given to the index in a single batch. When a TransformSystem is
+    /// tracked, the SpatialProxies of the Entities whose world matrix has
+    /// changed take their new position first.
+    ///
+    /// The queries on index() can be run by several threads at the same
+    /// time: the Systems running them declare that they read the
+    /// SpatialProxies (see System::reads()), so that they do not run while
+    /// the index is updated.
+    /// </remarks>
+    class SpatialSystem : public System {
+        private:
+            /// <summary>
+            /// Processing of a SpatialSystem.
+            /// </summary>
+            class Processing;
+
+            /// <summary>
+            /// Size of the cells of the default index.
+            /// </summary>
+            static constexpr float DefaultCellSize = 8.f;
+
+            /// <summary>
+            /// Index of the positions.
+            /// </summary>
+            std::unique_ptr<SpatialIndex> m_index;
+
+            /// <summary>
+            /// TransformSystem giving the positions; nullptr if none.
+            /// </summary>
+            const TransformSystem* m_transforms = nullptr;
+
+            /// <summary>
+            /// Entries given to the index at the current run. Kept from a run
+            /// to another.
+            /// </summary>
+            std::vector<SpatialIndex::Entry> m_changes;
+
+            /// <summary>
+            /// true if all the SpatialProxies must be given to the index at
+            /// the next run.
+            /// </summary>
+            bool m_isIndexDirty = false;
+
+        public:
+            /// <summary>
+            /// Create a new SpatialSystem instance, indexing the positions in
+            /// a SpatialHashGrid.
+            /// </summary>
+            /// <param name="name">Name of the System.</param>
+            exported SpatialSystem(const std::string& name);
+
+            /// <summary>
+            /// Replace the index of the positions, filled with all the
+            /// SpatialProxies at the next run. Must not be called while the
+            /// SpatialSystem is processed.
+            /// </summary>
+            /// <param name="index">New index, empty.</param>
+            /// <exception cref="std::runtime_error">The index is null.</exception>
+            exported void setIndex(std::unique_ptr<SpatialIndex> index);
+
+            /// <summary>
+            /// Take the positions from the world matrices of a TransformSystem.
+            /// The SpatialSystem then reads the Transforms, so it runs after
+            /// the TransformSystem if registered after it.
+            /// </summary>
+            /// <param name="transforms">TransformSystem giving the positions.</param>
+            exported void track(TransformSystem* transforms);
+
+            /// <summary>
+            /// Get the index of the positions, as updated by the last run.
+            /// </summary>
+            /// <returns>Index of the positions.</returns>
+            exported const SpatialIndex& index() const {
+                return *m_index;
+            }
+
+        protected:
+            /// <summary>
+            /// Create the ComponentFactory of the SpatialProxies.
+            /// </summary>
+            /// <returns>The ComponentFactory.</returns>
+            exported std::unique_ptr<ComponentFactory> createFactory() override;
+
+            /// <summary>
+            /// Create the SystemProcessing updating the index.
+            /// </summary>
+            /// <returns>The SystemProcessing.</returns>
+            exported std::unique_ptr<SystemProcessing> createProcessing() override;
+
+        private:
+            /// <summary>
+            /// Get the SpatialProxies, in the order of components().
+            /// </summary>
+            /// <returns>The SpatialProxies.</returns>
+            std::span<SpatialProxy> proxies() const {
+                return components().as<SpatialProxy>();
+            }
+
+            /// <summary>
+            /// Mark as changed the SpatialProxies of the Entities whose
+            /// Transform has changed since the last run.
+            /// </summary>
+            void followTransforms();
+
+            /// <summary>
+            /// Give the SpatialProxies changed since the last run to the
+            /// index.
+            /// </summary>
+            void refresh();
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,129 @@
+#ifndef __BANE_LINKED_SYSTEMS__
+#define __BANE_LINKED_SYSTEMS__
+
+#include <harmful/doom/utils/Platform.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "harmful/bane/components/ComponentData.hpp"
+#include "harmful/bane/components/TypeIndex.hpp"
+
+namespace Bane {
+	class System;
+
+	/// <summary>
+	/// Systems a System relies on (dependencies), given to its
+	/// SystemProcessing. They are found by the type of their ComponentData
+	/// with an array indexing; the names are only for the diagnostics.
+	/// </summary>
+	class LinkedSystems final {
+		private:
+			/// <summary>
+			/// Linked Systems, in their link order.
+			/// </summary>
+			std::vector<System*> m_systems;
+
+			/// <summary>
+			/// Linked Systems by identifier of their data type (see
+			/// TypeIndex); nullptr for the types without linked System.
+			/// </summary>
+			std::vector<System*> m_systemsByType;
+
+		public:
+			/// <summary>
+			/// Create a new LinkedSystems instance, empty.
+			/// </summary>
+			exported LinkedSystems() = default;
+
+			/// <summary>
+			/// Add a System. It replaces the linked System with the same
+			/// name, if any.
+			/// </summary>
+			/// <param name="system">System to link.</param>
+			exported void add(System* system);
+
+			/// <summary>
+			/// Remove the System with the same name as a given one.
+			/// </summary>
+			/// <param name="system">System to unlink.</param>
+			/// <returns>true if a System is removed; false otherwise.</returns>
+			exported bool remove(const System* system);
+
+			/// <summary>
+			/// Get the linked System storing a data type.
+			/// </summary>
+			/// <typeparam name="DataClass">Type of ComponentData.</typeparam>
+			/// <returns>
+			/// The first linked System storing the data type; nullptr if
+			/// none.
+			/// </returns>
+			template <class DataClass>
+			exported System* of() const {
+				return of(TypeIndex<ComponentData>::Of<DataClass>());
+			}
+
+			/// <summary>
+			/// Get the linked System storing a data type.
+			/// </summary>
+			/// <param name="typeId">
+			/// Identifier of the type of ComponentData.
+			/// </param>
+			/// <returns>
+			/// The first linked System storing the data type; nullptr if
+			/// none.
+			/// </returns>
+			exported System* of(const uint32_t typeId) const {
+				return (typeId < m_systemsByType.size()) ? m_systemsByType[typeId] : nullptr;
+			}
+
+			/// <summary>
+			/// Get a linked System by its name, by walking all of them. Meant
+			/// for the diagnostics and the tools: the processings use of().
+			/// </summary>
+			/// <param name="name">Name of the System.</param>
+			/// <returns>The linked System.</returns>
+			/// <exception cref="std::out_of_range">
+			/// No linked System has this name.
+			/// </exception>
+			exported System* at(const std::string& name) const;
+
+			/// <summary>
+			/// Check if a System is linked.
+			/// </summary>
+			/// <param name="system">System to be checked.</param>
+			/// <returns>true if linked; false otherwise.</returns>
+			exported bool contains(const System* system) const;
+
+			/// <summary>
+			/// Get the amount of linked Systems.
+			/// </summary>
+			/// <returns>Amount of linked Systems.</returns>
+			exported size_t size() const {
+				return m_systems.size();
+			}
+
+			/// <summary>
+			/// Get an iterator on the first linked System.
+			/// </summary>
+			/// <returns>Iterator on the first linked System.</returns>
+			exported std::vector<System*>::const_iterator begin() const {
+				return m_systems.begin();
+			}
+
+			/// <summary>
+			/// Get an iterator after the last linked System.
+			/// </summary>
+			/// <returns>Iterator after the last linked System.</returns>
+			exported std::vector<System*>::const_iterator end() const {
+				return m_systems.end();
+			}
+
+		private:
+			/// <summary>
+			/// Rebuild m_systemsByType from m_systems.
+			/// </summary>
+			void indexTypes();
+	};
+}
+
+#endif
\ No newline at end of file
@@ -2,17 +2,33 @@
 #define __BANE_SYSTEM__
 
 #include "harmful/bane/components/ComponentFactory.hpp"
+#include "harmful/bane/entities/EntityRegistry.hpp"
+#include "harmful/bane/jobs/SystemTask.hpp"
+#include "harmful/bane/systems/LinkedSystems.hpp"
 #include "harmful/bane/systems/SystemProcessing.hpp"
+#include "harmful/bane/world/Assets.hpp"
+#include "harmful/bane/world/EventBus.hpp"
 #include <harmful/doom/utils/Platform.hpp>
+#include <list>
+#include <mutex>
+#include <span>
+#include <typeindex>
 #include <unordered_map>
+#include <vector>
 #include <memory>
 #include <string>
 
 namespace Bane {
+	class AsyncIO;
+
 	/// <summary>
 	/// Class for defining a System of the ECS architecture.
 	/// </summary>
 	class System {
+		friend class Job;
+		friend class Prefab;
+		friend class World;
+
 		private:
 			/// <summary>
 			/// Name of the System.
@@ -29,7 +45,31 @@ namespace Bane {
 			/// <summary>
 			/// List of Systems the current one relies on (dependencies).
 			/// </summary>
-			std::unordered_map<std::string, System*> m_linkedSystems;
+			LinkedSystems m_linkedSystems;
+
+			/// <summary>
+			/// Types of ComponentData the System reads during its processing,
+			/// in addition to its own Components.
+			/// </summary>
+			std::vector<std::type_index> m_readTypes;
+
+			/// <summary>
+			/// Types of ComponentData the System writes during its
+			/// processing, in addition to its own Components.
+			/// </summary>
+			std::vector<std::type_index> m_writeTypes;
+
+			/// <summary>
+			/// Incremented each time the accesses of the System (read and
+			/// written types, linked Systems) change.
+			/// </summary>
+			uint32_t m_accessVersion = 0;
+
+			/// <summary>
+			/// Version of the World when the System was last run. 0 if never
+			/// run.
+			/// </summary>
+			uint32_t m_lastRunVersion = 0;
 
 			/// <summary>
 			/// The factory containing the Components the System works on.
@@ -41,6 +81,51 @@ namespace Bane {
 			/// </summary>
 			std::unique_ptr<SystemProcessing> m_processing = nullptr;
 
+			/// <summary>
+			/// Registry of the World owning the System, kept up to date with
+			/// the Entities the System holds Components for. nullptr if the
+			/// System is not owned by a World.
+			/// </summary>
+			EntityRegistry* m_registry = nullptr;
+
+			/// <summary>
+			/// Bit of the System in the signatures of m_registry.
+			/// </summary>
+			size_t m_registryBit = 0;
+
+			/// <summary>
+			/// Events of the World owning the System. nullptr if the System
+			/// is not owned by a World.
+			/// </summary>
+			const EventBus* m_events = nullptr;
+
+			/// <summary>
+			/// I/O threads of the World owning the System. nullptr if the
+			/// System is not owned by a World.
+			/// </summary>
+			AsyncIO* m_io = nullptr;
+
+			/// <summary>
+			/// Assets shared by the World owning the System. nullptr if the
+			/// System is not owned by a World.
+			/// </summary>
+			const std::shared_ptr<const Assets>* m_assets = nullptr;
+
+			/// <summary>
+			/// Protects m_tasks and m_readyTasks.
+			/// </summary>
+			mutable std::mutex m_tasksMutex;
+
+			/// <summary>
+			/// SystemTasks spawned by the System and not finished yet.
+			/// </summary>
+			std::vector<SystemTask::Handle> m_tasks;
+
+			/// <summary>
+			/// SystemTasks to resume at the next processing of the System.
+			/// </summary>
+			std::vector<SystemTask::Handle> m_readyTasks;
+
 		public:
 			/// <summary>
 			/// Create a new System instance.
@@ -48,6 +133,12 @@ namespace Bane {
 			/// <param name="name">Name of the System.</param>
 			exported System(const std::string& name);
 
+			/// <summary>
+			/// Destruction of the System instance. The SystemTasks not
+			/// finished yet are destroyed.
+			/// </summary>
+			exported virtual ~System() noexcept;
+
 			/// <summary>
 			/// Set up the System.
 			/// </summary>
@@ -69,7 +160,22 @@ namespace Bane {
 			/// Entity for which a new Component should be created.
 			/// </param>
 			/// <returns>A Component attached to the given Entity.</returns>
-			exported Component* create(const Entity& entity);
+			exported Component create(const Entity& entity);
+
+			/// <summary>
+			/// Create a Component for each of the given Entities at once.
+			/// Entities that already have a Component of the wanted type and
+			/// cannot have more than one keep their Component.
+			/// </summary>
+			/// <param name="entities">
+			/// Entities for which a new Component should be created. Each
+			/// Entity must appear once.
+			/// </param>
+			/// <returns>
+			/// Amount of created Components, which are the last ones of
+			/// components().
+			/// </returns>
+			exported size_t createMany(std::span<const Entity> entities);
 
 			/// <summary>
 			/// Delete the Components attached to an Entity.
@@ -80,9 +186,23 @@ namespace Bane {
 			exported void destroy(const Entity& entity);
 
 			/// <summary>
-			/// Link another System to the current one.
+			/// Delete all the Components of the System in a single pass.
+			/// </summary>
+			/// <remarks>
+			/// The signatures of the registry are left untouched: this is
+			/// meant to be used when all the Entities are cleared.
+			/// </remarks>
+			exported void clear();
+
+			/// <summary>
+			/// Link another System to the current one. It replaces the linked
+			/// System with the same name, if any.
 			/// </summary>
 			/// <param name="system">System to link to the current one.</param>
+			/// <remarks>
+			/// The linked System is found by the type of its Components (see
+			/// LinkedSystems::of()) only if it is set up before being linked.
+			/// </remarks>
 			exported void link(System* system);
 
 			/**
@@ -98,6 +218,60 @@ namespace Bane {
 			/// </param>
 			exported void unlink(System* system);
 
+			/// <summary>
+			/// Declare that the System reads Components of another System
+			/// during its processing. Systems writing these Components are
+			/// not run at the same time.
+			/// </summary>
+			/// <typeparam name="DataClass">
+			/// Type of ComponentData that is read.
+			/// </typeparam>
+			template <class DataClass>
+			exported void reads() {
+				addAccess(m_readTypes, typeid(DataClass));
+			}
+
+			/// <summary>
+			/// Declare that the System writes Components of another System
+			/// during its processing. Systems reading or writing these
+			/// Components are not run at the same time.
+			/// </summary>
+			/// <typeparam name="DataClass">
+			/// Type of ComponentData that is written.
+			/// </typeparam>
+			template <class DataClass>
+			exported void writes() {
+				addAccess(m_writeTypes, typeid(DataClass));
+			}
+
+			/// <summary>
+			/// Check if the current System and another one cannot run at the
+			/// same time, because one of them writes Components the other one
+			/// reads or writes. Each System is considered to write its own
+			/// Components.
+			/// </summary>
+			/// <param name="other">System to be checked.</param>
+			/// <returns>true if they conflict; false otherwise.</returns>
+			exported bool conflictsWith(const System& other) const;
+
+			/// <summary>
+			/// Check if another System is linked to the current one.
+			/// </summary>
+			/// <param name="system">System to be checked.</param>
+			/// <returns>true if linked; false otherwise.</returns>
+			exported bool isLinkedTo(const System* system) const {
+				return m_linkedSystems.contains(system);
+			}
+
+			/// <summary>
+			/// Get the version of the accesses of the System, incremented each
+			/// time they change.
+			/// </summary>
+			/// <returns>Version of the accesses.</returns>
+			exported uint32_t accessVersion() const {
+				return m_accessVersion;
+			}
+
 			/// <summary>
 			/// Get the amount of Components managed by the current System.
 			/// </summary>
@@ -112,12 +286,122 @@ namespace Bane {
 			/// Get all the Components managed by the current System.
 			/// </summary>
 			/// <returns>
-			/// All the Components managed by the current System.
+			/// All the Components managed by the current System, stored
+			/// contiguously.
 			/// </returns>
-			exported const std::unordered_set<Component*>& components() const {
+			exported const ComponentColumn& components() const {
 				return m_components -> components();
 			}
 
+			/// <summary>
+			/// Mark a range of Components of the System as changed, so that
+			/// the Queries and Systems filtering on changes see them.
+			/// </summary>
+			/// <param name="fromIndex">Start index of the range.</param>
+			/// <param name="toIndex">End index (excluded) of the range.</param>
+			exported void markChanged(const size_t fromIndex, const size_t toIndex) {
+				m_components -> markChanged(fromIndex, toIndex);
+			}
+
+			/// <summary>
+			/// Get the version of the World when the System was last run.
+			/// The Components whose change version (see ComponentColumn) is
+			/// greater have been changed since then, so unchanged chunks can
+			/// be skipped by the processing.
+			/// </summary>
+			/// <returns>Version of the last run; 0 if never run.</returns>
+			exported uint32_t lastRunVersion() const {
+				return m_lastRunVersion;
+			}
+
+			/// <summary>
+			/// Set the version of the World when the System was last run.
+			/// </summary>
+			/// <param name="version">Version of the last run.</param>
+			exported void setLastRunVersion(const uint32_t version) {
+				m_lastRunVersion = version;
+			}
+
+			/// <summary>
+			/// Get the events of a type published since the last run of the
+			/// System. Can be called from several threads while the System is
+			/// processed.
+			/// </summary>
+			/// <typeparam name="EventClass">Type of the events.</typeparam>
+			/// <returns>
+			/// The events, in their publication order. Empty if the System is
+			/// not owned by a World.
+			/// </returns>
+			template <class EventClass>
+			exported std::span<const EventClass> events() const {
+				if (!m_events) {
+					return {};
+				}
+
+				return m_events -> since<EventClass>(m_lastRunVersion);
+			}
+
+			/// <summary>
+			/// Get the I/O threads of the World owning the System, to await
+			/// file reads in SystemTasks.
+			/// </summary>
+			/// <returns>
+			/// I/O threads; nullptr if the System is not owned by a World.
+			/// </returns>
+			exported AsyncIO* io() const {
+				return m_io;
+			}
+
+			/// <summary>
+			/// Get the immutable data shared by the World owning the System
+			/// with other Worlds.
+			/// </summary>
+			/// <returns>
+			/// The shared Assets; nullptr if there are none or if the System
+			/// is not owned by a World.
+			/// </returns>
+			exported const Assets* assets() const {
+				return m_assets ? m_assets -> get() : nullptr;
+			}
+
+			/// <summary>
+			/// Start a SystemTask of the System. It runs on the calling thread
+			/// until its first suspension, then is resumed by the Job running
+			/// the System each time an awaited operation completes.
+			/// </summary>
+			/// <param name="task">SystemTask to start.</param>
+			/// <param name="commands">
+			/// CommandBuffer used until the first suspension, usually the one
+			/// given to the processing.
+			/// </param>
+			exported void spawn(SystemTask task, CommandBuffer& commands);
+
+			/// <summary>
+			/// Schedule a suspended SystemTask of the System, to resume it at
+			/// the next processing of the System. Called by the awaited
+			/// operations, from any thread.
+			/// </summary>
+			/// <param name="task">Suspended SystemTask.</param>
+			exported void schedule(SystemTask::Handle task);
+
+			/// <summary>
+			/// Get the amount of SystemTasks of the System not finished yet.
+			/// </summary>
+			/// <returns>Amount of SystemTasks.</returns>
+			exported size_t amountTasks() const {
+				std::lock_guard<std::mutex> lock(m_tasksMutex);
+				return m_tasks.size();
+			}
+
+			/// <summary>
+			/// Get the Entities bearing at least one Component of the current
+			/// System.
+			/// </summary>
+			/// <returns>Packed IDs of the Entities.</returns>
+			exported std::span<const id_t> entities() const {
+				return m_components -> entities();
+			}
+
 			/// <summary>
 			/// Get the first Component found for the given Entity.
 			/// </summary>
@@ -125,10 +409,10 @@ namespace Bane {
 			/// The Entity to get the first Component.
 			/// </param>
 			/// <returns>
-			/// The first Component for the given Entity; nullptr if none
-			/// found.
+			/// The first Component for the given Entity; an invalid Component
+			/// if none found.
 			/// </returns>
-			exported Component* componentOf(const Entity& entity) {
+			exported Component componentOf(const Entity& entity) const {
 				return m_components -> firstOf(entity);
 			}
 
@@ -139,28 +423,40 @@ namespace Bane {
 			/// <returns>
 			/// All the Components found for the given entity.
 			/// </returns>
-			exported std::list<Component*> componentsOf(const Entity& entity) {
+			exported ComponentFactory::ComponentRange componentsOf(const Entity& entity) const {
 				return m_components -> componentsOf(entity);
 			}
 
+			/// <summary>
+			/// Get the ComponentFactory of the current System.
+			/// </summary>
+			/// <returns>
+			/// ComponentFactory of the current System.
+			/// </returns>
+			exported ComponentFactory* factory() const {
+				return m_components.get();
+			}
+
 			/// <summary>
 			/// Run the Components processing.
 			/// </summary>
+			/// <param name="commands">
+			/// Records the Entities and Components to create or destroy.
+			/// </param>
 			/// <param name="fromIndex">
 			/// Start index in the list of Components to process.
 			/// </param>
 			/// <param name="toIndex">
 			/// End index in the list of Components to process.
 			/// </param>
-			/// <returns>
-			/// A list of Entities to be removed by the World.
-			/// </returns>
-			exported std::list<Entity> process(
+			exported void process(
+				CommandBuffer& commands,
 				const size_t fromIndex,
 				const size_t toIndex
 			) {
-				return m_processing -> run(
+				m_processing -> run(
 					m_linkedSystems,
+					commands,
 					fromIndex,
 					toIndex
 				);
@@ -216,18 +512,78 @@ namespace Bane {
 				return m_name;
 			}
 
+		private:
+			/// <summary>
+			/// Add a type to a list of accessed types if not already in it.
+			/// </summary>
+			/// <param name="types">List of accessed types.</param>
+			/// <param name="type">Type to add.</param>
+			void addAccess(
+				std::vector<std::type_index>& types,
+				const std::type_index& type
+			);
+
+			/// <summary>
+			/// Move the scheduled SystemTasks into a list, to resume them.
+			/// </summary>
+			/// <param name="tasks">List receiving the SystemTasks.</param>
+			void takeReadyTasks(std::vector<SystemTask::Handle>& tasks);
+
+			/// <summary>
+			/// Resume a SystemTask of the System until its next suspension.
+			/// It is destroyed once finished.
+			/// </summary>
+			/// <param name="task">SystemTask to resume.</param>
+			/// <param name="commands">
+			/// CommandBuffer of the thread resuming the SystemTask.
+			/// </param>
+			/// <exception>
+			/// Any exception thrown by the SystemTask, which is destroyed.
+			/// </exception>
+			void resume(SystemTask::Handle task, CommandBuffer& commands);
+
+			/// <summary>
+			/// Get the type of the Components of the System.
+			/// </summary>
+			/// <returns>Type of the Components.</returns>
+			std::type_index ownType() const {
+				return std::type_index(*(m_components -> components().type().info));
+			}
+
+			/// <summary>
+			/// Check if the System writes the given type.
+			/// </summary>
+			/// <param name="type">Type to be checked.</param>
+			/// <returns>true if written; false otherwise.</returns>
+			bool isWriting(const std::type_index& type) const;
+
+			/// <summary>
+			/// Check if another System reads or writes a type the current
+			/// System writes.
+			/// </summary>
+			/// <param name="other">System to be checked.</param>
+			/// <returns>true if it does; false otherwise.</returns>
+			bool writesAccessedBy(const System& other) const;
+
+			/// <summary>
+			/// Check if the System reads or writes the given type.
+			/// </summary>
+			/// <param name="type">Type to be checked.</param>
+			/// <returns>true if accessed; false otherwise.</returns>
+			bool isAccessing(const std::type_index& type) const;
+
 		protected:
 			/// <summary>
 			/// Create the ComponentFactory used by the System.
 			/// </summary>
 			/// <returns>The ComponentFactory used by the System.</returns>
-			exported virtual std::unique_ptr<ComponentFactory>&& createFactory() = 0;
+			exported virtual std::unique_ptr<ComponentFactory> createFactory() = 0;
 
 			/// <summary>
 			/// Create the SystemProcessing used by the System.
 			/// </summary>
 			/// <returns>The SystemProcessing used by the System.</returns>
-			exported virtual std::unique_ptr<SystemProcessing>&& createProcessing() = 0;
+			exported virtual std::unique_ptr<SystemProcessing> createProcessing() = 0;
 	};
 }
 
@@ -2,10 +2,11 @@
 #define __BANE_SYSTEM_PROCESSING__
 
 #include "harmful/bane/entities/Entity.hpp"
+#include "harmful/bane/systems/LinkedSystems.hpp"
+#include "harmful/bane/world/CommandBuffer.hpp"
 #include <harmful/doom/utils/Platform.hpp>
 #include <functional>
-#include <unordered_map>
-#include <vector>
+#include <string>
 
 namespace Bane {
 	class System;
@@ -14,16 +15,21 @@ namespace Bane {
 	/// Class for processing the Components of a System.
 	/// </summary>
 	class SystemProcessing {
-		using DropEntityList = std::vector<id_t>;
+		friend class System;
 
 		private:
 			/// <summary>
-			/// List of Entities the associated System has marked as to be
-			/// removed from the application.
+			/// System the current SystemProcessing processes the Components.
+			/// Set by the System itself during its setup.
 			/// </summary>
-			DropEntityList m_dropEntities;
+			System* m_system = nullptr;
 
 		public:
+			/// <summary>
+			/// Destruction of the SystemProcessing instance.
+			/// </summary>
+			exported virtual ~SystemProcessing() noexcept = default;
+
 			/// <summary>
 			/// Do something when an entity is removed.
 			/// </summary>
@@ -36,7 +42,13 @@ namespace Bane {
 			/// Perform the Components processing.
 			/// </summary>
 			/// <param name="linkedSystems">
-			/// List of Systems the current one relies on (dependencies).
+			/// List of Systems the current one relies on (dependencies), found
+			/// by the type of their Components with LinkedSystems::of().
+			/// </param>
+			/// <param name="commands">
+			/// Records the Entities and Components to create or destroy. They
+			/// are applied by the World once all the Systems of the current
+			/// stage are processed.
 			/// </param>
 			/// <param name="fromIndex">
 			/// Start index in the list of Components to process.
@@ -44,30 +56,22 @@ namespace Bane {
 			/// <param name="toIndex">
 			/// End index in the list of Components to process.
 			/// </param>
-			/// <returns>
-			/// A list of Entities to be removed by the World.
-			/// </returns>
-			exported virtual std::list<Entity> run(
-				std::unordered_map<std::string, System*> linkedSystems,
+			exported virtual void run(
+				const LinkedSystems& linkedSystems,
+				CommandBuffer& commands,
 				const size_t fromIndex,
 				const size_t toIndex
 			) = 0;
 
-			/// <summary>
-			/// Get the Entities to be dropped.
-			/// </summary>
-			/// <returns>The Entities to be dropped.</returns>
-			exported const DropEntityList& dropEntities() const {
-				return m_dropEntities;
-			}
-
 		protected:
 			/// <summary>
-			/// Get the Entities to be dropped. The list can be modified.
+			/// Get the System the current SystemProcessing processes the
+			/// Components. Its Components are stored contiguously, so that a
+			/// range of indices can be walked linearly.
 			/// </summary>
-			/// <returns>The Entities to be dropped.</returns>
-			exported DropEntityList& dropEntities() {
-				return m_dropEntities;
+			/// <returns>The processed System.</returns>
+			exported System* system() const {
+				return m_system;
 			}
 	};
 }
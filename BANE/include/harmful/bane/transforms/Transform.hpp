@@ -0,0 +1,64 @@
+#ifndef __BANE_TRANSFORM__
+#define __BANE_TRANSFORM__
+
+#include <array>
+#include <harmful/doom/utils/Platform.hpp>
+#include "harmful/bane/components/ComponentData.hpp"
+#include "harmful/bane/entities/Entity.hpp"
+
+namespace Bane {
+    /// <summary>
+    /// Position, orientation and size of an Entity relatively to its parent
+    /// in a hierarchy, and the resulting world matrix, computed by the
+    /// TransformSystem.
+    /// </summary>
+    /// <remarks>
+    /// The local transform is changed through the TransformSystem or
+    /// ComponentColumn::write() so that the change is detected; the parent
+    /// is only changed through TransformSystem::setParent().
+    /// </remarks>
+    struct Transform : public ComponentData {
+        /// <summary>
+        /// World matrix, row by row as in Mind::Matrix4x4f (the translation
+        /// is in the last column): the world matrix of the parent multiplied
+        /// by the local matrix, translation * rotation * scale.
+        /// </summary>
+        alignas(16) std::array<float, 4> world[4] {
+            { 1.f, 0.f, 0.f, 0.f },
+            { 0.f, 1.f, 0.f, 0.f },
+            { 0.f, 0.f, 1.f, 0.f },
+            { 0.f, 0.f, 0.f, 1.f }
+        };
+
+        /// <summary>
+        /// Rotation relatively to the parent, as a unit quaternion (x, y, z,
+        /// w).
+        /// </summary>
+        std::array<float, 4> rotation { 0.f, 0.f, 0.f, 1.f };
+
+        /// <summary>
+        /// Translation relatively to the parent.
+        /// </summary>
+        std::array<float, 3> translation { 0.f, 0.f, 0.f };
+
+        /// <summary>
+        /// Scale relatively to the parent, applied before the rotation.
+        /// </summary>
+        std::array<float, 3> scale { 1.f, 1.f, 1.f };
+
+        /// <summary>
+        /// ID of the parent Entity; Entity::InvalidID for a root.
+        /// </summary>
+        id_t parent = Entity::InvalidID;
+
+        /// <summary>
+        /// An Entity has a single Transform.
+        /// </summary>
+        /// <returns>Quantity::One.</returns>
+        static Quantity AllowedQuantity() {
+            return Quantity::One;
+        }
+    };
+}
+
+#endif
\ No newline at end of file
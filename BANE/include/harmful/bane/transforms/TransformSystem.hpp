@@ -0,0 +1,242 @@
+#ifndef __BANE_TRANSFORM_SYSTEM__
+#define __BANE_TRANSFORM_SYSTEM__
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+#include <harmful/doom/utils/Platform.hpp>
+#include <harmful/mind/geometry/points/Point3Df.hpp>
+#include <harmful/mind/geometry/quaternions/Quaternion.hpp>
+#include <harmful/mind/matrices/Matrix4x4f.hpp>
+#include "harmful/bane/jobs/ThreadTask.hpp"
+#include "harmful/bane/systems/System.hpp"
+#include "harmful/bane/transforms/Transform.hpp"
+
+namespace Bane {
+    /// <summary>
+    /// System computing the world matrices of a hierarchy of Transforms.
+    /// </summary>
+    /// <remarks>
+    /// The Transforms are stored breadth-first: each level of depth is
+    /// contiguous, the parents precede their children and the children of a
+    /// parent are next to each other. They are sorted again only when the
+    /// hierarchy changes (new or destroyed Transform, new parent).
+    ///
+    /// The levels are processed one after the other, each one split over the
+    /// threads of the Job. A world matrix is computed again only if the local
+    /// transform has changed since the last run or the world matrix of the
+    /// parent has been computed again: the static subtrees are skipped. The
+    /// matrices are composed four at a time with SIMD vectors.
+    ///
+    /// The System is not multithreadable in the sense of the Job: it runs as
+    /// a single chunk that spreads its levels on the threads itself.
+    /// </remarks>
+    class TransformSystem : public System {
+        private:
+            /// <summary>
+            /// Processing of a TransformSystem.
+            /// </summary>
+            class Processing;
+
+            /// <summary>
+            /// Index used to tell that a Transform has no parent.
+            /// </summary>
+            static constexpr uint32_t NoParent = std::numeric_limits<uint32_t>::max();
+
+            /// <summary>
+            /// Minimal amount of Transforms of a level processed by a
+            /// ThreadTask.
+            /// </summary>
+            static constexpr size_t MinimalTaskSize = 2048;
+
+            /// <summary>
+            /// Amount of world matrices composed at once.
+            /// </summary>
+            static constexpr size_t BatchSize = 4;
+
+            /// <summary>
+            /// Index of the parent of each Transform in components();
+            /// NoParent for a root.
+            /// </summary>
+            std::vector<uint32_t> m_parentIndices;
+
+            /// <summary>
+            /// Index of the first Transform of each level of depth in
+            /// components(), followed by the amount of Transforms.
+            /// </summary>
+            std::vector<size_t> m_levels;
+
+            /// <summary>
+            /// 1 for each Transform whose world matrix has been computed
+            /// during the current run; 0 otherwise.
+            /// </summary>
+            std::vector<uint8_t> m_recomputed;
+
+            /// <summary>
+            /// ThreadTasks processing the current level.
+            /// </summary>
+            std::vector<ThreadTask> m_tasks;
+
+            /// <summary>
+            /// true if a parent has changed or a Transform has been destroyed
+            /// since the last sort.
+            /// </summary>
+            bool m_isHierarchyDirty = true;
+
+            /// <summary>
+            /// Amount of Transforms at the last sort.
+            /// </summary>
+            size_t m_amountSorted = 0;
+
+            /// <summary>
+            /// Version of the Components at the last sort.
+            /// </summary>
+            uint32_t m_sortVersion = 0;
+
+        public:
+            /// <summary>
+            /// Create a new TransformSystem instance.
+            /// </summary>
+            /// <param name="name">Name of the System.</param>
+            exported TransformSystem(const std::string& name);
+
+            /// <summary>
+            /// Attach an Entity to a parent. Must not be called while the
+            /// TransformSystem is processed.
+            /// </summary>
+            /// <param name="child">Entity bearing a Transform.</param>
+            /// <param name="parent">
+            /// Entity bearing a Transform; an invalid Entity to make the child
+            /// a root.
+            /// </param>
+            /// <exception cref="std::runtime_error">
+            /// One of the Entities has no Transform, or the child is the parent
+            /// or one of its ancestors.
+            /// </exception>
+            exported void setParent(const Entity& child, const Entity& parent);
+
+            /// <summary>
+            /// Set the local transform of an Entity, relatively to its parent.
+            /// </summary>
+            /// <param name="entity">Entity bearing a Transform.</param>
+            /// <param name="translation">Translation.</param>
+            /// <param name="rotation">Rotation, as a unit quaternion.</param>
+            /// <param name="scale">Scale.</param>
+            /// <exception cref="std::runtime_error">
+            /// The Entity has no Transform.
+            /// </exception>
+            exported void setLocal(
+                const Entity& entity,
+                const Mind::Vector3f& translation,
+                const Mind::Quaternion& rotation,
+                const Mind::Vector3f& scale
+            );
+
+            /// <summary>
+            /// Get the world matrix of an Entity, as computed by the last run.
+            /// </summary>
+            /// <param name="entity">Entity bearing a Transform.</param>
+            /// <returns>The world matrix.</returns>
+            /// <exception cref="std::runtime_error">
+            /// The Entity has no Transform.
+            /// </exception>
+            exported Mind::Matrix4x4f worldMatrix(const Entity& entity) const;
+
+            /// <summary>
+            /// Get the amount of levels of depth of the hierarchy at the last
+            /// run.
+            /// </summary>
+            /// <returns>Amount of levels; 0 if never run.</returns>
+            exported size_t amountLevels() const {
+                return m_levels.empty() ? 0 : (m_levels.size() - 1);
+            }
+
+        protected:
+            /// <summary>
+            /// Create the ComponentFactory of the Transforms.
+            /// </summary>
+            /// <returns>The ComponentFactory.</returns>
+            exported std::unique_ptr<ComponentFactory> createFactory() override;
+
+            /// <summary>
+            /// Create the SystemProcessing propagating the Transforms.
+            /// </summary>
+            /// <returns>The SystemProcessing.</returns>
+            exported std::unique_ptr<SystemProcessing> createProcessing() override;
+
+        private:
+            /// <summary>
+            /// Get the Transforms, in the order of components().
+            /// </summary>
+            /// <returns>The Transforms.</returns>
+            std::span<Transform> transforms() const {
+                return components().as<Transform>();
+            }
+
+            /// <summary>
+            /// Get the Transform of an Entity.
+            /// </summary>
+            /// <param name="entity">Entity bearing a Transform.</param>
+            /// <returns>Index of the Transform in components().</returns>
+            /// <exception cref="std::runtime_error">
+            /// The Entity has no Transform.
+            /// </exception>
+            size_t indexOf(const Entity& entity) const;
+
+            /// <summary>
+            /// Compute the world matrices of all the levels.
+            /// </summary>
+            void propagate();
+
+            /// <summary>
+            /// Check if the hierarchy has changed since the last sort.
+            /// </summary>
+            /// <returns>true if the Transforms must be sorted again.</returns>
+            bool isHierarchyChanged() const;
+
+            /// <summary>
+            /// Sort the Transforms breadth-first, compute the levels and the
+            /// indices of the parents. The Transforms whose parent has no
+            /// Transform anymore become roots.
+            /// </summary>
+            void sortHierarchy();
+
+            /// <summary>
+            /// Compute the depth of each Transform. A Transform closing a
+            /// cycle becomes a root.
+            /// </summary>
+            /// <returns>Depth of each Transform, in components().</returns>
+            std::vector<uint32_t> computeDepths();
+
+            /// <summary>
+            /// Compute the world matrices of a range of a level, if needed.
+            /// </summary>
+            /// <param name="fromIndex">Start index in components().</param>
+            /// <param name="toIndex">End index (excluded) in components().</param>
+            void propagateRange(const size_t fromIndex, const size_t toIndex);
+
+            /// <summary>
+            /// Compose the local matrices of Transforms and multiply them by
+            /// the world matrices of their parents.
+            /// </summary>
+            /// <param name="indices">
+            /// Indices of the BatchSize Transforms in components(). They may
+            /// be repeated to complete a batch.
+            /// </param>
+            void computeBatch(const uint32_t* indices);
+
+            /// <summary>
+            /// Process a range of a level on a thread of the Job.
+            /// </summary>
+            /// <param name="worker">ThreadJob executing the ThreadTask.</param>
+            /// <param name="task">
+            /// ThreadTask whose context is the TransformSystem.
+            /// </param>
+            static void PropagateTask(ThreadJob& worker, const ThreadTask& task);
+    };
+}
+
+#endif
\ No newline at end of file
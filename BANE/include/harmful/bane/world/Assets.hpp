@@ -0,0 +1,88 @@
+#ifndef __BANE_ASSETS__
+#define __BANE_ASSETS__
+
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <harmful/doom/utils/Platform.hpp>
+
+namespace Bane {
+    /// <summary>
+    /// Immutable data shared by several Worlds (meshes, navigation data,
+    /// tuning tables...), found by name.
+    /// </summary>
+    /// <remarks>
+    /// The Assets are filled before being shared: they are then only read,
+    /// by any thread of any World, without lock.
+    /// </remarks>
+    class Assets final {
+        private:
+            /// <summary>
+            /// An asset with its type.
+            /// </summary>
+            struct Entry {
+                /// <summary>
+                /// The asset.
+                /// </summary>
+                std::shared_ptr<const void> data;
+
+                /// <summary>
+                /// Type of the asset.
+                /// </summary>
+                const std::type_info* type;
+            };
+
+            /// <summary>
+            /// Assets by name.
+            /// </summary>
+            std::unordered_map<std::string, Entry> m_entries;
+
+        public:
+            /// <summary>
+            /// Create a new Assets instance, empty.
+            /// </summary>
+            exported Assets() = default;
+
+            /// <summary>
+            /// Add an asset, or replace the one with the same name.
+            /// </summary>
+            /// <typeparam name="AssetClass">Type of the asset.</typeparam>
+            /// <param name="name">Name of the asset.</param>
+            /// <param name="asset">The asset.</param>
+            template <class AssetClass>
+            exported void add(const std::string& name, std::shared_ptr<const AssetClass> asset) {
+                m_entries[name] = { std::move(asset), &typeid(AssetClass) };
+            }
+
+            /// <summary>
+            /// Find an asset.
+            /// </summary>
+            /// <typeparam name="AssetClass">Type of the asset.</typeparam>
+            /// <param name="name">Name of the asset.</param>
+            /// <returns>
+            /// The asset; nullptr if there is no asset of this type with this
+            /// name.
+            /// </returns>
+            template <class AssetClass>
+            exported const AssetClass* find(const std::string& name) const {
+                auto entry = m_entries.find(name);
+
+                if ((entry == m_entries.end()) || (*(entry -> second.type) != typeid(AssetClass))) {
+                    return nullptr;
+                }
+
+                return static_cast<const AssetClass*>(entry -> second.data.get());
+            }
+
+            /// <summary>
+            /// Get the amount of assets.
+            /// </summary>
+            /// <returns>Amount of assets.</returns>
+            exported size_t size() const {
+                return m_entries.size();
+            }
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,376 @@
+#ifndef __BANE_COMMAND_BUFFER__
+#define __BANE_COMMAND_BUFFER__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <vector>
+#include <harmful/doom/utils/Platform.hpp>
+#include "harmful/bane/entities/Entity.hpp"
+#include "harmful/bane/entities/EntityFactory.hpp"
+#include "harmful/bane/components/ComponentData.hpp"
+#include "harmful/bane/jobs/RandomStream.hpp"
+#include "harmful/bane/world/EventBus.hpp"
+
+namespace Bane {
+    class Prefab;
+    class System;
+
+    /// <summary>
+    /// Records the structural changes (Entities and Components creation or
+    /// destruction) and the events requested while the Systems are
+    /// processed, so that they are applied by the World once the threads are
+    /// done. Each thread owns its own CommandBuffer: recording needs no lock.
+    /// </summary>
+    class CommandBuffer final {
+        public:
+            /// <summary>
+            /// Kind of recorded change. The commands are applied in this
+            /// order.
+            /// </summary>
+            enum class Type : uint8_t {
+                CreateEntity,
+                Instantiate,
+                AddComponent,
+                RemoveComponents,
+                DestroyEntity
+            };
+
+            /// <summary>
+            /// A recorded change.
+            /// </summary>
+            struct Command {
+                /// <summary>
+                /// Kind of change.
+                /// </summary>
+                Type type;
+
+                /// <summary>
+                /// Entity the change applies to.
+                /// </summary>
+                Entity entity;
+
+                /// <summary>
+                /// System owning the Components to add or remove.
+                /// </summary>
+                System* system;
+
+                /// <summary>
+                /// Offset of the data of an added Component in the payloads of
+                /// the CommandBuffer.
+                /// </summary>
+                uint32_t payloadOffset;
+
+                /// <summary>
+                /// Size of the data of an added Component; 0 to keep the
+                /// default data.
+                /// </summary>
+                uint32_t payloadSize;
+
+                /// <summary>
+                /// Prefab of an instantiated Entity.
+                /// </summary>
+                const Prefab* prefab = nullptr;
+            };
+
+            /// <summary>
+            /// Stream of a CommandBuffer creating its Entities directly,
+            /// outside of any reservation.
+            /// </summary>
+            static constexpr uint32_t NoStream = UINT32_MAX;
+
+            /// <summary>
+            /// A recorded event.
+            /// </summary>
+            struct Event {
+                /// <summary>
+                /// Identifier of the type of the event (see
+                /// EventBus::TypeId()).
+                /// </summary>
+                size_t type;
+
+                /// <summary>
+                /// Offset of the event in the payloads of the CommandBuffer.
+                /// </summary>
+                uint32_t payloadOffset;
+
+                /// <summary>
+                /// Size of the event.
+                /// </summary>
+                uint32_t payloadSize;
+            };
+
+        private:
+            /// <summary>
+            /// Factory the created Entities are taken from.
+            /// </summary>
+            EntityFactory* m_entities;
+
+            /// <summary>
+            /// Recorded commands.
+            /// </summary>
+            std::vector<Command> m_commands;
+
+            /// <summary>
+            /// Recorded events.
+            /// </summary>
+            std::vector<Event> m_events;
+
+            /// <summary>
+            /// Data of the added Components and of the events, packed one
+            /// after the other.
+            /// </summary>
+            std::vector<std::byte> m_payloads;
+
+            /// <summary>
+            /// Random stream of the chunk being recorded.
+            /// </summary>
+            RandomStream m_random;
+
+            /// <summary>
+            /// Stream of the reservation of m_entities the created Entities
+            /// are taken from; NoStream to create them directly.
+            /// </summary>
+            uint32_t m_stream = NoStream;
+
+        public:
+            /// <summary>
+            /// Create a new CommandBuffer instance.
+            /// </summary>
+            /// <param name="entities">
+            /// Factory the created Entities are taken from.
+            /// </param>
+            exported CommandBuffer(EntityFactory& entities)
+                : m_entities(&entities) {}
+
+            /// <summary>
+            /// Create an Entity. Its ID is reserved immediately so that
+            /// Components can be added to it in the same CommandBuffer, or
+            /// stored in Component data and events; the World registers it
+            /// when the CommandBuffer is applied.
+            /// </summary>
+            /// <remarks>
+            /// In deterministic mode, the ID is taken from the stream of the
+            /// CommandBuffer (see setStream()), so that it does not depend on
+            /// the threads.
+            /// </remarks>
+            /// <returns>The created Entity.</returns>
+            exported Entity create();
+
+            /// <summary>
+            /// Create an Entity with the Components of a Prefab. Its ID is
+            /// reserved immediately, as with create(); the instances of a
+            /// same Prefab recorded by all the threads are created in bulk
+            /// when the CommandBuffer is applied.
+            /// </summary>
+            /// <param name="prefab">
+            /// Prefab to instantiate. It must outlive the CommandBuffer.
+            /// </param>
+            /// <returns>The created Entity.</returns>
+            exported Entity instantiate(const Prefab& prefab);
+
+            /// <summary>
+            /// Create several Entities with the Components of a Prefab (see
+            /// instantiate()).
+            /// </summary>
+            /// <param name="prefab">
+            /// Prefab to instantiate. It must outlive the CommandBuffer.
+            /// </param>
+            /// <param name="entities">Receives the created Entities.</param>
+            exported void instantiate(const Prefab& prefab, std::span<Entity> entities);
+
+            /// <summary>
+            /// Destroy an Entity and all its Components.
+            /// </summary>
+            /// <param name="entity">Entity to destroy.</param>
+            exported void destroy(const Entity& entity) {
+                m_commands.push_back({ Type::DestroyEntity, entity, nullptr, 0, 0 });
+            }
+
+            /// <summary>
+            /// Add a Component with its default data to an Entity.
+            /// </summary>
+            /// <param name="entity">Entity to add the Component to.</param>
+            /// <param name="system">System owning the Component.</param>
+            exported void add(const Entity& entity, System* system) {
+                m_commands.push_back({ Type::AddComponent, entity, system, 0, 0 });
+            }
+
+            /// <summary>
+            /// Add a Component with the given data to an Entity.
+            /// </summary>
+            /// <typeparam name="DataClass">
+            /// Type of the data of the Component. It is copied byte by byte in
+            /// the new Component, so it must be trivially copyable.
+            /// </typeparam>
+            /// <param name="entity">Entity to add the Component to.</param>
+            /// <param name="system">System owning the Component.</param>
+            /// <param name="data">Data of the new Component.</param>
+            template <class DataClass>
+            exported void add(
+                const Entity& entity,
+                System* system,
+                const DataClass& data
+            ) {
+                static_assert(
+                    std::is_base_of_v<ComponentData, DataClass>,
+                    "Only derived class from ComponentData can be used here."
+                );
+
+                static_assert(
+                    std::is_trivially_copyable_v<DataClass>,
+                    "Only trivially copyable data can be recorded."
+                );
+
+                auto offset = static_cast<uint32_t>(m_payloads.size());
+                m_payloads.resize(m_payloads.size() + sizeof(DataClass));
+                std::memcpy(m_payloads.data() + offset, &data, sizeof(DataClass));
+
+                m_commands.push_back({
+                    Type::AddComponent,
+                    entity,
+                    system,
+                    offset,
+                    static_cast<uint32_t>(sizeof(DataClass))
+                });
+            }
+
+            /// <summary>
+            /// Remove all the Components of a System from an Entity.
+            /// </summary>
+            /// <param name="entity">Entity to remove the Components of.</param>
+            /// <param name="system">System owning the Components.</param>
+            exported void remove(const Entity& entity, System* system) {
+                m_commands.push_back({ Type::RemoveComponents, entity, system, 0, 0 });
+            }
+
+            /// <summary>
+            /// Emit an event, published in the EventBus of the World when the
+            /// CommandBuffer is applied.
+            /// </summary>
+            /// <typeparam name="EventClass">
+            /// Type of the event. It is copied byte by byte, so it must be
+            /// trivially copyable.
+            /// </typeparam>
+            /// <param name="event">The event.</param>
+            template <class EventClass>
+            exported void emit(const EventClass& event) {
+                static_assert(
+                    std::is_trivially_copyable_v<EventClass>,
+                    "Only trivially copyable events can be emitted."
+                );
+
+                static_assert(
+                    alignof(EventClass) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                    "Over-aligned events cannot be emitted."
+                );
+
+                auto offset = static_cast<uint32_t>(m_payloads.size());
+                m_payloads.resize(m_payloads.size() + sizeof(EventClass));
+                std::memcpy(m_payloads.data() + offset, &event, sizeof(EventClass));
+
+                m_events.push_back({
+                    EventBus::TypeId<EventClass>(),
+                    offset,
+                    static_cast<uint32_t>(sizeof(EventClass))
+                });
+            }
+
+            /// <summary>
+            /// Append the commands and events of another CommandBuffer to the
+            /// current one.
+            /// </summary>
+            /// <param name="other">CommandBuffer to append.</param>
+            exported void append(const CommandBuffer& other);
+
+            /// <summary>
+            /// Sort the commands by type, then by Entity. The commands of a
+            /// same type on a same Entity keep their recording order.
+            /// </summary>
+            exported void sort();
+
+            /// <summary>
+            /// Take the created Entities from a stream of the reservation of
+            /// the EntityFactory (see EntityFactory::beginReservation()). The
+            /// Job sets the stream of each chunk in deterministic mode.
+            /// </summary>
+            /// <param name="stream">
+            /// Index of the stream; NoStream to create the Entities directly.
+            /// </param>
+            exported void setStream(const uint32_t stream) {
+                m_stream = stream;
+            }
+
+            /// <summary>
+            /// Get the random stream of the chunk being processed. The Job
+            /// reseeds it before each chunk.
+            /// </summary>
+            /// <returns>The random stream.</returns>
+            exported RandomStream& random() {
+                return m_random;
+            }
+
+            /// <summary>
+            /// Remove all the commands and events.
+            /// </summary>
+            exported void clear() {
+                m_commands.clear();
+                m_events.clear();
+                m_payloads.clear();
+            }
+
+            /// <summary>
+            /// Check if no command is recorded.
+            /// </summary>
+            /// <returns>true if empty; false otherwise.</returns>
+            exported bool empty() const {
+                return m_commands.empty();
+            }
+
+            /// <summary>
+            /// Get the recorded commands.
+            /// </summary>
+            /// <returns>The recorded commands.</returns>
+            exported std::span<const Command> commands() const {
+                return std::span<const Command>(m_commands);
+            }
+
+            /// <summary>
+            /// Get the recorded events, in their recording order.
+            /// </summary>
+            /// <returns>The recorded events.</returns>
+            exported std::span<const Event> events() const {
+                return std::span<const Event>(m_events);
+            }
+
+            /// <summary>
+            /// Get the data of an added Component.
+            /// </summary>
+            /// <param name="command">Command adding the Component.</param>
+            /// <returns>Data of the Component.</returns>
+            exported const std::byte* payloadOf(const Command& command) const {
+                return m_payloads.data() + command.payloadOffset;
+            }
+
+            /// <summary>
+            /// Get the data of a recorded event.
+            /// </summary>
+            /// <param name="event">Recorded event.</param>
+            /// <returns>Data of the event.</returns>
+            exported const std::byte* payloadOf(const Event& event) const {
+                return m_payloads.data() + event.payloadOffset;
+            }
+
+        private:
+            /// <summary>
+            /// Create an Entity, from the stream of the CommandBuffer if any.
+            /// </summary>
+            /// <returns>The created Entity.</returns>
+            Entity newEntity();
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,150 @@
+#ifndef __BANE_EVENT_BUS__
+#define __BANE_EVENT_BUS__
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <vector>
+#include <harmful/doom/utils/Platform.hpp>
+#include "harmful/bane/components/TypeIndex.hpp"
+
+namespace Bane {
+    class CommandBuffer;
+
+    /// <summary>
+    /// Typed events exchanged between the Systems of a World.
+    /// </summary>
+    /// <remarks>
+    /// The Systems emit events in the CommandBuffer of their thread (see
+    /// CommandBuffer::emit()), without any lock. The World publishes them in
+    /// the bus when the CommandBuffers are applied, at the end of each stage,
+    /// stamped with a new version of the World. A System then reads the
+    /// events published since its last run (see System::events()): each
+    /// System sees each event once, the following stages in the same frame
+    /// and the previous ones at the next frame. The events are kept until
+    /// all the scheduled Systems have run since their publication.
+    ///
+    /// The events of a type are stored contiguously; the storage is kept
+    /// from a frame to another, so publishing does not allocate once it
+    /// reached its peak size.
+    /// </remarks>
+    class EventBus final {
+        private:
+            /// <summary>
+            /// Events published at a same version.
+            /// </summary>
+            struct Batch {
+                /// <summary>
+                /// Version of the World at the publication.
+                /// </summary>
+                uint32_t version;
+
+                /// <summary>
+                /// Index of the first event of the batch in its queue.
+                /// </summary>
+                size_t firstEvent;
+            };
+
+            /// <summary>
+            /// Published events of a type.
+            /// </summary>
+            struct Queue {
+                /// <summary>
+                /// Size of an event, in bytes.
+                /// </summary>
+                size_t eventSize = 0;
+
+                /// <summary>
+                /// Events, packed one after the other in their publication
+                /// order.
+                /// </summary>
+                std::vector<std::byte> events;
+
+                /// <summary>
+                /// Batches of events, by increasing version.
+                /// </summary>
+                std::vector<Batch> batches;
+            };
+
+            /// <summary>
+            /// Queue of each event type, by type identifier.
+            /// </summary>
+            std::vector<Queue> m_queues;
+
+        public:
+            /// <summary>
+            /// Create a new EventBus instance.
+            /// </summary>
+            exported EventBus() = default;
+
+            /// <summary>
+            /// Get the identifier of an event type.
+            /// </summary>
+            /// <typeparam name="EventClass">Type of the events.</typeparam>
+            /// <returns>Identifier of the type, from 0.</returns>
+            template <class EventClass>
+            exported static size_t TypeId() {
+                return TypeIndex<EventBus>::Of<EventClass>();
+            }
+
+            /// <summary>
+            /// Publish the events recorded in a CommandBuffer, in their
+            /// recording order.
+            /// </summary>
+            /// <param name="commands">CommandBuffer of the events.</param>
+            /// <param name="version">Version stamping the events.</param>
+            exported void publish(const CommandBuffer& commands, const uint32_t version);
+
+            /// <summary>
+            /// Get the events of a type published after a version.
+            /// </summary>
+            /// <typeparam name="EventClass">Type of the events.</typeparam>
+            /// <param name="version">
+            /// Version after which the events have been published; 0 for all
+            /// the kept events.
+            /// </param>
+            /// <returns>
+            /// The events, in their publication order. Valid until the next
+            /// publication.
+            /// </returns>
+            template <class EventClass>
+            exported std::span<const EventClass> since(const uint32_t version) const {
+                size_t typeId = TypeId<EventClass>();
+
+                if (typeId >= m_queues.size()) {
+                    return {};
+                }
+
+                auto& queue = m_queues[typeId];
+                size_t amountEvents = queue.batches.empty() ? 0 : (queue.events.size() / sizeof(EventClass));
+                size_t firstEvent = amountEvents;
+
+                for (auto batch = queue.batches.rbegin(); batch != queue.batches.rend(); ++batch) {
+                    if (batch -> version <= version) {
+                        break;
+                    }
+
+                    firstEvent = batch -> firstEvent;
+                }
+
+                // The storage of the queue is aligned for any event type.
+                auto events = std::launder(reinterpret_cast<const EventClass*>(queue.events.data()));
+                return std::span<const EventClass>(events + firstEvent, amountEvents - firstEvent);
+            }
+
+            /// <summary>
+            /// Remove the events published at or before a version.
+            /// </summary>
+            /// <param name="version">Version of the last events to remove.</param>
+            exported void prune(const uint32_t version);
+
+            /// <summary>
+            /// Remove all the events.
+            /// </summary>
+            exported void clear();
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,95 @@
+#ifndef __BANE_PREFAB__
+#define __BANE_PREFAB__
+
+#include <cstddef>
+#include <span>
+#include <vector>
+#include <harmful/doom/utils/Platform.hpp>
+#include "harmful/bane/entities/EntityRegistry.hpp"
+#include "harmful/bane/world/Prototype.hpp"
+
+namespace Bane {
+    /// <summary>
+    /// A Prototype compiled for a World, to instantiate the same Entities
+    /// many times (see World::instantiate() and CommandBuffer::instantiate()).
+    /// </summary>
+    /// <remarks>
+    /// The signature of the instances is computed once, and the Components
+    /// with initial data are cloned from it in bulk instead of being
+    /// constructed one by one. The Systems of the Prefab must outlive it.
+    /// </remarks>
+    class Prefab final {
+        private:
+            /// <summary>
+            /// Components of the instances.
+            /// </summary>
+            std::vector<Prototype::Part> m_parts;
+
+            /// <summary>
+            /// Initial data of the Components, packed one after the other.
+            /// </summary>
+            std::vector<std::byte> m_payloads;
+
+            /// <summary>
+            /// Signature of the instances in the registry of the World.
+            /// </summary>
+            EntityRegistry::Signature m_signature;
+
+            /// <summary>
+            /// Registry of the World owning the Systems; nullptr if the
+            /// Prefab has no Component.
+            /// </summary>
+            const EntityRegistry* m_registry = nullptr;
+
+        public:
+            /// <summary>
+            /// Create a new Prefab instance from a Prototype.
+            /// </summary>
+            /// <param name="prototype">Components of the instances.</param>
+            /// <exception cref="std::runtime_error">
+            /// A System is not set up or not owned by a World, the Systems
+            /// are owned by several Worlds, or an initial data does not match
+            /// the trivially copyable data type of its System.
+            /// </exception>
+            exported Prefab(const Prototype& prototype);
+
+            /// <summary>
+            /// Get the Components of the instances.
+            /// </summary>
+            /// <returns>The Components of the instances.</returns>
+            exported std::span<const Prototype::Part> parts() const {
+                return std::span<const Prototype::Part>(m_parts);
+            }
+
+            /// <summary>
+            /// Get the initial data of a Component.
+            /// </summary>
+            /// <param name="part">Component of the Prefab.</param>
+            /// <returns>
+            /// Initial data of the Component; nullptr to keep the default
+            /// data.
+            /// </returns>
+            exported const std::byte* payloadOf(const Prototype::Part& part) const {
+                return (part.payloadSize > 0) ? (m_payloads.data() + part.payloadOffset) : nullptr;
+            }
+
+            /// <summary>
+            /// Get the signature of the instances.
+            /// </summary>
+            /// <returns>Signature of the instances.</returns>
+            exported const EntityRegistry::Signature& signature() const {
+                return m_signature;
+            }
+
+            /// <summary>
+            /// Check if the Prefab can be instantiated in a World.
+            /// </summary>
+            /// <param name="registry">Registry of the World.</param>
+            /// <returns>true if it can; false otherwise.</returns>
+            exported bool belongsTo(const EntityRegistry& registry) const {
+                return !m_registry || (m_registry == &registry);
+            }
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,120 @@
+#ifndef __BANE_PROTOTYPE__
+#define __BANE_PROTOTYPE__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <vector>
+#include <harmful/doom/utils/Platform.hpp>
+#include "harmful/bane/components/ComponentData.hpp"
+
+namespace Bane {
+    class System;
+
+    /// <summary>
+    /// Describes the Components given to Entities created in bulk (see
+    /// World::createEntities()): the Systems owning them and their initial
+    /// data.
+    /// </summary>
+    class Prototype final {
+        public:
+            /// <summary>
+            /// A Component of the Prototype.
+            /// </summary>
+            struct Part {
+                /// <summary>
+                /// System owning the Component.
+                /// </summary>
+                System* system;
+
+                /// <summary>
+                /// Offset of the initial data in the payloads of the
+                /// Prototype.
+                /// </summary>
+                uint32_t payloadOffset;
+
+                /// <summary>
+                /// Size of the initial data; 0 to keep the default data.
+                /// </summary>
+                uint32_t payloadSize;
+            };
+
+        private:
+            /// <summary>
+            /// Components of the Prototype.
+            /// </summary>
+            std::vector<Part> m_parts;
+
+            /// <summary>
+            /// Initial data of the Components, packed one after the other.
+            /// </summary>
+            std::vector<std::byte> m_payloads;
+
+        public:
+            /// <summary>
+            /// Create a new Prototype instance, without Component.
+            /// </summary>
+            exported Prototype() = default;
+
+            /// <summary>
+            /// Add a Component with its default data.
+            /// </summary>
+            /// <param name="system">System owning the Component.</param>
+            /// <returns>The current Prototype.</returns>
+            exported Prototype& add(System* system) {
+                m_parts.push_back({ system, 0, 0 });
+                return *this;
+            }
+
+            /// <summary>
+            /// Add a Component with the given initial data.
+            /// </summary>
+            /// <typeparam name="DataClass">
+            /// Type of the data of the Component. It is copied byte by byte in
+            /// the new Components, so it must be trivially copyable.
+            /// </typeparam>
+            /// <param name="system">System owning the Component.</param>
+            /// <param name="data">Initial data of the Component.</param>
+            /// <returns>The current Prototype.</returns>
+            template <class DataClass>
+            exported Prototype& add(System* system, const DataClass& data) {
+                static_assert(
+                    std::is_base_of_v<ComponentData, DataClass>,
+                    "Only derived class from ComponentData can be used here."
+                );
+
+                static_assert(
+                    std::is_trivially_copyable_v<DataClass>,
+                    "Only trivially copyable data can be copied."
+                );
+
+                auto offset = static_cast<uint32_t>(m_payloads.size());
+                m_payloads.resize(m_payloads.size() + sizeof(DataClass));
+                std::memcpy(m_payloads.data() + offset, &data, sizeof(DataClass));
+
+                m_parts.push_back({ system, offset, static_cast<uint32_t>(sizeof(DataClass)) });
+                return *this;
+            }
+
+            /// <summary>
+            /// Get the Components of the Prototype.
+            /// </summary>
+            /// <returns>The Components of the Prototype.</returns>
+            exported std::span<const Part> parts() const {
+                return std::span<const Part>(m_parts);
+            }
+
+            /// <summary>
+            /// Get the initial data of a Component.
+            /// </summary>
+            /// <param name="part">Component of the Prototype.</param>
+            /// <returns>Initial data of the Component.</returns>
+            exported const std::byte* payloadOf(const Part& part) const {
+                return m_payloads.data() + part.payloadOffset;
+            }
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,320 @@
+#ifndef __BANE_QUERY__
+#define __BANE_QUERY__
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "harmful/bane/entities/Entity.hpp"
+#include "harmful/bane/entities/SparseSet.hpp"
+#include "harmful/bane/components/ComponentColumn.hpp"
+#include "harmful/bane/components/ComponentData.hpp"
+#include "harmful/bane/components/ComponentFactory.hpp"
+
+namespace Bane {
+    /// <summary>
+    /// Iterates the Entities bearing a Component of each of the given data
+    /// types, with their data.
+    /// </summary>
+    /// <typeparam name="DataClasses">
+    /// Types of ComponentData the Entities must bear.
+    /// </typeparam>
+    /// <remarks>
+    /// The smallest set of Components drives the iteration: it is walked
+    /// linearly and the other ones are only looked up through their sparse
+    /// set, without virtual calls. The Query only keeps pointers to the
+    /// ComponentFactory instances, so it can be built once and reused.
+    /// Components must not be created or destroyed while iterating.
+    /// For an Entity bearing several Components of a type, each Component
+    /// of the driving type is visited, with the first Component of the
+    /// other types.
+    /// 
+    /// The Components of the non-const data types are marked as changed
+    /// when visited. The Query can be restricted to the Components added or
+    /// changed since its previous iteration (see added() and changed()).
+    /// </remarks>
+    template <class... DataClasses>
+    class Query final {
+        static_assert(
+            sizeof...(DataClasses) > 0,
+            "A Query needs at least one ComponentData type."
+        );
+
+        static_assert(
+            (std::is_base_of_v<ComponentData, DataClasses> && ...),
+            "Only derived class from ComponentData can be used here."
+        );
+
+        public:
+            /// <summary>
+            /// Amount of data types of the Query.
+            /// </summary>
+            static constexpr size_t AmountTypes = sizeof...(DataClasses);
+
+        private:
+            /// <summary>
+            /// Restriction on the Components of a data type.
+            /// </summary>
+            enum class Filter : uint8_t {
+                None,
+                Added,
+                Changed
+            };
+
+            /// <summary>
+            /// ComponentFactory of each data type, in the order of the data
+            /// types. nullptr if no System stores a data type.
+            /// </summary>
+            std::array<ComponentFactory*, AmountTypes> m_factories;
+
+            /// <summary>
+            /// Restriction on the Components of each data type.
+            /// </summary>
+            std::array<Filter, AmountTypes> m_filters {};
+
+            /// <summary>
+            /// Version counter of the World.
+            /// </summary>
+            std::atomic<uint32_t>* m_version;
+
+            /// <summary>
+            /// Version of the Components at the previous iteration. 0 before
+            /// the first iteration, so that all the Components are new.
+            /// </summary>
+            uint32_t m_lastVersion = 0;
+
+        public:
+            /// <summary>
+            /// Create a new Query instance.
+            /// </summary>
+            /// <param name="factories">
+            /// ComponentFactory of each data type, in the order of the data
+            /// types.
+            /// </param>
+            /// <param name="version">Version counter of the World.</param>
+            exported Query(
+                const std::array<ComponentFactory*, AmountTypes>& factories,
+                std::atomic<uint32_t>& version
+            ) : m_factories(factories), m_version(&version) {}
+
+            /// <summary>
+            /// Only visit the Entities whose Component of the given type was
+            /// added since the previous iteration.
+            /// </summary>
+            /// <typeparam name="DataClass">Filtered data type.</typeparam>
+            /// <returns>The current Query.</returns>
+            template <class DataClass>
+            exported Query& added() {
+                static_assert(
+                    PositionOf<DataClass>() < AmountTypes,
+                    "The data type is not part of the Query."
+                );
+
+                m_filters[PositionOf<DataClass>()] = Filter::Added;
+                return *this;
+            }
+
+            /// <summary>
+            /// Only visit the Entities whose Component of the given type was
+            /// added or changed since the previous iteration.
+            /// </summary>
+            /// <typeparam name="DataClass">Filtered data type.</typeparam>
+            /// <returns>The current Query.</returns>
+            template <class DataClass>
+            exported Query& changed() {
+                static_assert(
+                    PositionOf<DataClass>() < AmountTypes,
+                    "The data type is not part of the Query."
+                );
+
+                m_filters[PositionOf<DataClass>()] = Filter::Changed;
+                return *this;
+            }
+
+            /// <summary>
+            /// Set the version the added() and changed() filters compare to,
+            /// for example System::lastRunVersion().
+            /// </summary>
+            /// <param name="version">Version of the previous iteration.</param>
+            exported void setLastVersion(const uint32_t version) {
+                m_lastVersion = version;
+            }
+
+            /// <summary>
+            /// Get the version of the Components at the previous iteration.
+            /// </summary>
+            /// <returns>Version of the previous iteration.</returns>
+            exported uint32_t lastVersion() const {
+                return m_lastVersion;
+            }
+
+            /// <summary>
+            /// Check if all the data types are stored by a System.
+            /// </summary>
+            /// <returns>
+            /// true if all the data types are stored; false if the Query
+            /// cannot match any Entity.
+            /// </returns>
+            exported bool isComplete() const {
+                for (auto& factory : m_factories) {
+                    if (!factory) {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            /// <summary>
+            /// Call a function on each matching Entity.
+            /// </summary>
+            /// <param name="function">
+            /// Function called with the Entity (optional) then a reference to
+            /// the data of each type: function(Entity, DataClasses&...) or
+            /// function(DataClasses&...).
+            /// </param>
+            template <class Function>
+            exported void each(Function&& function) {
+                if (!isComplete()) {
+                    return;
+                }
+
+                // The changes made after the iteration get a newer version.
+                uint32_t currentVersion = m_version -> load(std::memory_order_relaxed);
+                eachMatch(function, std::index_sequence_for<DataClasses...>{});
+                m_version -> fetch_add(1, std::memory_order_relaxed);
+                m_lastVersion = currentVersion;
+            }
+
+        private:
+            /// <summary>
+            /// Get the index of a data type in the data types of the Query.
+            /// </summary>
+            /// <typeparam name="DataClass">Wanted data type.</typeparam>
+            /// <returns>Index of the data type.</returns>
+            template <class DataClass>
+            static constexpr size_t PositionOf() {
+                constexpr bool isFound[] = {
+                    std::is_same_v<std::remove_const_t<DataClass>, std::remove_const_t<DataClasses>>...
+                };
+
+                for (size_t index = 0; index < AmountTypes; index++) {
+                    if (isFound[index]) {
+                        return index;
+                    }
+                }
+
+                return AmountTypes;
+            }
+
+            /// <summary>
+            /// Check if the Component at the given index of a data type
+            /// passes the filter of this data type.
+            /// </summary>
+            /// <param name="type">Index of the data type.</param>
+            /// <param name="slot">Index of the Component.</param>
+            /// <returns>true if it passes; false otherwise.</returns>
+            bool isPassing(const size_t type, const size_t slot) const {
+                auto& column = m_factories[type] -> components();
+
+                switch (m_filters[type]) {
+                    case Filter::Added:
+                        return column.addedVersionAt(slot) > m_lastVersion;
+
+                    case Filter::Changed:
+                        return column.changedVersionAt(slot) > m_lastVersion;
+
+                    default:
+                        return true;
+                }
+            }
+            /// <summary>
+            /// Get the index of the data type with the least Components.
+            /// </summary>
+            /// <returns>Index of the driving data type.</returns>
+            size_t driverIndex() const {
+                size_t driver = 0;
+
+                for (size_t type = 1; type < AmountTypes; type++) {
+                    if (m_factories[type] -> count() < m_factories[driver] -> count()) {
+                        driver = type;
+                    }
+                }
+
+                return driver;
+            }
+
+            /// <summary>
+            /// Walk the driving data type and call the function on each
+            /// Entity bearing all the other data types.
+            /// </summary>
+            template <class Function, size_t... Indices>
+            void eachMatch(Function& function, std::index_sequence<Indices...>) {
+                std::tuple<std::span<DataClasses>...> data {
+                    m_factories[Indices] -> components().template as<DataClasses>()...
+                };
+
+                const size_t driver = driverIndex();
+                const bool isDriverFiltered = m_filters[driver] != Filter::None;
+                auto& driverColumn = m_factories[driver] -> components();
+                auto driverEntities = driverColumn.entities();
+                std::array<size_t, AmountTypes> slots;
+
+                for (size_t index = 0; index < driverEntities.size(); index++) {
+                    // Skip the chunks of the driving type without any change.
+                    bool isChunkStart = (index % ComponentColumn::VersionChunkSize) == 0;
+
+                    if (isDriverFiltered && isChunkStart && (driverColumn.chunkVersionAt(index) <= m_lastVersion)) {
+                        index += ComponentColumn::VersionChunkSize - 1;
+                        continue;
+                    }
+
+                    Entity entity(driverEntities[index]);
+                    bool isMatching = true;
+
+                    for (size_t type = 0; type < AmountTypes; type++) {
+                        slots[type] = (type == driver)
+                            ? index
+                            : m_factories[type] -> indexOf(entity);
+
+                        if ((slots[type] == SparseSet::InvalidIndex) || !isPassing(type, slots[type])) {
+                            isMatching = false;
+                            break;
+                        }
+                    }
+
+                    if (!isMatching) {
+                        continue;
+                    }
+
+                    if constexpr (std::is_invocable_v<Function&, Entity, DataClasses&...>) {
+                        function(entity, std::get<Indices>(data)[slots[Indices]]...);
+                    }
+                    else {
+                        function(std::get<Indices>(data)[slots[Indices]]...);
+                    }
+
+                    (markChanged<DataClasses>(Indices, slots[Indices]), ...);
+                }
+            }
+
+            /// <summary>
+            /// Mark a visited Component as changed if its data type is not
+            /// const.
+            /// </summary>
+            /// <param name="type">Index of the data type.</param>
+            /// <param name="slot">Index of the Component.</param>
+            template <class DataClass>
+            void markChanged(const size_t type, const size_t slot) {
+                if constexpr (!std::is_const_v<DataClass>) {
+                    m_factories[type] -> markChanged(slot);
+                }
+            }
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,90 @@
+#ifndef __BANE_SNAPSHOT__
+#define __BANE_SNAPSHOT__
+
+#include <cstdint>
+#include <filesystem>
+#include <harmful/doom/utils/Platform.hpp>
+
+namespace Bane {
+    class World;
+
+    /// <summary>
+    /// Binary checkpoint of the whole state of a World: the EntityFactory,
+    /// the living Entities and the Components of every set up System.
+    /// </summary>
+    /// <remarks>
+    /// The Components of a System are written as two contiguous blobs (their
+    /// Entity IDs then their data), aligned on BlobAlignment bytes. Loading
+    /// maps the file in memory and copies each blob at once in the storage of
+    /// its System: the data are never deserialised one by one, so only
+    /// trivially copyable data types can be saved. The file uses the
+    /// endianness of the processor.
+    /// </remarks>
+    class Snapshot final {
+        public:
+            /// <summary>
+            /// Version of the file format, increased on each incompatible
+            /// change.
+            /// </summary>
+            static constexpr int32_t FormatVersion = 1;
+
+            /// <summary>
+            /// Alignment of the blobs in the file, in bytes.
+            /// </summary>
+            static constexpr size_t BlobAlignment = 64;
+
+            /// <summary>
+            /// Save the state of a World in a file. Must not be called while
+            /// the World is running.
+            /// </summary>
+            /// <param name="world">World to save.</param>
+            /// <param name="path">Path of the file to write.</param>
+            /// <exception cref="std::runtime_error">
+            /// A System stores data that are not trivially copyable.
+            /// </exception>
+            /// <exception cref="std::ios_base::failure">
+            /// The file cannot be written.
+            /// </exception>
+            exported static void Save(const World& world, const std::filesystem::path& path);
+
+            /// <summary>
+            /// Replace the state of a World by the one saved in a file. The
+            /// saved Systems must already be registered and set up in the
+            /// World, under the same names and with the same data types.
+            /// Must not be called while the World is running.
+            /// </summary>
+            /// <param name="world">World to restore.</param>
+            /// <param name="path">Path of the file to read.</param>
+            /// <exception cref="std::runtime_error">
+            /// The file is not a valid snapshot or does not match the Systems
+            /// of the World. The World is left untouched in that case.
+            /// </exception>
+            /// <exception cref="std::ios_base::failure">
+            /// The file cannot be read.
+            /// </exception>
+            exported static void Load(World& world, const std::filesystem::path& path);
+
+            /// <summary>
+            /// Replace the state of a World by the one of another World,
+            /// without going through a file: the blobs of each System are
+            /// copied at once from one storage to the other. The Systems of
+            /// the source must be registered and set up in the target, under
+            /// the same names and with the same data types. None of the
+            /// Worlds may be running.
+            /// </summary>
+            /// <param name="source">World to copy.</param>
+            /// <param name="target">World to replace the state of.</param>
+            /// <exception cref="std::runtime_error">
+            /// A System of the source stores data that are not trivially
+            /// copyable or does not match the Systems of the target. The
+            /// target is left untouched in that case.
+            /// </exception>
+            exported static void Copy(const World& source, World& target);
+
+        private:
+            // Only static methods.
+            Snapshot() = delete;
+    };
+}
+
+#endif
\ No newline at end of file
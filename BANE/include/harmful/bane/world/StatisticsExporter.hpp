@@ -0,0 +1,43 @@
+#ifndef __BANE_STATISTICS_EXPORTER__
+#define __BANE_STATISTICS_EXPORTER__
+
+#include <ostream>
+#include <harmful/doom/utils/Platform.hpp>
+
+namespace Bane {
+    class World;
+
+    /// <summary>
+    /// Write the timings of the last frame of each Job of a World (see
+    /// World::statistics()) in a text format, to be analysed by other tools.
+    /// </summary>
+    /// <remarks>
+    /// Times are in nanoseconds. Must not be called while the World is
+    /// running.
+    /// </remarks>
+    class StatisticsExporter final {
+        public:
+            /// <summary>
+            /// Write the timings as CSV, with a header line. Each Job gets a
+            /// line per thread (empty System) then a line per System and per
+            /// thread (empty wait time).
+            /// </summary>
+            /// <param name="world">World to export.</param>
+            /// <param name="stream">Stream to write to.</param>
+            exported static void WriteCSV(const World& world, std::ostream& stream);
+
+            /// <summary>
+            /// Write the timings as a JSON document: an array of Jobs, each
+            /// with its timings per thread and per System and per thread.
+            /// </summary>
+            /// <param name="world">World to export.</param>
+            /// <param name="stream">Stream to write to.</param>
+            exported static void WriteJSON(const World& world, std::ostream& stream);
+
+        private:
+            // Only static methods.
+            StatisticsExporter() = delete;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,84 @@
+#ifndef __BANE_SYSTEM_GRAPH__
+#define __BANE_SYSTEM_GRAPH__
+
+#include <vector>
+#include <harmful/doom/utils/Platform.hpp>
+#include "harmful/bane/systems/System.hpp"
+
+namespace Bane {
+    /// <summary>
+    /// Dependency graph of Systems, built from the Components they read and
+    /// write and from their links. The Systems are split into stages: the
+    /// Systems of a same stage do not conflict and can run at the same time,
+    /// a stage only starts once the previous one is finished.
+    /// </summary>
+    /// <remarks>
+    /// Two conflicting Systems run in their registration order, unless one
+    /// is linked to the other: the linked System (the dependency) runs first.
+    /// The order of the Systems in a stage follows the registration order,
+    /// so that the topological order is stable.
+    /// </remarks>
+    class SystemGraph final {
+        private:
+            /// <summary>
+            /// Systems of the graph, in their registration order.
+            /// </summary>
+            std::vector<System*> m_systems;
+
+            /// <summary>
+            /// Indices of the Systems that must run after each System.
+            /// </summary>
+            std::vector<std::vector<size_t>> m_successors;
+
+            /// <summary>
+            /// Stages of Systems that can run at the same time.
+            /// </summary>
+            std::vector<std::vector<System*>> m_stages;
+
+        public:
+            /// <summary>
+            /// Create a new SystemGraph instance.
+            /// </summary>
+            exported SystemGraph() = default;
+
+            /// <summary>
+            /// Build the graph and its stages.
+            /// </summary>
+            /// <param name="systems">
+            /// Systems of the graph, in their registration order.
+            /// </param>
+            /// <remarks>
+            /// A std::runtime_error is thrown if the links between the Systems
+            /// are cyclic.
+            /// </remarks>
+            exported void build(const std::vector<System*>& systems);
+
+            /// <summary>
+            /// Get the stages of Systems, in their execution order.
+            /// </summary>
+            /// <returns>Stages of Systems.</returns>
+            exported const std::vector<std::vector<System*>>& stages() const {
+                return m_stages;
+            }
+
+            /// <summary>
+            /// Get the Systems of the graph in a stable topological order.
+            /// </summary>
+            /// <returns>Ordered Systems.</returns>
+            exported std::vector<System*> order() const;
+
+        private:
+            /// <summary>
+            /// Add the edges between the Systems.
+            /// </summary>
+            void computeEdges();
+
+            /// <summary>
+            /// Split the Systems into stages (Kahn's algorithm, level by
+            /// level).
+            /// </summary>
+            void computeStages();
+    };
+}
+
+#endif
\ No newline at end of file
@@ -1,15 +1,31 @@
 #ifndef __BANE_WORLD__
 #define __BANE_WORLD__
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <type_traits>
+#include <typeinfo>
 #include <memory>
 #include <list>
-#include <set>
+#include <stdexcept>
 #include <unordered_map>
+#include <vector>
+#include <harmful/doom/utils/Chrono.hpp>
 #include <harmful/doom/utils/Platform.hpp>
 #include "harmful/bane/entities/EntityFactory.hpp"
+#include "harmful/bane/entities/EntityRegistry.hpp"
+#include "harmful/bane/components/TypeIndex.hpp"
 #include "harmful/bane/systems/System.hpp"
+#include "harmful/bane/jobs/AsyncIO.hpp"
 #include "harmful/bane/jobs/Job.hpp"
+#include "harmful/bane/world/Assets.hpp"
+#include "harmful/bane/world/CommandBuffer.hpp"
+#include "harmful/bane/world/EventBus.hpp"
+#include "harmful/bane/world/Prefab.hpp"
+#include "harmful/bane/world/Prototype.hpp"
+#include "harmful/bane/world/Query.hpp"
+#include "harmful/bane/world/SystemGraph.hpp"
 
 namespace Bane {
     /// <summary>
@@ -18,28 +34,214 @@ namespace Bane {
     /// all the Components attached to an Entity when this one is deleted.
     /// </summary>
     class World final {
+        friend class Snapshot;
+        friend class StatisticsExporter;
+        friend class WorldGroup;
+
         private:
+            /// <summary>
+            /// Minimal amount of Components filled by a thread in
+            /// createEntities().
+            /// </summary>
+            static constexpr size_t MinimalFillSize = 4096;
+
+            /// <summary>
+            /// Default simulation timestep of tick() (60 Hz).
+            /// </summary>
+            static constexpr std::chrono::nanoseconds DefaultTimestep { 16666667 };
+
+            /// <summary>
+            /// Default maximal amount of steps run by a single tick().
+            /// </summary>
+            static constexpr size_t DefaultMaxCatchUpSteps = 5;
+
+            /// <summary>
+            /// Rate at which the Systems of a Job are run by tick().
+            /// </summary>
+            struct JobPacing {
+                /// <summary>
+                /// Simulated time between two runs of the Job; 0 to run it at
+                /// each step.
+                /// </summary>
+                std::chrono::nanoseconds period { 0 };
+
+                /// <summary>
+                /// Simulated time since the last run of the Job.
+                /// </summary>
+                std::chrono::nanoseconds accumulated { 0 };
+            };
+
             /// <summary>
             /// Factory for creating all the Entities in the application.
             /// </summary>
             EntityFactory m_entities;
 
             /// <summary>
-            /// List of the Entities currently active in the application.
+            /// Entities currently active in the application, with the Systems
+            /// holding their Components (bit = index in m_systemOrder).
             /// </summary>
-            std::set<Entity> m_entityList;
+            EntityRegistry m_registry;
 
             /// <summary>
             /// List of the Systems in the application.
             /// </summary>
             std::unordered_map<std::string, std::unique_ptr<System>> m_systems;
 
+            /// <summary>
+            /// First System created for each System class, by identifier of
+            /// the class (see TypeIndex); nullptr for the classes without
+            /// System.
+            /// </summary>
+            std::vector<System*> m_systemsByClass;
+
+            /// <summary>
+            /// System storing each data type, by identifier of the type (see
+            /// TypeIndex). Filled by factoryOf() on the first lookup of each
+            /// type.
+            /// </summary>
+            std::vector<System*> m_systemsByType;
+
             /// <summary>
             /// List of the Jobs in the application.
             /// </summary>
             std::unordered_map<std::string, std::unique_ptr<Job>> m_jobs;
 
+            /// <summary>
+            /// Systems in their registration order.
+            /// </summary>
+            std::vector<System*> m_systemOrder;
+
+            /// <summary>
+            /// Jobs in their registration order.
+            /// </summary>
+            std::vector<Job*> m_jobOrder;
+
+            /// <summary>
+            /// Dependency graph of the Systems run by the Jobs.
+            /// </summary>
+            SystemGraph m_schedule;
+
+            /// <summary>
+            /// Systems of each stage of m_schedule, per Job (in the order of
+            /// m_jobOrder). A System used by several Jobs is run by the first
+            /// one only.
+            /// </summary>
+            std::vector<std::vector<std::vector<System*>>> m_stagesPerJob;
+
+            /// <summary>
+            /// true if the Systems or Jobs changed since m_schedule has been
+            /// built.
+            /// </summary>
+            bool m_isScheduleDirty = true;
+
+            /// <summary>
+            /// Sum of the access versions of the Systems when m_schedule has
+            /// been built, to detect changes of their accesses.
+            /// </summary>
+            uint64_t m_scheduleAccessVersion = 0;
+
+            /// <summary>
+            /// Commands of all the Jobs, merged after each stage.
+            /// </summary>
+            CommandBuffer m_commands { m_entities };
+
+            /// <summary>
+            /// Events published by the applied CommandBuffers.
+            /// </summary>
+            EventBus m_events;
+
+            /// <summary>
+            /// I/O threads of the SystemTasks. Destroyed before the Jobs and
+            /// Systems, once the queued operations are run.
+            /// </summary>
+            AsyncIO m_io;
+
+            /// <summary>
+            /// Threads shared with other Worlds running the Jobs added
+            /// afterwards; nullptr for Jobs with their own threads.
+            /// </summary>
+            std::shared_ptr<WorkerPool> m_threads;
+
+            /// <summary>
+            /// Immutable data shared with other Worlds; nullptr if none.
+            /// </summary>
+            std::shared_ptr<const Assets> m_assets;
+
+            /// <summary>
+            /// Systems run by a Job, in the order of m_systemOrder.
+            /// </summary>
+            std::vector<System*> m_scheduledSystems;
+
+            /// <summary>
+            /// Version given to the Components added or changed, incremented
+            /// before each stage of Systems, after each frame and after each
+            /// iteration of a Query.
+            /// </summary>
+            std::atomic<uint32_t> m_version { 1 };
+
+            /// <summary>
+            /// true if run() must give the same results whatever the threads.
+            /// </summary>
+            bool m_isDeterministic = false;
+
+            /// <summary>
+            /// Seed of the random streams of the chunks.
+            /// </summary>
+            uint64_t m_seed = 0;
+
+            /// <summary>
+            /// Clock measuring the real time between two calls to tick().
+            /// </summary>
+            Doom::Chrono m_clock;
+
+            /// <summary>
+            /// Time of m_clock at the last call to tick(), in nanoseconds.
+            /// </summary>
+            std::intmax_t m_lastTickTime = 0;
+
+            /// <summary>
+            /// Simulated time of a step.
+            /// </summary>
+            std::chrono::nanoseconds m_timestep = DefaultTimestep;
+
+            /// <summary>
+            /// Maximal amount of steps run by a single tick(): the real time
+            /// beyond is dropped so that a slow frame does not make the next
+            /// ones even slower.
+            /// </summary>
+            size_t m_maxCatchUpSteps = DefaultMaxCatchUpSteps;
+
+            /// <summary>
+            /// Real time not simulated yet (less than a step after tick()).
+            /// </summary>
+            std::chrono::nanoseconds m_accumulator { 0 };
+
+            /// <summary>
+            /// Fraction of a step in m_accumulator after the last tick().
+            /// </summary>
+            double m_interpolation = 0.;
+
+            /// <summary>
+            /// Amount of steps run by tick() so far.
+            /// </summary>
+            uint64_t m_amountSteps = 0;
+
+            /// <summary>
+            /// Rate of each Job, in the order of m_jobOrder.
+            /// </summary>
+            std::vector<JobPacing> m_jobPacing;
+
+            /// <summary>
+            /// Jobs to run at the current step, in the order of m_jobOrder.
+            /// </summary>
+            std::vector<bool> m_dueJobs;
+
         public:
+            /// <summary>
+            /// Create a new World instance.
+            /// </summary>
+            exported World() = default;
+
             // No copy nor move constructors.
             exported World(const World& other) = delete;
             exported World(World&& other) = delete;
@@ -50,7 +252,8 @@ namespace Bane {
             exported virtual ~World() noexcept;
 
             /// <summary>
-            /// Clear all data of the current World.
+            /// Clear all data of the current World. Each System is cleared in
+            /// a single pass, then the Entities are destroyed.
             /// </summary>
             exported void clear();
 
@@ -60,6 +263,45 @@ namespace Bane {
             /// <returns>The created Entity instance.</returns>
             exported Entity createEntity();
 
+            /// <summary>
+            /// Create several Entities at once, with the Components of a
+            /// Prototype. The storage of each System grows at most once and
+            /// the initial data are copied in parallel by the threads of the
+            /// Job running the System.
+            /// </summary>
+            /// <param name="amount">Amount of Entities to create.</param>
+            /// <param name="prototype">Components of the new Entities.</param>
+            /// <returns>The created Entities.</returns>
+            /// <remarks>
+            /// Must not be called while the World is running: the Systems
+            /// record their structural changes in CommandBuffers instead.
+            /// </remarks>
+            exported std::vector<Entity> createEntities(
+                const size_t amount,
+                const Prototype& prototype = Prototype()
+            );
+
+            /// <summary>
+            /// Create several Entities at once, with the Components of a
+            /// Prefab. Each Entity gets its signature once, and the Components
+            /// with initial data are cloned in bulk without being
+            /// constructed.
+            /// </summary>
+            /// <param name="prefab">Prefab to instantiate.</param>
+            /// <param name="amount">Amount of Entities to create.</param>
+            /// <returns>The created Entities.</returns>
+            /// <exception cref="std::runtime_error">
+            /// The Prefab is compiled from the Systems of another World.
+            /// </exception>
+            /// <remarks>
+            /// Must not be called while the World is running: the Systems
+            /// record their instantiations in CommandBuffers instead.
+            /// </remarks>
+            exported std::vector<Entity> instantiate(
+                const Prefab& prefab,
+                const size_t amount
+            );
+
             /// <summary>
             /// Get a System by its name. If it does not exist, it is created.
             /// </summary>
@@ -71,6 +313,75 @@ namespace Bane {
             template <class SystemClass>
             exported SystemClass* system(const std::string& name);
 
+            /// <summary>
+            /// Get the first System created for a System class, without
+            /// looking up its name.
+            /// </summary>
+            /// <typeparam name="SystemClass">
+            /// Class of the System to get. Must inherit the System class.
+            /// </typeparam>
+            /// <returns>
+            /// Pointer to the wanted system; nullptr if none has been created.
+            /// </returns>
+            template <class SystemClass>
+            exported SystemClass* system() const {
+                static_assert(
+                    std::is_base_of_v<System, SystemClass>,
+                    "Only derived class from System can be used here."
+                );
+
+                uint32_t classId = TypeIndex<System>::Of<SystemClass>();
+                return (classId < m_systemsByClass.size())
+                    ? static_cast<SystemClass*>(m_systemsByClass[classId])
+                    : nullptr;
+            }
+
+            /// <summary>
+            /// Get a Query over the Entities bearing a Component of each of
+            /// the given data types. The Systems storing the data types must
+            /// be set up.
+            /// </summary>
+            /// <typeparam name="DataClasses">
+            /// Types of ComponentData the Entities must bear.
+            /// </typeparam>
+            /// <returns>The Query.</returns>
+            template <class... DataClasses>
+            exported Query<DataClasses...> query() {
+                bindVersion();
+                return Query<DataClasses...>(
+                    { factoryOf(TypeIndex<ComponentData>::Of<DataClasses>())... },
+                    m_version
+                );
+            }
+
+            /// <summary>
+            /// Get the packed IDs of the Entities currently active.
+            /// </summary>
+            /// <returns>Contiguous range of the Entity IDs.</returns>
+            exported std::span<const id_t> entities() const {
+                return m_registry.entities();
+            }
+
+            /// <summary>
+            /// Get the Systems holding Components for an Entity.
+            /// </summary>
+            /// <param name="entity">Entity to get the signature.</param>
+            /// <returns>
+            /// Signature of the Entity, a bit per System in their registration
+            /// order; an empty one if the Entity is not active.
+            /// </returns>
+            exported EntityRegistry::Signature signatureOf(const Entity& entity) const {
+                return m_registry.signatureOf(entity);
+            }
+
+            /// <summary>
+            /// Get the version given to the Components added or changed.
+            /// </summary>
+            /// <returns>Current version.</returns>
+            exported uint32_t version() const {
+                return m_version.load(std::memory_order_relaxed);
+            }
+
             /// <summary>
             /// Add a Job used to run Systems concurrently.
             /// </summary>
@@ -81,10 +392,21 @@ namespace Bane {
             /// <param name="threadCount">
             /// Amount of threads required to perform the new Job.
             /// </param>
+            /// <param name="placement">
+            /// Where the threads of the new Job run. With any policy but
+            /// None, the Components of its Systems are first touched by its
+            /// threads.
+            /// </param>
+            /// <remarks>
+            /// If the World has shared threads (see setThreads()), the Job
+            /// runs on them: the amount of threads and the placement are
+            /// ignored.
+            /// </remarks>
             exported void addJob(
                 const std::string& name,
                 std::list<std::string>& systemNames,
-                const uint8_t threadCount
+                const uint8_t threadCount,
+                const ThreadPlacement& placement = ThreadPlacement()
             );
 
             /// <summary>
@@ -93,27 +415,362 @@ namespace Bane {
             /// <param name="entity">ID of the Entity to delete.</param>
             /// <returns></returns>
             exported void destroy(const Entity& entity);
-            
+
+            /// <summary>
+            /// Apply the commands of a CommandBuffer in a single pass, sorted
+            /// by type then by Entity: Entities are created first, then the
+            /// Components are added and removed, then the Entities are
+            /// destroyed. Its events are published, stamped with a new
+            /// version. The CommandBuffer is cleared.
+            /// </summary>
+            /// <param name="commands">Commands to apply.</param>
+            exported void apply(CommandBuffer& commands);
+
+            /// <summary>
+            /// Get the events published by the applied CommandBuffers and not
+            /// read by all the scheduled Systems yet.
+            /// </summary>
+            /// <returns>Events of the World.</returns>
+            exported const EventBus& events() const {
+                return m_events;
+            }
+
             /// <summary>
             /// Run all the registered Jobs/Systems in the World.
+            /// The Systems are run stage by stage: Systems that do not conflict
+            /// (see System::conflictsWith()) run at the same time, on the
+            /// threads of their Jobs. The commands recorded by the Systems are
+            /// applied at the end of each stage.
             /// </summary>
             exported void run();
 
             /// <summary>
-            /// Stop all the Jobs.
+            /// Enable or disable the deterministic (lockstep) mode. From the
+            /// same state, run() then gives bit-identical results whatever
+            /// the amount of threads and their timing:
+            /// - the Jobs and the Systems run in their registration order;
+            /// - the chunks only depend on the amount of Components;
+            /// - each chunk draws from its own random stream, seeded from the
+            ///   seed, the version of the World and the position of the chunk;
+            /// - the commands are collected in the order of the chunks;
+            /// - each chunk creates its Entities from its own stream of IDs
+            ///   (see EntityFactory::beginReservation()), so their IDs can be
+            ///   stored in Component data and events.
+            /// The chunks are still processed in parallel.
+            /// </summary>
+            /// <param name="deterministic">true to enable.</param>
+            /// <param name="seed">Seed of the random streams.</param>
+            /// <remarks>
+            /// The Systems must only rely on their range of Components, the
+            /// random stream of their CommandBuffer and the data of the World
+            /// (no global state, no data written by another chunk).
+            /// </remarks>
+            exported void setDeterministic(const bool deterministic, const uint64_t seed = 0);
+
+            /// <summary>
+            /// Check if the deterministic mode is enabled.
+            /// </summary>
+            /// <returns>true if enabled; false otherwise.</returns>
+            exported bool isDeterministic() const {
+                return m_isDeterministic;
+            }
+
+            /// <summary>
+            /// Advance the simulation by the real time elapsed since the last
+            /// call, in fixed steps: each step runs the Jobs that are due (see
+            /// setTickRate()). The time left (less than a step) is kept for the
+            /// next call and exposed by interpolation().
+            /// </summary>
+            /// <returns>Amount of steps run.</returns>
+            /// <remarks>
+            /// The first call starts the clock and runs no step. At most
+            /// maxCatchUpSteps() steps are run by a call: a late frame drops
+            /// the time it cannot catch up with.
+            /// </remarks>
+            exported size_t tick();
+
+            /// <summary>
+            /// Call tick() during the given real time, sleeping between the
+            /// steps instead of spinning.
+            /// </summary>
+            /// <param name="duration">Real time to run the World.</param>
+            exported void runFor(const std::chrono::nanoseconds duration);
+
+            /// <summary>
+            /// Set the simulated time of a step of tick().
+            /// </summary>
+            /// <param name="timestep">Duration of a step, above zero.</param>
+            exported void setTimestep(const std::chrono::nanoseconds timestep);
+
+            /// <summary>
+            /// Get the simulated time of a step of tick().
+            /// </summary>
+            /// <returns>Duration of a step.</returns>
+            exported std::chrono::nanoseconds timestep() const {
+                return m_timestep;
+            }
+
+            /// <summary>
+            /// Set the maximal amount of steps run by a single tick().
+            /// </summary>
+            /// <param name="amountSteps">Amount of steps, at least 1.</param>
+            exported void setMaxCatchUpSteps(const size_t amountSteps) {
+                m_maxCatchUpSteps = std::max<size_t>(amountSteps, 1);
+            }
+
+            /// <summary>
+            /// Get the maximal amount of steps run by a single tick().
+            /// </summary>
+            /// <returns>Amount of steps.</returns>
+            exported size_t maxCatchUpSteps() const {
+                return m_maxCatchUpSteps;
+            }
+
+            /// <summary>
+            /// Set the rate at which tick() runs the Systems of a Job, in
+            /// simulated time. A Job runs at most once per step: a rate above
+            /// the one of the steps runs it at each step.
+            /// </summary>
+            /// <param name="jobName">Name of the Job.</param>
+            /// <param name="hertz">
+            /// Amount of runs per second; 0 to run the Job at each step.
+            /// </param>
+            exported void setTickRate(const std::string& jobName, const double hertz);
+
+            /// <summary>
+            /// Get the simulated time between two runs of a Job by tick(), to
+            /// be used as the delta time of its Systems.
+            /// </summary>
+            /// <param name="jobName">Name of the Job.</param>
+            /// <returns>
+            /// Time between two runs; the timestep if the Job runs at each
+            /// step or does not exist.
+            /// </returns>
+            exported std::chrono::nanoseconds tickPeriod(const std::string& jobName) const;
+
+            /// <summary>
+            /// Get the fraction of a step elapsed since the last simulated
+            /// step, to interpolate the rendered state between the last two
+            /// steps.
+            /// </summary>
+            /// <returns>Interpolation factor, in [0, 1).</returns>
+            exported double interpolation() const {
+                return m_interpolation;
+            }
+
+            /// <summary>
+            /// Get the amount of steps run by tick() so far.
+            /// </summary>
+            /// <returns>Amount of steps.</returns>
+            exported uint64_t amountSteps() const {
+                return m_amountSteps;
+            }
+
+            /// <summary>
+            /// Get the timings of the last frame of a Job (last call to run()
+            /// or last step of tick() running the Job).
+            /// </summary>
+            /// <param name="jobName">Name of the Job.</param>
+            /// <returns>Timings of the Job; nullptr if it does not exist.</returns>
+            exported const JobStatistics* statistics(const std::string& jobName) const;
+
+            /// <summary>
+            /// Get the signal raised at the end of each frame of a Job, for
+            /// SystemTasks to wait for the Job.
+            /// </summary>
+            /// <param name="jobName">Name of the Job.</param>
+            /// <returns>Signal of the Job; nullptr if it does not exist.</returns>
+            exported AsyncSignal* completion(const std::string& jobName);
+
+            /// <summary>
+            /// Get the I/O threads running the operations awaited by the
+            /// SystemTasks.
+            /// </summary>
+            /// <returns>I/O threads of the World.</returns>
+            exported AsyncIO& io() {
+                return m_io;
+            }
+
+            /// <summary>
+            /// Get the stages of Systems run by run(), in their execution
+            /// order.
+            /// </summary>
+            /// <returns>Stages of Systems.</returns>
+            exported const std::vector<std::vector<System*>>& stages();
+
+            /// <summary>
+            /// Stop all the Jobs. Shared threads are left running.
             /// </summary>
             exported void stop();
 
+            /// <summary>
+            /// Run the Jobs added afterwards on threads shared with other
+            /// Worlds, instead of threads of their own.
+            /// </summary>
+            /// <param name="threads">
+            /// Shared threads; nullptr to give the next Jobs their own
+            /// threads.
+            /// </param>
+            exported void setThreads(std::shared_ptr<WorkerPool> threads) {
+                m_threads = std::move(threads);
+            }
+
+            /// <summary>
+            /// Share immutable data with the Systems (see System::assets()).
+            /// Must not be called while the World is running.
+            /// </summary>
+            /// <param name="assets">Shared Assets; nullptr for none.</param>
+            exported void setAssets(std::shared_ptr<const Assets> assets) {
+                m_assets = std::move(assets);
+            }
+
+            /// <summary>
+            /// Get the immutable data shared with other Worlds.
+            /// </summary>
+            /// <returns>The shared Assets; nullptr if none.</returns>
+            exported const std::shared_ptr<const Assets>& assets() const {
+                return m_assets;
+            }
+
             // No copy nor move assignment operator.
             World& operator=(const World& other) = delete;
             World& operator=(World&& other) = delete;
 
         private:
             /// <summary>
-            /// Remove an Entity from the Systems using it.
+            /// Remove an Entity from the Systems holding Components for it,
+            /// according to its signature.
             /// </summary>
             /// <param name="entity">ID of the Entity to delete.</param>
             void removeEntity(const Entity& entity);
+
+            /// <summary>
+            /// Run the Systems of some of the Jobs, stage by stage.
+            /// </summary>
+            /// <param name="dueJobs">
+            /// true for each Job to run, in the order of m_jobOrder.
+            /// </param>
+            void runStages(const std::vector<bool>& dueJobs);
+
+            /// <summary>
+            /// Submit the Systems of a stage to the threads of their Jobs.
+            /// </summary>
+            /// <param name="stageIndex">Index of the stage.</param>
+            /// <param name="dueJobs">
+            /// true for each Job to run, in the order of m_jobOrder.
+            /// </param>
+            void submitStage(const size_t stageIndex, const std::vector<bool>& dueJobs);
+
+            /// <summary>
+            /// Wait for the Systems of a stage submitted by submitStage(),
+            /// then apply their commands.
+            /// </summary>
+            /// <param name="stageIndex">Index of the stage.</param>
+            /// <param name="dueJobs">
+            /// true for each Job to run, in the order of m_jobOrder.
+            /// </param>
+            void finishStage(const size_t stageIndex, const std::vector<bool>& dueJobs);
+
+            /// <summary>
+            /// End the frame of the Jobs run by runStages().
+            /// </summary>
+            /// <param name="dueJobs">
+            /// true for each Job to run, in the order of m_jobOrder.
+            /// </param>
+            void finishStages(const std::vector<bool>& dueJobs);
+
+            /// <summary>
+            /// Run a step of tick(): the Jobs whose period has elapsed.
+            /// </summary>
+            void step();
+
+            /// <summary>
+            /// Find the Jobs whose period elapses at the next step, in
+            /// m_dueJobs.
+            /// </summary>
+            void paceJobs();
+
+            /// <summary>
+            /// Give the Components of a Prefab to new Entities.
+            /// </summary>
+            /// <param name="prefab">Prefab to instantiate.</param>
+            /// <param name="entities">
+            /// Created Entities, not registered yet.
+            /// </param>
+            void instantiate(const Prefab& prefab, std::span<const Entity> entities);
+
+            /// <summary>
+            /// Copy an initial data in a range of Components of a System,
+            /// on the threads of the Job running the System if any.
+            /// </summary>
+            /// <param name="system">System owning the Components.</param>
+            /// <param name="fromIndex">Start index of the range.</param>
+            /// <param name="toIndex">End index (excluded) of the range.</param>
+            /// <param name="payload">Initial data to copy.</param>
+            void fillComponents(
+                System* system,
+                const size_t fromIndex,
+                const size_t toIndex,
+                const std::byte* payload
+            );
+
+            /// <summary>
+            /// Copy an initial data in a chunk of Components.
+            /// </summary>
+            /// <param name="worker">ThreadJob filling the chunk.</param>
+            /// <param name="task">The chunk to fill.</param>
+            static void FillChunk(ThreadJob& worker, const ThreadTask& task);
+
+            /// <summary>
+            /// Get the ComponentFactory storing a data type.
+            /// </summary>
+            /// <param name="typeId">
+            /// Identifier of the type of ComponentData (see TypeIndex).
+            /// </param>
+            /// <returns>
+            /// The ComponentFactory; nullptr if no set up System stores the
+            /// data type.
+            /// </returns>
+            ComponentFactory* factoryOf(const uint32_t typeId);
+
+            /// <summary>
+            /// Bind the Components of all the set up Systems to the version of
+            /// the World.
+            /// </summary>
+            void bindVersion();
+
+            /// <summary>
+            /// Bind the Components of all the set up Systems to the threads of
+            /// the placed Job running them, if any.
+            /// </summary>
+            void bindWorkers();
+
+            /// <summary>
+            /// Remove the events read by all the scheduled Systems.
+            /// </summary>
+            void pruneEvents();
+
+            /// <summary>
+            /// Create the Entities instantiated by sorted commands, in bulk
+            /// for each Prefab.
+            /// </summary>
+            /// <param name="commands">Sorted commands.</param>
+            /// <exception cref="std::runtime_error">
+            /// A Prefab is compiled from the Systems of another World.
+            /// </exception>
+            void applyInstances(const CommandBuffer& commands);
+
+            /// <summary>
+            /// Rebuild the dependency graph of the Systems if the Systems,
+            /// the Jobs or the accesses of the Systems changed.
+            /// </summary>
+            void updateSchedule();
+
+            /// <summary>
+            /// Get the sum of the access versions of the Systems.
+            /// </summary>
+            /// <returns>Sum of the access versions.</returns>
+            uint64_t accessVersion() const;
     };
 
     template <class SystemClass>
@@ -124,7 +781,30 @@ namespace Bane {
         );
 
         if (!m_systems.contains(name)) {
-            m_systems[name] = std::make_unique<SystemClass>(name);
+            if (m_systemOrder.size() >= EntityRegistry::MaxSignatureSize) {
+                throw std::overflow_error("");
+            }
+
+            auto newSystem = std::make_unique<SystemClass>(name);
+            newSystem -> m_registry = &m_registry;
+            newSystem -> m_registryBit = m_systemOrder.size();
+            newSystem -> m_events = &m_events;
+            newSystem -> m_io = &m_io;
+            newSystem -> m_assets = &m_assets;
+            m_systemOrder.push_back(newSystem.get());
+
+            uint32_t classId = TypeIndex<System>::Of<SystemClass>();
+
+            if (classId >= m_systemsByClass.size()) {
+                m_systemsByClass.resize(classId + 1, nullptr);
+            }
+
+            if (!m_systemsByClass[classId]) {
+                m_systemsByClass[classId] = newSystem.get();
+            }
+
+            m_systems[name] = std::move(newSystem);
+            m_isScheduleDirty = true;
         }
 
         return static_cast<SystemClass*>(m_systems[name].get());
@@ -0,0 +1,170 @@
+#ifndef __BANE_WORLD_GROUP__
+#define __BANE_WORLD_GROUP__
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <harmful/doom/utils/Platform.hpp>
+#include "harmful/bane/jobs/ThreadPlacement.hpp"
+#include "harmful/bane/jobs/WorkerPool.hpp"
+#include "harmful/bane/world/Assets.hpp"
+#include "harmful/bane/world/World.hpp"
+
+namespace Bane {
+    /// <summary>
+    /// Independent Worlds (bots, what-if rollouts...) built from a same
+    /// definition, sharing immutable Assets and run in parallel on a single
+    /// pool of threads.
+    /// </summary>
+    /// <remarks>
+    /// The Worlds advance together: the stages of their Systems are
+    /// interleaved, so that the chunks of all the Worlds keep the threads
+    /// busy while the commands of each World are applied. A World can be
+    /// forked from another one, to simulate from its current state.
+    /// </remarks>
+    class WorldGroup final {
+        public:
+            /// <summary>
+            /// Function registering and setting up the Systems and Jobs of a
+            /// World. It is called for each created World, whose Jobs run on
+            /// the threads of the WorldGroup.
+            /// </summary>
+            using Definition = std::function<void(World&)>;
+
+        private:
+            /// <summary>
+            /// Threads running the Jobs of all the Worlds.
+            /// </summary>
+            std::shared_ptr<WorkerPool> m_threads;
+
+            /// <summary>
+            /// Immutable data shared by all the Worlds; nullptr if none.
+            /// </summary>
+            std::shared_ptr<const Assets> m_assets;
+
+            /// <summary>
+            /// Definition of the Systems and Jobs of each World.
+            /// </summary>
+            Definition m_definition;
+
+            /// <summary>
+            /// Worlds of the group, in their creation order.
+            /// </summary>
+            std::vector<std::unique_ptr<World>> m_worlds;
+
+        public:
+            /// <summary>
+            /// Create a new WorldGroup instance, without World.
+            /// </summary>
+            /// <param name="threadCount">
+            /// Amount of threads shared by all the Worlds.
+            /// </param>
+            /// <param name="definition">
+            /// Definition of the Systems and Jobs of each World.
+            /// </param>
+            /// <param name="assets">
+            /// Immutable data shared by all the Worlds; nullptr for none.
+            /// </param>
+            /// <param name="placement">Where the threads run.</param>
+            /// <exception cref="std::runtime_error">The definition is empty.</exception>
+            exported WorldGroup(
+                const uint8_t threadCount,
+                Definition definition,
+                std::shared_ptr<const Assets> assets = nullptr,
+                const ThreadPlacement& placement = ThreadPlacement()
+            );
+
+            /// <summary>
+            /// Destruction of the WorldGroup instance. The Worlds are
+            /// destroyed, then the threads are stopped.
+            /// </summary>
+            exported ~WorldGroup() noexcept;
+
+            /// <summary>
+            /// Create a new World from the definition, without Entity.
+            /// </summary>
+            /// <returns>The new World, owned by the WorldGroup.</returns>
+            exported World* create();
+
+            /// <summary>
+            /// Create a new World from the definition, with a copy of the
+            /// state of another World (see Snapshot::Copy()). The source can
+            /// be outside the WorldGroup but must have the same Systems.
+            /// </summary>
+            /// <param name="source">World to copy the state of.</param>
+            /// <returns>The new World, owned by the WorldGroup.</returns>
+            /// <exception cref="std::runtime_error">
+            /// The state of the source cannot be copied. No World is created
+            /// in that case.
+            /// </exception>
+            exported World* fork(const World& source);
+
+            /// <summary>
+            /// Destroy a World of the WorldGroup. Nothing is done if the
+            /// World is not in the WorldGroup.
+            /// </summary>
+            /// <param name="world">World to destroy.</param>
+            exported void destroy(const World* world);
+
+            /// <summary>
+            /// Run all the Jobs of all the Worlds once (see World::run()).
+            /// </summary>
+            exported void run();
+
+            /// <summary>
+            /// Run a fixed step of all the Worlds: the Jobs whose period has
+            /// elapsed (see World::setTickRate()).
+            /// </summary>
+            exported void step();
+
+            /// <summary>
+            /// Get the amount of Worlds.
+            /// </summary>
+            /// <returns>Amount of Worlds.</returns>
+            exported size_t size() const {
+                return m_worlds.size();
+            }
+
+            /// <summary>
+            /// Get a World of the WorldGroup.
+            /// </summary>
+            /// <param name="index">Index of the World, in creation order.</param>
+            /// <returns>The World.</returns>
+            exported World* at(const size_t index) const {
+                return m_worlds[index].get();
+            }
+
+            /// <summary>
+            /// Get the threads shared by the Worlds.
+            /// </summary>
+            /// <returns>The shared threads.</returns>
+            exported WorkerPool& threads() const {
+                return *m_threads;
+            }
+
+            /// <summary>
+            /// Get the immutable data shared by the Worlds.
+            /// </summary>
+            /// <returns>The shared Assets; nullptr if none.</returns>
+            exported const std::shared_ptr<const Assets>& assets() const {
+                return m_assets;
+            }
+
+        private:
+            /// <summary>
+            /// Run the stages of all the Worlds, each one for the Jobs in its
+            /// World::m_dueJobs. A World submits its next stage as soon as
+            /// the commands of the previous one are applied.
+            /// </summary>
+            void runStages();
+
+            // Disable copy and move.
+            WorldGroup(const WorldGroup& other) = delete;
+            WorldGroup(WorldGroup&& other) = delete;
+            WorldGroup& operator=(const WorldGroup& other) = delete;
+            WorldGroup& operator=(WorldGroup&& other) = delete;
+    };
+}
+
+#endif
\ No newline at end of file
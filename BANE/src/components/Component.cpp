@@ -2,8 +2,6 @@
 
 using namespace Bane;
 
-Component::Component(
-	const Entity& entity,
-	std::unique_ptr<ComponentData>&& data
-) : m_entityID(entity.id()),
-	m_data(std::move(data)) {}
\ No newline at end of file
+Component::Component(const id_t entityID, ComponentData* data)
+	: m_entityID(entityID),
+	m_data(data) {}
\ No newline at end of file
@@ -0,0 +1,287 @@
+#include "harmful/bane/components/ComponentColumn.hpp"
+#include "harmful/bane/jobs/WorkerPool.hpp"
+#include <algorithm>
+
+using namespace Bane;
+
+namespace {
+    /// <summary>
+    /// What a chunk of a new buffer to touch needs.
+    /// </summary>
+    struct TouchContext {
+        std::byte* destination;
+        const std::byte* source;
+        size_t copiedBytes;
+    };
+
+    /// <summary>
+    /// Copy the stored data in a range of bytes of a new buffer, and fill the
+    /// bytes beyond them with zeros.
+    /// </summary>
+    void TouchChunk(ThreadJob&, const ThreadTask& task) {
+        auto context = static_cast<const TouchContext*>(task.context);
+        size_t copiedEnd = std::min(task.toIndex, context -> copiedBytes);
+
+        if (task.fromIndex < copiedEnd) {
+            std::memcpy(
+                context -> destination + task.fromIndex,
+                context -> source + task.fromIndex,
+                copiedEnd - task.fromIndex
+            );
+        }
+
+        size_t zeroStart = std::max(task.fromIndex, context -> copiedBytes);
+
+        if (zeroStart < task.toIndex) {
+            std::memset(context -> destination + zeroStart, 0, task.toIndex - zeroStart);
+        }
+    }
+}
+
+ComponentColumn::ComponentColumn(const DataType& type)
+    : m_type(type) {}
+
+ComponentColumn::~ComponentColumn() noexcept {
+    clear();
+
+    if (m_data) {
+        ::operator delete(m_data, std::align_val_t(m_type.alignment));
+    }
+}
+
+void ComponentColumn::reserve(const size_t capacity) {
+    if (capacity > m_capacity) {
+        reallocate(capacity);
+    }
+
+    m_entities.reserve(capacity);
+    m_addedVersions.reserve(capacity);
+    m_changedVersions.reserve(capacity);
+}
+
+void* ComponentColumn::allocateBack(const Entity& entity) {
+    return allocateBack(std::span<const Entity>(&entity, 1));
+}
+
+void* ComponentColumn::allocateBack(std::span<const Entity> entities) {
+    const size_t amount = entities.size();
+    grow(m_count + amount);
+
+    const uint32_t currentVersion = version();
+    const size_t lastChunk = (m_count + amount + VersionChunkSize - 1) / VersionChunkSize;
+
+    if (lastChunk > m_chunkVersions.size()) {
+        m_chunkVersions.resize(lastChunk, 0);
+    }
+
+    for (auto& entity : entities) {
+        m_entities.push_back(entity.id());
+    }
+
+    m_addedVersions.resize(m_count + amount, currentVersion);
+    m_changedVersions.resize(m_count + amount, currentVersion);
+
+    for (size_t chunk = m_count / VersionChunkSize; chunk < lastChunk; chunk++) {
+        m_chunkVersions[chunk] = currentVersion;
+    }
+
+    void* firstSlot = m_data + (m_count * m_type.size);
+    m_count += amount;
+    return firstSlot;
+}
+
+void ComponentColumn::discardBack(const size_t amount) {
+    m_entities.resize(m_count - amount);
+    m_addedVersions.resize(m_count - amount);
+    m_changedVersions.resize(m_count - amount);
+    m_count -= amount;
+}
+
+void ComponentColumn::swapAndPop(const size_t index) {
+    const size_t lastIndex = m_count - 1;
+    void* removed = dataAt(index);
+
+    if (!m_type.trivial) {
+        m_type.destroy(removed);
+    }
+
+    if (index != lastIndex) {
+        relocate(removed, dataAt(lastIndex));
+        m_entities[index] = m_entities[lastIndex];
+        m_addedVersions[index] = m_addedVersions[lastIndex];
+        m_changedVersions[index] = m_changedVersions[lastIndex];
+
+        // The moved data keeps its versions, its new chunk must reflect it.
+        auto& chunkVersion = m_chunkVersions[index / VersionChunkSize];
+        chunkVersion = std::max(chunkVersion, m_changedVersions[index]);
+    }
+
+    m_entities.pop_back();
+    m_addedVersions.pop_back();
+    m_changedVersions.pop_back();
+    m_count--;
+}
+
+void ComponentColumn::reorder(std::span<const uint32_t> order) {
+    if (m_count == 0) {
+        return;
+    }
+
+    auto newData = static_cast<std::byte*>(
+        ::operator new(m_capacity * m_type.size, std::align_val_t(m_type.alignment))
+    );
+
+    std::vector<id_t> entities(m_count);
+    std::vector<uint32_t> addedVersions(m_count);
+    std::vector<uint32_t> changedVersions(m_count);
+
+    for (size_t index = 0; index < m_count; index++) {
+        const size_t previousIndex = order[index];
+        relocate(newData + (index * m_type.size), dataAt(previousIndex));
+        entities[index] = m_entities[previousIndex];
+        addedVersions[index] = m_addedVersions[previousIndex];
+        changedVersions[index] = m_changedVersions[previousIndex];
+    }
+
+    ::operator delete(m_data, std::align_val_t(m_type.alignment));
+    m_data = newData;
+    m_amountAllocations++;
+    m_entities.swap(entities);
+    m_addedVersions.swap(addedVersions);
+    m_changedVersions.swap(changedVersions);
+
+    // The chunks now gather other data.
+    std::fill(m_chunkVersions.begin(), m_chunkVersions.end(), 0);
+
+    for (size_t index = 0; index < m_count; index++) {
+        auto& chunkVersion = m_chunkVersions[index / VersionChunkSize];
+        chunkVersion = std::max(chunkVersion, m_changedVersions[index]);
+    }
+}
+
+void ComponentColumn::clear() {
+    if (!m_type.trivial) {
+        for (size_t index = 0; index < m_count; index++) {
+            m_type.destroy(dataAt(index));
+        }
+    }
+
+    m_entities.clear();
+    m_addedVersions.clear();
+    m_changedVersions.clear();
+    m_chunkVersions.clear();
+    m_count = 0;
+}
+
+void ComponentColumn::markChanged(const size_t fromIndex, const size_t toIndex) {
+    if (fromIndex >= toIndex) {
+        return;
+    }
+
+    const uint32_t currentVersion = version();
+
+    std::fill(
+        m_changedVersions.begin() + fromIndex,
+        m_changedVersions.begin() + toIndex,
+        currentVersion
+    );
+
+    size_t firstChunk = fromIndex / VersionChunkSize;
+    size_t lastChunk = (toIndex - 1) / VersionChunkSize;
+
+    for (size_t chunk = firstChunk; chunk <= lastChunk; chunk++) {
+        std::atomic_ref<uint32_t>(m_chunkVersions[chunk])
+            .store(currentVersion, std::memory_order_relaxed);
+    }
+}
+
+ComponentColumn::MemoryStatistics ComponentColumn::memory() const {
+    MemoryStatistics statistics;
+    statistics.amountData = m_count;
+    statistics.capacity = m_capacity;
+    statistics.usedBytes = m_count * m_type.size;
+    statistics.reservedBytes = m_capacity * m_type.size;
+    statistics.metadataBytes = (m_entities.capacity() * sizeof(id_t))
+        + ((m_addedVersions.capacity() + m_changedVersions.capacity() + m_chunkVersions.capacity()) * sizeof(uint32_t));
+    statistics.amountAllocations = m_amountAllocations;
+    return statistics;
+}
+
+void ComponentColumn::grow(const size_t amount) {
+    if (amount > m_capacity) {
+        reallocate(std::max({ MinimalCapacity, m_capacity * 2, amount }));
+    }
+}
+
+void ComponentColumn::reallocate(const size_t capacity) {
+    auto newData = static_cast<std::byte*>(
+        ::operator new(capacity * m_type.size, std::align_val_t(m_type.alignment))
+    );
+
+    if (m_type.trivial) {
+        bool isTouched = touchInParallel(newData, capacity);
+
+        if (!isTouched && (m_count > 0)) {
+            std::memcpy(newData, m_data, m_count * m_type.size);
+        }
+    }
+    else {
+        for (size_t index = 0; index < m_count; index++) {
+            relocate(newData + (index * m_type.size), dataAt(index));
+        }
+    }
+
+    if (m_data) {
+        ::operator delete(m_data, std::align_val_t(m_type.alignment));
+    }
+
+    m_data = newData;
+    m_capacity = capacity;
+    m_amountAllocations++;
+}
+
+bool ComponentColumn::touchInParallel(std::byte* newData, const size_t capacity) {
+    size_t size = capacity * m_type.size;
+    auto current = ThreadJob::Current();
+
+    // A thread of the pool cannot wait for the others without risking a
+    // deadlock.
+    bool canTouch = m_workers
+        && (m_workers -> size() > 1)
+        && m_workers -> isRunning()
+        && (size >= MinimalTouchedSize)
+        && (!current || (&(current -> pool()) != m_workers));
+
+    if (!canTouch) {
+        return false;
+    }
+
+    TouchContext context { newData, m_data, m_count * m_type.size };
+    std::vector<ThreadTask> chunks;
+    TaskGroup group;
+    ThreadTask chunk;
+    chunk.function = &TouchChunk;
+    chunk.context = &context;
+    chunk.group = &group;
+
+    for (size_t chunkStart = 0; chunkStart < size; chunkStart += TouchedChunkSize) {
+        chunk.fromIndex = chunkStart;
+        chunk.toIndex = std::min(chunkStart + TouchedChunkSize, size);
+        chunks.push_back(chunk);
+    }
+
+    group.add(chunks.size());
+    m_workers -> submit(chunks);
+    group.wait();
+    return true;
+}
+
+void ComponentColumn::relocate(void* destination, void* source) {
+    if (m_type.trivial) {
+        std::memcpy(destination, source, m_type.size);
+        return;
+    }
+
+    m_type.moveConstruct(destination, source);
+    m_type.destroy(source);
+}
\ No newline at end of file
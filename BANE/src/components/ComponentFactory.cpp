@@ -1,98 +1,332 @@
 #include "harmful/bane/components/ComponentFactory.hpp"
-#include <list>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
 
 using namespace Bane;
 
-Component* ComponentFactory::createComponentFor(const Entity& entity) {
-    size_t entityPosition = position(entity);
+ComponentFactory::ComponentFactory(const ComponentColumn::DataType& type)
+    : m_components(type) {}
 
-    if (!isCreationAllowedFor(entity)) {
-        return &m_componentsPerEntity[entityPosition].back();
+Component ComponentFactory::createComponentFor(const Entity& entity) {
+    if (!entity.isValid()) {
+        throw std::runtime_error("");
     }
 
-    auto&& componentData = createDataFor(entity);
-    Component newComponent(entity, std::move(componentData));
+    auto entityIndex = m_entities.indexOf(entity.id());
+    bool hasComponents = entityIndex != SparseSet::InvalidIndex;
+    bool acceptOnlyOne = allowedQuantity() == ComponentData::Quantity::One;
 
-    if (m_componentsPerEntity.size() < entity.id()) {
-        m_componentsPerEntity.resize(entity.id());
+    if (hasComponents && acceptOnlyOne) {
+        return componentAt(m_componentsPerEntity[entityIndex].first);
     }
 
-    m_componentsPerEntity[entityPosition].push_back(std::move(newComponent));
+    auto componentIndex = static_cast<uint32_t>(m_components.size());
+    void* storage = m_components.allocateBack(entity);
+    ComponentData* componentData = nullptr;
 
-    auto newComponentPtr = &m_componentsPerEntity[entityPosition].back();
-    m_components.insert(newComponentPtr);
+    try {
+        componentData = createDataFor(storage, entity);
+    }
+    catch (...) {
+        m_components.discardBack();
+        throw;
+    }
 
-    return newComponentPtr;
+    attach(entity, componentIndex);
+    return Component(entity.id(), componentData);
 }
 
-size_t ComponentFactory::countFor(const Entity& entity) const {
-    size_t entityPosition = position(entity);
+size_t ComponentFactory::createComponentsFor(std::span<const Entity> entities) {
+    std::vector<Entity> acceptedEntities;
+    entities = acceptedOf(entities, acceptedEntities);
+
+    if (entities.empty()) {
+        return 0;
+    }
+
+    auto firstIndex = static_cast<uint32_t>(m_components.size());
+    void* storage = m_components.allocateBack(entities);
+
+    try {
+        createDataRange(storage, entities);
+    }
+    catch (...) {
+        m_components.discardBack(entities.size());
+        throw;
+    }
+
+    attach(entities, firstIndex);
+    return entities.size();
+}
+
+size_t ComponentFactory::cloneComponentsFor(
+    std::span<const Entity> entities,
+    const void* data
+) {
+    if (!m_components.type().trivial) {
+        throw std::runtime_error("");
+    }
+
+    std::vector<Entity> acceptedEntities;
+    entities = acceptedOf(entities, acceptedEntities);
 
-    if (m_componentsPerEntity.size() > entity.id()) {
+    if (entities.empty()) {
         return 0;
     }
 
-    return m_componentsPerEntity[entityPosition].size();
+    auto firstIndex = static_cast<uint32_t>(m_components.size());
+    auto storage = static_cast<std::byte*>(m_components.allocateBack(entities));
+    const size_t dataSize = m_components.type().size;
+    const size_t totalSize = entities.size() * dataSize;
+
+    // The copied Components are the source of the next copy, so that a few
+    // large copies are made instead of one per Component.
+    std::memcpy(storage, data, dataSize);
+
+    for (size_t copiedSize = dataSize; copiedSize < totalSize;) {
+        size_t copySize = std::min(copiedSize, totalSize - copiedSize);
+        std::memcpy(storage + copiedSize, storage, copySize);
+        copiedSize += copySize;
+    }
+
+    attach(entities, firstIndex);
+    return entities.size();
+}
+
+void ComponentFactory::restoreComponents(
+    std::span<const Entity> entities,
+    const void* data
+) {
+    if (!m_components.type().trivial || (m_components.size() > 0)) {
+        throw std::runtime_error("");
+    }
+
+    if (entities.empty()) {
+        return;
+    }
+
+    void* storage = m_components.allocateBack(entities);
+    std::memcpy(storage, data, entities.size() * m_components.type().size);
+    m_links.reserve(entities.size());
+    m_componentsPerEntity.reserve(entities.size());
+    m_entities.reserve(entities.size());
+
+    for (uint32_t index = 0; index < entities.size(); index++) {
+        attach(entities[index], index);
+    }
+}
+
+void ComponentFactory::createDataRange(
+    void* storage,
+    std::span<const Entity> entities
+) {
+    auto data = static_cast<std::byte*>(storage);
+    const size_t dataSize = m_components.type().size;
+    size_t amountCreated = 0;
+
+    try {
+        for (auto& entity : entities) {
+            createDataFor(data + (amountCreated * dataSize), entity);
+            amountCreated++;
+        }
+    }
+    catch (...) {
+        if (!m_components.type().trivial) {
+            for (size_t index = 0; index < amountCreated; index++) {
+                m_components.type().destroy(data + (index * dataSize));
+            }
+        }
+
+        throw;
+    }
 }
 
-std::list<Component*> ComponentFactory::componentsOf(const Entity& entity) {
-    std::list<Component*> returnedList;
-    size_t entityPosition = position(entity);
+ComponentColumn::MemoryStatistics ComponentFactory::memory() const {
+    auto statistics = m_components.memory();
+    statistics.metadataBytes += m_entities.memoryBytes()
+        + (m_links.capacity() * sizeof(ComponentLinks))
+        + (m_componentsPerEntity.capacity() * sizeof(EntityComponents));
+    return statistics;
+}
+
+size_t ComponentFactory::countFor(const Entity& entity) const {
+    auto entityIndex = m_entities.indexOf(entity.id());
 
-    if (m_componentsPerEntity.size() > entity.id()) {
-        return returnedList;
+    if (entityIndex == SparseSet::InvalidIndex) {
+        return 0;
     }
 
-    for (auto& component : m_componentsPerEntity[entityPosition]) {
-        returnedList.push_back(&component);
+    return m_componentsPerEntity[entityIndex].count;
+}
+
+ComponentFactory::ComponentRange ComponentFactory::componentsOf(const Entity& entity) const {
+    auto entityIndex = m_entities.indexOf(entity.id());
+
+    if (entityIndex == SparseSet::InvalidIndex) {
+        return ComponentRange(this, NoComponent, 0);
     }
 
-    return returnedList;
+    auto& entityComponents = m_componentsPerEntity[entityIndex];
+    return ComponentRange(this, entityComponents.first, entityComponents.count);
 }
 
-Component* ComponentFactory::firstOf(const Entity& entity) {
-    size_t entityPosition = position(entity);
+Component ComponentFactory::firstOf(const Entity& entity) const {
+    auto entityIndex = m_entities.indexOf(entity.id());
 
-    if (m_componentsPerEntity.size() > entity.id()) {
-        return nullptr;
+    if (entityIndex == SparseSet::InvalidIndex) {
+        return Component();
     }
 
-    return &m_componentsPerEntity[entityPosition].front();
+    return componentAt(m_componentsPerEntity[entityIndex].first);
 }
 
 void ComponentFactory::destroyComponentsOf(const Entity& entity) {
-    size_t entityPosition = position(entity);
+    auto entityIndex = m_entities.indexOf(entity.id());
 
-    if (m_componentsPerEntity[entityPosition].size() == 0) {
+    if (entityIndex == SparseSet::InvalidIndex) {
         return;
     }
 
-    for (auto& component : m_componentsPerEntity[entityPosition]) {
-        m_components.erase(&component);
+    // Unlink and remove the Components one after the other from the first
+    // one: the moved Components (including the ones of the Entity) get their
+    // links updated by removeAt().
+    while (m_componentsPerEntity[entityIndex].count > 0) {
+        auto& entityComponents = m_componentsPerEntity[entityIndex];
+        auto componentIndex = entityComponents.first;
+        entityComponents.first = m_links[componentIndex].next;
+        entityComponents.count--;
+
+        if (entityComponents.first != NoComponent) {
+            m_links[entityComponents.first].previous = NoComponent;
+        }
+
+        removeAt(componentIndex);
     }
 
-    m_componentsPerEntity[entityPosition].clear();
+    // Same swap and pop as the one performed by the SparseSet.
+    m_entities.erase(entity.id());
+    m_componentsPerEntity[entityIndex] = m_componentsPerEntity.back();
+    m_componentsPerEntity.pop_back();
 }
 
-bool ComponentFactory::isCreationAllowedFor(const Entity& entity) {
-    size_t entityPosition = position(entity);
+void ComponentFactory::reorder(std::span<const uint32_t> order) {
+    if (order.size() != m_components.size()) {
+        throw std::runtime_error("");
+    }
+
+    m_components.reorder(order);
+
+    // New index of each Component, to update the chains.
+    std::vector<uint32_t> newIndices(order.size());
 
-    auto acceptedQuantity = allowedQuantity();
-    bool acceptOnlyOne = acceptedQuantity == ComponentData::Quantity::One;
-    auto alreadyQuantity = m_componentsPerEntity[entityPosition].size();
-    bool alreadyOne = alreadyQuantity == 1;
+    for (uint32_t index = 0; index < order.size(); index++) {
+        newIndices[order[index]] = index;
+    }
+
+    auto newIndexOf = [&](const uint32_t previousIndex) {
+        return (previousIndex == NoComponent) ? NoComponent : newIndices[previousIndex];
+    };
+
+    std::vector<ComponentLinks> links(order.size());
+
+    for (uint32_t index = 0; index < order.size(); index++) {
+        auto& previousLinks = m_links[order[index]];
+        links[index] = { newIndexOf(previousLinks.previous), newIndexOf(previousLinks.next) };
+    }
 
-    if (acceptOnlyOne && alreadyOne) {
-        return false;
+    m_links.swap(links);
+
+    for (auto& entityComponents : m_componentsPerEntity) {
+        entityComponents.first = newIndices[entityComponents.first];
+        entityComponents.last = newIndices[entityComponents.last];
     }
+}
 
-    return true;
+void ComponentFactory::clear() {
+    m_components.clear();
+    m_links.clear();
+    m_entities.clear();
+    m_componentsPerEntity.clear();
 }
 
-size_t ComponentFactory::position(const Doom::IDObject& object) const {
-    if (!object.isValid()) {
-        throw std::runtime_error("");
+std::span<const Entity> ComponentFactory::acceptedOf(
+    std::span<const Entity> entities,
+    std::vector<Entity>& accepted
+) {
+    for (auto& entity : entities) {
+        if (!entity.isValid()) {
+            throw std::runtime_error("");
+        }
+    }
+
+    // The Entities bearing their only allowed Component are left apart.
+    if (allowedQuantity() != ComponentData::Quantity::One) {
+        return entities;
+    }
+
+    accepted.reserve(entities.size());
+
+    for (auto& entity : entities) {
+        if (!m_entities.contains(entity.id())) {
+            accepted.push_back(entity);
+        }
+    }
+
+    return accepted;
+}
+
+void ComponentFactory::attach(std::span<const Entity> entities, const uint32_t firstIndex) {
+    for (uint32_t offset = 0; offset < entities.size(); offset++) {
+        attach(entities[offset], firstIndex + offset);
+    }
+}
+
+void ComponentFactory::attach(const Entity& entity, const uint32_t index) {
+    auto entityIndex = m_entities.indexOf(entity.id());
+
+    if (entityIndex == SparseSet::InvalidIndex) {
+        m_entities.insert(entity.id());
+        m_componentsPerEntity.push_back({ index, index, 1 });
+        m_links.push_back({ NoComponent, NoComponent });
+        return;
+    }
+
+    // Chain the new Component after the last one of the Entity.
+    auto& entityComponents = m_componentsPerEntity[entityIndex];
+    m_links[entityComponents.last].next = index;
+    m_links.push_back({ entityComponents.last, NoComponent });
+    entityComponents.last = index;
+    entityComponents.count++;
+}
+
+void ComponentFactory::removeAt(const uint32_t index) {
+    auto lastIndex = static_cast<uint32_t>(m_components.size() - 1);
+    m_components.swapAndPop(index);
+
+    if (index != lastIndex) {
+        // The last Component now lives at the removed index: its neighbours
+        // (or its Entity if it is at an end of the chain) must point to it.
+        auto& links = m_links[index];
+        links = m_links[lastIndex];
+
+        auto movedEntityIndex = m_entities.indexOf(m_components.entityAt(index));
+        auto& movedEntityComponents = m_componentsPerEntity[movedEntityIndex];
+
+        if (links.previous != NoComponent) {
+            m_links[links.previous].next = index;
+        }
+        else {
+            movedEntityComponents.first = index;
+        }
+
+        if (links.next != NoComponent) {
+            m_links[links.next].previous = index;
+        }
+        else {
+            movedEntityComponents.last = index;
+        }
     }
 
-    return (object.id()) - 1;
+    m_links.pop_back();
 }
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "harmful/bane/components/TypeIndex.hpp"
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+using namespace Bane;
+
+namespace {
+    /// <summary>
+    /// Types of a family identified so far.
+    /// </summary>
+    struct Family {
+        /// <summary>
+        /// Identifier of each type.
+        /// </summary>
+        std::unordered_map<std::type_index, uint32_t> ids;
+
+        /// <summary>
+        /// Name of each type, by identifier.
+        /// </summary>
+        std::vector<const char*> names;
+    };
+
+    /// <summary>
+    /// Protects Families().
+    /// </summary>
+    std::mutex FamiliesMutex;
+
+    /// <summary>
+    /// Get the families of types identified so far.
+    /// </summary>
+    /// <returns>Families of types.</returns>
+    std::unordered_map<std::type_index, Family>& Families() {
+        static std::unordered_map<std::type_index, Family> families;
+        return families;
+    }
+}
+
+uint32_t TypeRegistry::Register(
+    const std::type_info& family,
+    const std::type_info& type
+) {
+    std::lock_guard<std::mutex> lock(FamiliesMutex);
+    auto& types = Families()[std::type_index(family)];
+    auto [found, isNew] = types.ids.try_emplace(
+        std::type_index(type),
+        static_cast<uint32_t>(types.names.size())
+    );
+
+    if (isNew) {
+        types.names.push_back(type.name());
+    }
+
+    return found -> second;
+}
+
+uint32_t TypeRegistry::Size(const std::type_info& family) {
+    std::lock_guard<std::mutex> lock(FamiliesMutex);
+    auto types = Families().find(std::type_index(family));
+    return (types != Families().end()) ? static_cast<uint32_t>(types -> second.names.size()) : 0;
+}
+
+const char* TypeRegistry::NameOf(const std::type_info& family, const uint32_t id) {
+    std::lock_guard<std::mutex> lock(FamiliesMutex);
+    auto types = Families().find(std::type_index(family));
+
+    if ((types == Families().end()) || (id >= types -> second.names.size())) {
+        return "";
+    }
+
+    return types -> second.names[id];
+}
\ No newline at end of file
@@ -1,8 +0,0 @@
-#include "harmful/bane/entities/Entity.hpp"
-#include <harmful/doom/utils/Chrono.hpp>
-
-using namespace Bane;
-using namespace Doom;
-
-Entity::Entity()
-	: IDObject(IDObject::Generate()) {}
\ No newline at end of file
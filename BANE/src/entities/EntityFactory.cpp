@@ -1,30 +1,347 @@
 #include "harmful/bane/entities/EntityFactory.hpp"
+#include <algorithm>
+#include <stdexcept>
 
 using namespace Bane;
-using namespace Doom;
+
+EntityFactory::~EntityFactory() noexcept {
+	for (auto& page : m_pages) {
+		delete[] page.load(std::memory_order_relaxed);
+	}
+}
 
 Entity EntityFactory::create() {
-	Entity newEntity;
-	m_entities.insert(newEntity.id());
-	return newEntity;
+	uint32_t index = 0;
+
+	if (!popFreeIndex(index)) {
+		index = m_nextIndex.fetch_add(1, std::memory_order_acq_rel);
+
+		if (index > Entity::IndexMask) {
+			m_nextIndex.fetch_sub(1, std::memory_order_acq_rel);
+			throw std::overflow_error("");
+		}
+	}
+
+	auto& indexSlot = slot(index);
+	auto generation = indexSlot.state.load(std::memory_order_relaxed);
+	indexSlot.state.store(generation | AliveFlag, std::memory_order_release);
+	m_count.fetch_add(1, std::memory_order_relaxed);
+
+	return Entity(index, generation);
 }
 
-void EntityFactory::destroy(const Entity& entity) {
-	if (m_entities.contains(entity.id())) {
-		m_entities.erase(entity.id());
+void EntityFactory::create(std::span<Entity> entities) {
+	size_t amountReused = 0;
+	uint32_t index = 0;
+
+	while ((amountReused < entities.size()) && popFreeIndex(index)) {
+		entities[amountReused++] = Entity(index, 0);
 	}
+
+	auto amountNew = static_cast<uint32_t>(entities.size() - amountReused);
+	uint32_t firstNewIndex = 0;
+
+	if (amountNew > 0) {
+		firstNewIndex = m_nextIndex.fetch_add(amountNew, std::memory_order_acq_rel);
+
+		if ((static_cast<uint64_t>(firstNewIndex) + amountNew - 1) > Entity::IndexMask) {
+			m_nextIndex.fetch_sub(amountNew, std::memory_order_acq_rel);
+
+			for (size_t reused = 0; reused < amountReused; reused++) {
+				pushFreeIndex(entities[reused].index());
+			}
+
+			throw std::overflow_error("");
+		}
+	}
+
+	for (size_t position = 0; position < entities.size(); position++) {
+		index = (position < amountReused)
+			? entities[position].index()
+			: firstNewIndex + static_cast<uint32_t>(position - amountReused);
+
+		auto& indexSlot = slot(index);
+		auto generation = indexSlot.state.load(std::memory_order_relaxed);
+		indexSlot.state.store(generation | AliveFlag, std::memory_order_release);
+		entities[position] = Entity(index, generation);
+	}
+
+	m_count.fetch_add(entities.size(), std::memory_order_relaxed);
 }
 
-void EntityFactory::destroy(const id_t& entity) {
-	if (m_entities.contains(entity)) {
-		m_entities.erase(entity);
+void EntityFactory::beginReservation(const uint32_t amountStreams) {
+	if (!m_amountsReserved.empty()) {
+		throw std::runtime_error("");
 	}
+
+	m_amountsReserved.assign(amountStreams, 0);
+	m_reservationBase = indexCount();
+	m_reservedFreeIndices.clear();
+
+	// The first round of blocks reuses the free indices, read without being
+	// popped: endReservation() pops the ones that are used.
+	const size_t amountFreeIndices = static_cast<size_t>(amountStreams) * ReservationBlockSize;
+	auto next = static_cast<uint32_t>(m_freeHead.load(std::memory_order_acquire));
+
+	while ((next != EndOfList) && (m_reservedFreeIndices.size() < amountFreeIndices)) {
+		m_reservedFreeIndices.push_back(next - 1);
+		next = findSlot(next - 1) -> nextFree.load(std::memory_order_relaxed);
+	}
+}
+
+Entity EntityFactory::reserve(const uint32_t stream) {
+	if (stream >= m_amountsReserved.size()) {
+		throw std::out_of_range("");
+	}
+
+	uint64_t index = reservedIndex(reservedPosition(stream, m_amountsReserved[stream]));
+
+	if (index > Entity::IndexMask) {
+		throw std::overflow_error("");
+	}
+
+	// Each position belongs to a single stream: no other thread uses the
+	// slot until the end of the reservation.
+	auto& indexSlot = slot(static_cast<uint32_t>(index));
+	auto generation = indexSlot.state.load(std::memory_order_relaxed);
+	indexSlot.state.store(generation | AliveFlag, std::memory_order_release);
+	m_count.fetch_add(1, std::memory_order_relaxed);
+	m_amountsReserved[stream]++;
+
+	return Entity(static_cast<uint32_t>(index), generation);
+}
+
+void EntityFactory::endReservation() {
+	uint64_t amountPositions = 0;
+
+	for (uint32_t stream = 0; stream < m_amountsReserved.size(); stream++) {
+		if (m_amountsReserved[stream] > 0) {
+			amountPositions = std::max(
+				amountPositions,
+				reservedPosition(stream, m_amountsReserved[stream] - 1) + 1
+			);
+		}
+	}
+
+	if (amountPositions > 0) {
+		std::vector<bool> isUsed(amountPositions, false);
+
+		for (uint32_t stream = 0; stream < m_amountsReserved.size(); stream++) {
+			for (uint32_t ordinal = 0; ordinal < m_amountsReserved[stream]; ordinal++) {
+				isUsed[reservedPosition(stream, ordinal)] = true;
+			}
+		}
+
+		// The free indices covered by the positions leave the free list,
+		// then the unused positions are pushed back in front of it, the
+		// first position last.
+		uint32_t index = 0;
+		uint64_t amountFreeIndices = std::min<uint64_t>(amountPositions, m_reservedFreeIndices.size());
+
+		for (uint64_t position = 0; position < amountFreeIndices; position++) {
+			popFreeIndex(index);
+		}
+
+		if (amountPositions > m_reservedFreeIndices.size()) {
+			m_nextIndex.store(
+				static_cast<uint32_t>(reservedIndex(amountPositions - 1) + 1),
+				std::memory_order_release
+			);
+		}
+
+		for (uint64_t position = amountPositions; position-- > 0;) {
+			if (!isUsed[position]) {
+				pushFreeIndex(static_cast<uint32_t>(reservedIndex(position)));
+			}
+		}
+	}
+
+	m_amountsReserved.clear();
+	m_reservedFreeIndices.clear();
+}
+
+bool EntityFactory::destroy(const Entity& entity) {
+	if (!entity.isValid() || !findSlot(entity.index())) {
+		return false;
+	}
+
+	auto& indexSlot = slot(entity.index());
+	uint32_t nextGeneration = (entity.generation() + 1) & Entity::GenerationMask;
+
+	if (nextGeneration == 0) {
+		nextGeneration = 1;
+	}
+
+	// Only one thread can succeed in killing a given Entity.
+	uint32_t expected = entity.generation() | AliveFlag;
+	bool killed = indexSlot.state.compare_exchange_strong(
+		expected,
+		nextGeneration,
+		std::memory_order_acq_rel
+	);
+
+	if (!killed) {
+		return false;
+	}
+
+	m_count.fetch_sub(1, std::memory_order_relaxed);
+	pushFreeIndex(entity.index());
+	return true;
 }
 
 bool EntityFactory::contains(const Entity& entity) const {
-	return m_entities.contains(entity.id());
+	if (!entity.isValid()) {
+		return false;
+	}
+
+	auto indexSlot = findSlot(entity.index());
+
+	if (!indexSlot) {
+		return false;
+	}
+
+	auto state = indexSlot -> state.load(std::memory_order_acquire);
+	return state == (entity.generation() | AliveFlag);
+}
+
+void EntityFactory::snapshot(
+	std::vector<uint32_t>& states,
+	std::vector<uint32_t>& freeIndices
+) const {
+	const uint32_t amountIndices = indexCount();
+	states.resize(amountIndices);
+	freeIndices.clear();
+
+	for (uint32_t index = 0; index < amountIndices; index++) {
+		states[index] = findSlot(index) -> state.load(std::memory_order_acquire);
+	}
+
+	auto next = static_cast<uint32_t>(m_freeHead.load(std::memory_order_acquire));
+
+	while (next != EndOfList) {
+		freeIndices.push_back(next - 1);
+		next = findSlot(next - 1) -> nextFree.load(std::memory_order_relaxed);
+	}
 }
 
-bool EntityFactory::contains(const id_t& entity) const {
-	return m_entities.contains(entity);
+void EntityFactory::restore(
+	std::span<const uint32_t> states,
+	std::span<const uint32_t> freeIndices
+) {
+	Validate(states, freeIndices);
+
+	const auto amountIndices = static_cast<uint32_t>(states.size());
+	const uint32_t previousAmountIndices = indexCount();
+	size_t amountAlive = 0;
+
+	for (uint32_t index = 0; index < amountIndices; index++) {
+		slot(index).state.store(states[index], std::memory_order_relaxed);
+		amountAlive += (states[index] & AliveFlag) ? 1 : 0;
+	}
+
+	// The indices beyond the restored ones are considered as never used.
+	for (uint32_t index = amountIndices; index < previousAmountIndices; index++) {
+		slot(index).state.store(1, std::memory_order_relaxed);
+	}
+
+	m_freeHead.store(EndOfList, std::memory_order_relaxed);
+
+	for (auto index = freeIndices.rbegin(); index != freeIndices.rend(); ++index) {
+		pushFreeIndex(*index);
+	}
+
+	m_count.store(amountAlive, std::memory_order_relaxed);
+	m_nextIndex.store(amountIndices, std::memory_order_release);
+}
+
+void EntityFactory::Validate(
+	std::span<const uint32_t> states,
+	std::span<const uint32_t> freeIndices
+) {
+	if (states.size() > (static_cast<size_t>(Entity::IndexMask) + 1)) {
+		throw std::overflow_error("");
+	}
+
+	// A free index present twice would make the free list cyclic.
+	std::vector<bool> isFree(states.size(), false);
+
+	for (auto index : freeIndices) {
+		if ((index >= states.size()) || (states[index] & AliveFlag) || isFree[index]) {
+			throw std::runtime_error("");
+		}
+
+		isFree[index] = true;
+	}
+}
+
+EntityFactory::Slot& EntityFactory::slot(const uint32_t index) {
+	auto& page = m_pages[index / PageSize];
+	Slot* slots = page.load(std::memory_order_acquire);
+
+	if (!slots) {
+		// Several threads may race to allocate the page: only one wins.
+		Slot* newSlots = new Slot[PageSize];
+
+		if (page.compare_exchange_strong(slots, newSlots, std::memory_order_acq_rel)) {
+			slots = newSlots;
+		}
+		else {
+			delete[] newSlots;
+		}
+	}
+
+	return slots[index % PageSize];
+}
+
+const EntityFactory::Slot* EntityFactory::findSlot(const uint32_t index) const {
+	if (index > Entity::IndexMask) {
+		return nullptr;
+	}
+
+	const Slot* slots = m_pages[index / PageSize].load(std::memory_order_acquire);
+
+	if (!slots) {
+		return nullptr;
+	}
+
+	return &slots[index % PageSize];
+}
+
+bool EntityFactory::popFreeIndex(uint32_t& index) {
+	uint64_t head = m_freeHead.load(std::memory_order_acquire);
+
+	while (true) {
+		auto first = static_cast<uint32_t>(head);
+
+		if (first == EndOfList) {
+			return false;
+		}
+
+		// Slots are never released, so reading a slot that has been popped by
+		// another thread in the meantime is safe: the tag makes the exchange
+		// fail in that case.
+		auto next = slot(first - 1).nextFree.load(std::memory_order_relaxed);
+		uint64_t tag = (head >> 32) + 1;
+		uint64_t newHead = (tag << 32) | next;
+
+		if (m_freeHead.compare_exchange_weak(head, newHead, std::memory_order_acq_rel)) {
+			index = first - 1;
+			return true;
+		}
+	}
+}
+
+void EntityFactory::pushFreeIndex(const uint32_t index) {
+	auto& indexSlot = slot(index);
+	uint64_t head = m_freeHead.load(std::memory_order_acquire);
+
+	while (true) {
+		indexSlot.nextFree.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+		uint64_t tag = (head >> 32) + 1;
+		uint64_t newHead = (tag << 32) | (index + 1);
+
+		if (m_freeHead.compare_exchange_weak(head, newHead, std::memory_order_acq_rel)) {
+			return;
+		}
+	}
 }
\ No newline at end of file
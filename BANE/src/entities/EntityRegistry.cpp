@@ -0,0 +1,65 @@
+#include "harmful/bane/entities/EntityRegistry.hpp"
+#include <algorithm>
+
+using namespace Bane;
+
+void EntityRegistry::insert(const Entity& entity) {
+	if (m_entities.insert(entity.id()) == m_signatures.size()) {
+		m_signatures.emplace_back();
+	}
+}
+
+void EntityRegistry::insert(std::span<const Entity> entities) {
+	reserveFor(entities.size());
+
+	for (auto& entity : entities) {
+		insert(entity);
+	}
+}
+
+void EntityRegistry::insert(
+	std::span<const Entity> entities,
+	const Signature& signature
+) {
+	reserveFor(entities.size());
+
+	for (auto& entity : entities) {
+		auto index = m_entities.insert(entity.id());
+
+		if (index == m_signatures.size()) {
+			m_signatures.push_back(signature);
+		}
+		else {
+			m_signatures[index] |= signature;
+		}
+	}
+}
+
+EntityRegistry::Signature EntityRegistry::erase(const Entity& entity) {
+	auto index = m_entities.erase(entity.id());
+
+	if (index == SparseSet::InvalidIndex) {
+		return Signature();
+	}
+
+	// Same swap and pop as the one performed by the SparseSet.
+	Signature signature = m_signatures[index];
+	m_signatures[index] = m_signatures.back();
+	m_signatures.pop_back();
+	return signature;
+}
+
+void EntityRegistry::clear() {
+	m_entities.clear();
+	m_signatures.clear();
+}
+
+void EntityRegistry::reserveFor(const size_t amount) {
+	const size_t wantedCapacity = m_signatures.size() + amount;
+
+	if (wantedCapacity > m_signatures.capacity()) {
+		const size_t capacity = std::max(wantedCapacity, 2 * m_signatures.capacity());
+		m_entities.reserve(capacity);
+		m_signatures.reserve(capacity);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#include "harmful/bane/entities/SparseSet.hpp"
+#include <algorithm>
+
+using namespace Bane;
+
+size_t SparseSet::insert(const id_t entity) {
+    auto currentIndex = indexOf(entity);
+
+    if (currentIndex != InvalidIndex) {
+        return currentIndex;
+    }
+
+    const size_t newIndex = m_dense.size();
+    sparseEntry(Position(entity)) = static_cast<uint32_t>(newIndex);
+    m_dense.push_back(entity);
+    return newIndex;
+}
+
+size_t SparseSet::erase(const id_t entity) {
+    const size_t removedIndex = indexOf(entity);
+
+    if (removedIndex == InvalidIndex) {
+        return InvalidIndex;
+    }
+
+    const id_t lastEntity = m_dense.back();
+    m_dense[removedIndex] = lastEntity;
+    sparseEntry(Position(lastEntity)) = static_cast<uint32_t>(removedIndex);
+    sparseEntry(Position(entity)) = static_cast<uint32_t>(InvalidIndex);
+    m_dense.pop_back();
+
+    return removedIndex;
+}
+
+void SparseSet::clear() {
+    for (auto entity : m_dense) {
+        sparseEntry(Position(entity)) = static_cast<uint32_t>(InvalidIndex);
+    }
+
+    m_dense.clear();
+}
+
+uint32_t& SparseSet::sparseEntry(const size_t position) {
+    const size_t page = position / PageSize;
+
+    if (page >= m_sparse.size()) {
+        m_sparse.resize(page + 1);
+    }
+
+    if (!m_sparse[page]) {
+        m_sparse[page] = std::make_unique<uint32_t[]>(PageSize);
+        std::fill_n(m_sparse[page].get(), PageSize, static_cast<uint32_t>(InvalidIndex));
+    }
+
+    return m_sparse[page][position % PageSize];
+}
+
+size_t SparseSet::memoryBytes() const {
+    size_t bytes = (m_sparse.capacity() * sizeof(std::unique_ptr<uint32_t[]>))
+        + (m_dense.capacity() * sizeof(id_t));
+
+    for (auto& page : m_sparse) {
+        if (page) {
+            bytes += PageSize * sizeof(uint32_t);
+        }
+    }
+
+    return bytes;
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "harmful/bane/jobs/AsyncIO.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <harmful/spite/files/MappedFile.hpp>
+
+using namespace Bane;
+
+AsyncIO::AsyncIO(const uint8_t threadCount)
+    : m_threadCount(std::max<uint8_t>(threadCount, 1)) {}
+
+AsyncIO::~AsyncIO() noexcept {
+    stop();
+}
+
+AsyncIO::ReadOperation AsyncIO::read(const std::filesystem::path& path) {
+    return run(std::function<std::vector<std::byte>()>([path]() {
+        Spite::MappedFile file(path);
+        return std::vector<std::byte>(file.data(), file.data() + file.size());
+    }));
+}
+
+void AsyncIO::post(std::function<void()> request) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (!m_running) {
+            throw std::runtime_error("");
+        }
+
+        m_requests.push_back(std::move(request));
+
+        while (m_threads.size() < m_threadCount) {
+            m_threads.emplace_back(&AsyncIO::work, this);
+        }
+    }
+
+    m_wakeUp.notify_one();
+}
+
+void AsyncIO::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+    }
+
+    m_wakeUp.notify_all();
+
+    for (auto& thread : m_threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+void AsyncIO::work() {
+    while (true) {
+        std::function<void()> request;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeUp.wait(lock, [this]() { return !m_requests.empty() || !m_running; });
+
+            // The queued requests are still run once stopped.
+            if (m_requests.empty()) {
+                return;
+            }
+
+            request = std::move(m_requests.front());
+            m_requests.pop_front();
+        }
+
+        request();
+    }
+}
\ No newline at end of file
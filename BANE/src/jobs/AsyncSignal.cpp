@@ -0,0 +1,22 @@
+#include "harmful/bane/jobs/AsyncSignal.hpp"
+#include "harmful/bane/systems/System.hpp"
+
+using namespace Bane;
+
+void AsyncSignal::raise() {
+    std::vector<SystemTask::Handle> raisedTasks;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::swap(raisedTasks, m_waitingTasks);
+    }
+
+    for (auto task : raisedTasks) {
+        task.promise().system -> schedule(task);
+    }
+}
+
+void AsyncSignal::wait(SystemTask::Handle task) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_waitingTasks.push_back(task);
+}
\ No newline at end of file
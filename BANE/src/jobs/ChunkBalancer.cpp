@@ -0,0 +1,197 @@
+#include "harmful/bane/jobs/ChunkBalancer.hpp"
+#include <algorithm>
+#include <cmath>
+
+using namespace Bane;
+
+void ChunkBalancer::split(
+    const System* system,
+    const size_t amountThreads,
+    std::vector<Chunk>& chunks
+) const {
+    size_t amountComponents = system -> componentsCount();
+
+    if (amountComponents == 0) {
+        return;
+    }
+
+    if (!system -> isMultithreadable() || (amountComponents <= MinimalChunkSize)) {
+        chunks.push_back({ 0, amountComponents });
+        return;
+    }
+
+    switch (m_mode) {
+        case Mode::Static:
+            splitStatic(amountComponents, amountThreads, chunks);
+            break;
+
+        case Mode::Guided:
+            splitGuided(amountComponents, amountThreads, chunks);
+            break;
+
+        case Mode::Adaptive: {
+            auto profile = m_profiles.find(system);
+
+            if ((profile == m_profiles.end()) || !profile -> second.isMeasured) {
+                splitGuided(amountComponents, amountThreads, chunks);
+            }
+            else {
+                splitAdaptive(profile -> second, amountComponents, amountThreads, chunks);
+            }
+
+            break;
+        }
+
+        case Mode::Fixed:
+            for (size_t fromIndex = 0; fromIndex < amountComponents; fromIndex += FixedChunkSize) {
+                chunks.push_back({ fromIndex, std::min(fromIndex + FixedChunkSize, amountComponents) });
+            }
+
+            break;
+    }
+}
+
+void ChunkBalancer::update(std::span<const ChunkTiming> timings) {
+    std::unordered_map<const System*, std::array<double, AmountBuckets>> observedCosts;
+    std::unordered_map<const System*, std::array<size_t, AmountBuckets>> observedComponents;
+
+    // Spread the time of each chunk over the ranges of Components it covers.
+    for (auto& timing : timings) {
+        size_t chunkSize = timing.toIndex - timing.fromIndex;
+
+        if (chunkSize == 0) {
+            continue;
+        }
+
+        double costPerComponent = static_cast<double>(timing.duration) / static_cast<double>(chunkSize);
+        auto& costs = observedCosts[timing.system];
+        auto& components = observedComponents[timing.system];
+
+        for (size_t bucket = 0; bucket < AmountBuckets; bucket++) {
+            size_t bucketStart = BucketStart(bucket, timing.amountComponents);
+            size_t bucketEnd = BucketStart(bucket + 1, timing.amountComponents);
+            size_t overlapStart = std::max(bucketStart, timing.fromIndex);
+            size_t overlapEnd = std::min(bucketEnd, timing.toIndex);
+
+            if (overlapStart < overlapEnd) {
+                costs[bucket] += costPerComponent * static_cast<double>(overlapEnd - overlapStart);
+                components[bucket] += overlapEnd - overlapStart;
+            }
+        }
+    }
+
+    for (auto& [system, costs] : observedCosts) {
+        auto& profile = m_profiles[system];
+        auto& components = observedComponents[system];
+
+        for (size_t bucket = 0; bucket < AmountBuckets; bucket++) {
+            if (components[bucket] == 0) {
+                continue;
+            }
+
+            double observed = costs[bucket] / static_cast<double>(components[bucket]);
+
+            if (profile.isMeasured) {
+                profile.costs[bucket] += Smoothing * (observed - profile.costs[bucket]);
+            }
+            else {
+                profile.costs[bucket] = observed;
+            }
+        }
+
+        profile.isMeasured = true;
+    }
+}
+
+void ChunkBalancer::splitStatic(
+    const size_t amountComponents,
+    const size_t amountThreads,
+    std::vector<Chunk>& chunks
+) const {
+    size_t amountChunks = amountThreads * ChunksPerThread;
+    size_t chunkSize = (amountComponents + amountChunks - 1) / amountChunks;
+    chunkSize = std::max(chunkSize, MinimalChunkSize);
+
+    for (size_t fromIndex = 0; fromIndex < amountComponents; fromIndex += chunkSize) {
+        chunks.push_back({ fromIndex, std::min(fromIndex + chunkSize, amountComponents) });
+    }
+}
+
+void ChunkBalancer::splitGuided(
+    const size_t amountComponents,
+    const size_t amountThreads,
+    std::vector<Chunk>& chunks
+) const {
+    size_t fromIndex = 0;
+
+    while (fromIndex < amountComponents) {
+        size_t remaining = amountComponents - fromIndex;
+        size_t chunkSize = std::max(remaining / (2 * amountThreads), MinimalChunkSize);
+        size_t toIndex = std::min(fromIndex + chunkSize, amountComponents);
+        chunks.push_back({ fromIndex, toIndex });
+        fromIndex = toIndex;
+    }
+}
+
+void ChunkBalancer::splitAdaptive(
+    const Profile& profile,
+    const size_t amountComponents,
+    const size_t amountThreads,
+    std::vector<Chunk>& chunks
+) const {
+    // Cumulated cost at the end of each range of Components.
+    std::array<double, AmountBuckets> cumulatedCosts;
+    double totalCost = 0.;
+
+    for (size_t bucket = 0; bucket < AmountBuckets; bucket++) {
+        size_t bucketSize = BucketStart(bucket + 1, amountComponents) - BucketStart(bucket, amountComponents);
+        totalCost += profile.costs[bucket] * static_cast<double>(bucketSize);
+        cumulatedCosts[bucket] = totalCost;
+    }
+
+    size_t maximalChunks = std::min(amountThreads * ChunksPerThread, amountComponents / MinimalChunkSize);
+    auto costlyChunks = static_cast<size_t>(totalCost / MinimalChunkCost);
+    size_t amountChunks = std::clamp<size_t>(costlyChunks, 1, std::max<size_t>(maximalChunks, 1));
+
+    if ((amountChunks == 1) || (totalCost <= 0.)) {
+        splitStatic(amountComponents, std::max<size_t>(amountChunks / ChunksPerThread, 1), chunks);
+        return;
+    }
+
+    double chunkCost = totalCost / static_cast<double>(amountChunks);
+    size_t fromIndex = 0;
+    size_t bucket = 0;
+
+    for (size_t chunk = 1; (chunk < amountChunks) && (fromIndex < amountComponents); chunk++) {
+        double targetCost = chunkCost * static_cast<double>(chunk);
+
+        while ((bucket < AmountBuckets - 1) && (cumulatedCosts[bucket] < targetCost)) {
+            bucket++;
+        }
+
+        // The cost is uniform inside a range of Components.
+        size_t bucketStart = BucketStart(bucket, amountComponents);
+        double costBefore = (bucket > 0) ? cumulatedCosts[bucket - 1] : 0.;
+        double bucketCost = profile.costs[bucket];
+        size_t toIndex = bucketStart;
+
+        if (bucketCost > 0.) {
+            toIndex += static_cast<size_t>(std::ceil((targetCost - costBefore) / bucketCost));
+        }
+
+        // Less than MinimalChunkSize Components may remain: the upper bound
+        // wins.
+        toIndex = std::min(std::max(toIndex, fromIndex + MinimalChunkSize), amountComponents);
+
+        if (toIndex >= amountComponents) {
+            break;
+        }
+
+        chunks.push_back({ fromIndex, toIndex });
+        fromIndex = toIndex;
+    }
+
+    if (fromIndex < amountComponents) {
+        chunks.push_back({ fromIndex, amountComponents });
+    }
+}
\ No newline at end of file
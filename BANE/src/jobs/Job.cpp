@@ -1,101 +1,300 @@
 #include "harmful/bane/jobs/Job.hpp"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <utility>
 
 using namespace Bane;
 
 Job::Job(
     const std::string& name,
     const std::vector<System*> systems,
-    const uint8_t threadCount
+    const uint8_t threadCount,
+    EntityFactory& entities,
+    const ThreadPlacement& placement
 ) : m_name(name),
-    m_syncData(JobSynchronization(threadCount)),
-    m_systems(systems) {
-    createThreads(threadCount);
-    startThreads();
+    m_systems(systems),
+    m_threads(std::make_shared<WorkerPool>(threadCount, placement)),
+    m_placement(placement),
+    m_entities(&entities),
+    m_frameStatistics(m_threads -> size()),
+    m_statistics(m_threads -> size()) {
+    for (size_t threadIndex = 0; threadIndex < m_threads -> size(); threadIndex++) {
+        m_commands.push_back(std::make_unique<CommandBuffer>(entities));
+    }
+}
+
+Job::Job(
+    const std::string& name,
+    const std::vector<System*> systems,
+    std::shared_ptr<WorkerPool> threads,
+    EntityFactory& entities
+) : m_name(name),
+    m_systems(systems),
+    m_threads(std::move(threads)),
+    m_ownsThreads(false),
+    m_entities(&entities),
+    m_frameStatistics(m_threads ? m_threads -> size() : 0),
+    m_statistics(m_threads ? m_threads -> size() : 0) {
+    if (!m_threads) {
+        throw std::runtime_error("");
+    }
+
+    for (size_t threadIndex = 0; threadIndex < m_threads -> size(); threadIndex++) {
+        m_commands.push_back(std::make_unique<CommandBuffer>(entities));
+    }
 }
 
 void Job::execute() {
-    m_dropEntities.clear();
-    defineThreadsCharge();
+    submit(m_systems);
+    wait();
+    endFrame();
+}
+
+void Job::submit(std::span<System* const> systems) {
+    uint32_t amountStreams = prepare(systems, 0);
 
-    // Make the threads run their loop.
-    m_syncData.condition().notify_all();
-    
-    // Wait all threads have done their loop.
-    m_syncData.syncBarrier().arrive_and_wait();
-    
-    // Fill the drop entities list.
-    for (auto& thread : m_threads) {
-        m_dropEntities.splice(
-            m_dropEntities.begin(),
-            thread.dropEntities()
-        );
+    if (amountStreams > 0) {
+        m_entities -> beginReservation(amountStreams);
+        m_ownsReservation = true;
     }
+
+    launch();
 }
 
-void Job::stop() {
-    for (auto& thread : m_threads) {
-        thread.stop();
+uint32_t Job::prepare(std::span<System* const> systems, const uint32_t firstStream) {
+    computeChunks(systems, firstStream);
+    return m_isDeterministic ? static_cast<uint32_t>(m_contexts.size()) : 0;
+}
+
+void Job::launch() {
+    if (m_chunks.empty()) {
+        return;
+    }
+
+    // Run the chunks on the threads.
+    m_submissionTime = Now();
+    m_chunksGroup.add(m_chunks.size());
+    m_threads -> submit(m_chunks);
+}
+
+void Job::wait() {
+    m_chunksGroup.wait();
+
+    if (m_ownsReservation) {
+        m_entities -> endReservation();
+        m_ownsReservation = false;
+    }
+
+    m_frameStatistics.record(m_timings, m_submissionTime);
+    m_balancer.update(m_timings);
+    m_timings.clear();
+}
+
+void Job::collectCommands(CommandBuffer& commands) {
+    for (auto& threadCommands : m_commands) {
+        commands.append(*threadCommands);
+        threadCommands -> clear();
+    }
+
+    for (size_t chunkIndex = 0; chunkIndex < m_amountChunkCommands; chunkIndex++) {
+        commands.append(*m_chunkCommands[chunkIndex]);
+        m_chunkCommands[chunkIndex] -> clear();
     }
+
+    m_amountChunkCommands = 0;
 }
 
-void Job::createThreads(const uint8_t threadCount) {
-    JobSynchronizationRW jobSync(m_syncData);
+void Job::endFrame() {
+    std::swap(m_statistics, m_frameStatistics);
+    m_frameStatistics.clear();
+    m_completion.raise();
+}
 
-    for (uint8_t index = 0; index < threadCount; index++) {
-        m_threads.push_back(ThreadJob(jobSync));
+void Job::setBalancing(const ChunkBalancer::Mode mode) {
+    if (m_isDeterministic) {
+        m_balancingMode = mode;
+    }
+    else {
+        m_balancer.setMode(mode);
+    }
+}
+
+void Job::setDeterministic(const bool deterministic) {
+    if (deterministic == m_isDeterministic) {
+        return;
+    }
+
+    if (deterministic) {
+        m_balancingMode = m_balancer.mode();
+        m_balancer.setMode(ChunkBalancer::Mode::Fixed);
+    }
+    else {
+        m_balancer.setMode(m_balancingMode);
     }
+
+    m_isDeterministic = deterministic;
 }
 
-void Job::startThreads() {
-    for (auto& thread : m_threads) {
-        thread.setProcessedSystems(m_systems);
-        thread.start();
+void Job::stop() {
+    if (m_ownsThreads) {
+        m_threads -> stop();
     }
 }
 
-void Job::defineThreadsCharge() {
-    std::unordered_map<System*, std::vector<uint32_t>> threadCharge;
-    computeThreadCharge(threadCharge);
-    computeThreadChargeBounds(threadCharge);
+bool Job::contains(const System* system) const {
+    return std::find(m_systems.begin(), m_systems.end(), system) != m_systems.end();
 }
 
-void Job::computeThreadCharge(std::unordered_map<System*, std::vector<uint32_t>>& threadCharge) {
-    size_t amountThreads = m_threads.size();
+void Job::computeChunks(
+    std::span<System* const> systems,
+    const uint32_t firstStream
+) {
+    m_chunks.clear();
+    m_timings.clear();
+    m_contexts.clear();
+    m_readyTasks.clear();
+    size_t amountThreads = m_threads -> size();
+    std::vector<ChunkBalancer::Chunk> ranges;
 
-    for (auto& system : m_systems) {
-        size_t amountComponents = system->componentsCount();
+    // Range of m_readyTasks resumed by each chunk, and the SystemTasks
+    // resumed on their own.
+    std::vector<std::pair<size_t, size_t>> chunkTasks;
+    std::vector<size_t> parallelTasks;
 
-        if (!system->isMultithreadable()) {
-            threadCharge[system].resize(amountComponents);
+    for (auto& system : systems) {
+        if (!contains(system)) {
+            continue;
         }
-        else {
-            auto amountComponentsPerThread = static_cast<uint32_t>(amountComponents / amountThreads);
-            auto extraAmountComponents = static_cast<uint32_t>(amountComponents % amountThreads);
 
-            const auto ThreadIndexWithExtra = 0;
-            threadCharge[system][ThreadIndexWithExtra] = amountComponentsPerThread + extraAmountComponents;
+        size_t firstTask = m_readyTasks.size();
+        system -> takeReadyTasks(m_readyTasks);
+        size_t amountTasks = m_readyTasks.size() - firstTask;
 
-            for (size_t threadIndex = 1; threadIndex < amountThreads; threadIndex++) {
-                threadCharge[system][threadIndex] = amountComponentsPerThread;
+        ranges.clear();
+        m_balancer.split(system, amountThreads, ranges);
+
+        if (system -> isMultithreadable()) {
+            for (size_t taskIndex = firstTask; taskIndex < m_readyTasks.size(); taskIndex++) {
+                parallelTasks.push_back(taskIndex);
             }
+
+            amountTasks = 0;
+        }
+        else if (ranges.empty() && (amountTasks > 0)) {
+            // No Component to process, but SystemTasks to resume.
+            ranges.push_back({ 0, 0 });
+        }
+
+        for (auto& range : ranges) {
+            m_timings.push_back({
+                system,
+                system -> componentsCount(),
+                range.fromIndex,
+                range.toIndex,
+                0,
+                0,
+                0
+            });
+
+            chunkTasks.emplace_back(firstTask, amountTasks);
+            amountTasks = 0;
         }
     }
-}
 
-void Job::computeThreadChargeBounds(std::unordered_map<System*, std::vector<uint32_t>>& threadCharge) {
-    size_t amountThreads = m_threads.size();
+    // The chunks of several submissions may be collected at once.
+    size_t firstChunkCommands = m_amountChunkCommands;
+    size_t amountContexts = m_timings.size() + parallelTasks.size();
+
+    if (m_isDeterministic) {
+        m_amountChunkCommands += amountContexts;
+
+        while (m_chunkCommands.size() < m_amountChunkCommands) {
+            m_chunkCommands.push_back(std::make_unique<CommandBuffer>(*m_entities));
+        }
+    }
+
+    // The measures must not move anymore once the chunks point to them. The
+    // resumptions of parallel SystemTasks come after the chunks, with no
+    // measure.
+    for (size_t contextIndex = 0; contextIndex < amountContexts; contextIndex++) {
+        CommandBuffer* chunkCommands = nullptr;
+
+        if (m_isDeterministic) {
+            chunkCommands = m_chunkCommands[firstChunkCommands + contextIndex].get();
+            chunkCommands -> setStream(firstStream + static_cast<uint32_t>(contextIndex));
+        }
+
+        bool isChunk = contextIndex < m_timings.size();
 
-    for (auto& system : m_systems) {
-        uint32_t fromIndex = 0;
-        uint32_t toIndex = 0;
-        size_t amountThreadsForSystem = threadCharge[system].size();
+        m_contexts.push_back({
+            this,
+            isChunk ? &m_timings[contextIndex] : nullptr,
+            chunkCommands,
+            RandomStream::Mix(m_seed, contextIndex),
+            isChunk ? chunkTasks[contextIndex].first : parallelTasks[contextIndex - m_timings.size()],
+            isChunk ? chunkTasks[contextIndex].second : 1
+        });
+    }
+
+    for (auto& context : m_contexts) {
+        ThreadTask chunk;
+        chunk.context = &context;
+        chunk.group = &m_chunksGroup;
 
-        for (size_t threadIndex = 0; threadIndex < amountThreadsForSystem; threadIndex++) {
-            auto& thread = m_threads[threadIndex];
-            auto amountComponentsForThread = threadCharge[system][threadIndex];
-            toIndex = toIndex + amountComponentsForThread;
-            thread.setFromToComponents(system, fromIndex, toIndex);
-            fromIndex = fromIndex + amountComponentsForThread;
+        if (context.timing) {
+            chunk.function = &Job::ProcessChunk;
+            chunk.fromIndex = context.timing -> fromIndex;
+            chunk.toIndex = context.timing -> toIndex;
         }
+        else {
+            chunk.function = &Job::ResumeTasks;
+            chunk.fromIndex = context.firstTask;
+            chunk.toIndex = context.firstTask + context.amountTasks;
+        }
+
+        m_chunks.push_back(chunk);
+    }
+}
+
+void Job::ProcessChunk(ThreadJob& worker, const ThreadTask& task) {
+    auto context = static_cast<ChunkContext*>(task.context);
+    auto timing = context -> timing;
+    auto& commands = context -> commands
+        ? *(context -> commands)
+        : *(context -> job -> m_commands[worker.index()]);
+    commands.random().seed(context -> seed);
+
+    auto start = Now();
+    auto& readyTasks = context -> job -> m_readyTasks;
+
+    for (size_t taskIndex = 0; taskIndex < context -> amountTasks; taskIndex++) {
+        timing -> system -> resume(readyTasks[context -> firstTask + taskIndex], commands);
     }
+
+    timing -> system -> process(commands, task.fromIndex, task.toIndex);
+    auto end = Now();
+
+    timing -> duration = end - start;
+    timing -> thread = worker.index();
+    timing -> end = end;
+}
+
+void Job::ResumeTasks(ThreadJob& worker, const ThreadTask& task) {
+    auto context = static_cast<ChunkContext*>(task.context);
+    auto job = context -> job;
+    auto& commands = context -> commands
+        ? *(context -> commands)
+        : *(job -> m_commands[worker.index()]);
+    commands.random().seed(context -> seed);
+
+    for (size_t taskIndex = task.fromIndex; taskIndex < task.toIndex; taskIndex++) {
+        auto resumed = job -> m_readyTasks[taskIndex];
+        resumed.promise().system -> resume(resumed, commands);
+    }
+}
+
+std::int64_t Job::Now() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
 }
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "harmful/bane/jobs/JobStatistics.hpp"
+#include <algorithm>
+
+using namespace Bane;
+
+JobStatistics::JobStatistics(const size_t amountThreads)
+    : m_threads(amountThreads),
+      m_executionBusyTimes(amountThreads, 0) {}
+
+void JobStatistics::record(
+    std::span<const ChunkBalancer::ChunkTiming> timings,
+    const std::int64_t start
+) {
+    if (timings.empty()) {
+        return;
+    }
+
+    std::fill(m_executionBusyTimes.begin(), m_executionBusyTimes.end(), 0);
+    std::int64_t end = start;
+
+    for (auto& timing : timings) {
+        size_t amountComponents = timing.toIndex - timing.fromIndex;
+        auto systemTimings = std::find_if(
+            m_systems.begin(),
+            m_systems.end(),
+            [&timing](const SystemTimings& candidate) {
+                return (candidate.system == timing.system) && (candidate.thread == timing.thread);
+            }
+        );
+
+        if (systemTimings == m_systems.end()) {
+            m_systems.push_back({ timing.system, timing.thread, 0, 0, 0 });
+            systemTimings = m_systems.end() - 1;
+        }
+
+        systemTimings -> busyTime += timing.duration;
+        systemTimings -> amountComponents += amountComponents;
+        systemTimings -> amountChunks++;
+
+        auto& threadTimings = m_threads[timing.thread];
+        threadTimings.busyTime += timing.duration;
+        threadTimings.amountComponents += amountComponents;
+        threadTimings.amountChunks++;
+
+        m_executionBusyTimes[timing.thread] += timing.duration;
+        end = std::max(end, timing.end);
+    }
+
+    std::int64_t wallTime = end - start;
+
+    for (size_t threadIndex = 0; threadIndex < m_threads.size(); threadIndex++) {
+        m_threads[threadIndex].waitTime += std::max<std::int64_t>(wallTime - m_executionBusyTimes[threadIndex], 0);
+    }
+
+    m_wallTime += wallTime;
+    m_amountExecutions++;
+}
+
+void JobStatistics::clear() {
+    m_systems.clear();
+    std::fill(m_threads.begin(), m_threads.end(), ThreadTimings());
+    m_wallTime = 0;
+    m_amountExecutions = 0;
+}
+
+JobStatistics::SystemTimings JobStatistics::system(const System* system) const {
+    SystemTimings total { system, AllThreads, 0, 0, 0 };
+
+    for (auto& systemTimings : m_systems) {
+        if (systemTimings.system == system) {
+            total.busyTime += systemTimings.busyTime;
+            total.amountComponents += systemTimings.amountComponents;
+            total.amountChunks += systemTimings.amountChunks;
+        }
+    }
+
+    return total;
+}
\ No newline at end of file
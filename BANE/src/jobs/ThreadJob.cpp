@@ -1,55 +1,95 @@
 #include "harmful/bane/jobs/ThreadJob.hpp"
+#include "harmful/bane/jobs/WorkerPool.hpp"
+#include <harmful/doom/utils/CPUTopology.hpp>
 
 using namespace Bane;
 
-ThreadJob::ThreadJob(const JobSynchronizationRW& sync)
-    : m_syncData(sync) {}
+thread_local ThreadJob* ThreadJob::CurrentThreadJob = nullptr;
 
-void ThreadJob::setProcessedSystems(const std::vector<System*>& systems) {
-    for (auto& system : systems) {
-        m_systems.insert(system);
+ThreadJob::ThreadJob(
+    WorkerPool& pool,
+    const size_t index,
+    const std::vector<uint32_t>& cores
+) : m_pool(pool),
+    m_index(index),
+    m_cores(cores) {}
+
+void ThreadJob::start() {
+    m_innerThread = std::thread(&ThreadJob::run, this);
+}
+
+void ThreadJob::join() {
+    if (m_innerThread.joinable()) {
+        m_innerThread.join();
     }
 }
 
-void ThreadJob::setFromToComponents(
-    System* system,
-    const size_t fromIndex,
-    const size_t toIndex
-) {
-    if (!m_systems.contains(system)) {
-        return;
+void ThreadJob::push(const ThreadTask& task) {
+    std::lock_guard<std::mutex> lock(m_tasksMutex);
+    m_tasks.push_back(task);
+}
+
+bool ThreadJob::pop(ThreadTask& task) {
+    std::lock_guard<std::mutex> lock(m_tasksMutex);
+
+    if (m_tasks.empty()) {
+        return false;
     }
 
-    m_fromToComponents[system] = { fromIndex, toIndex };
+    task = m_tasks.back();
+    m_tasks.pop_back();
+    return true;
 }
 
-void ThreadJob::start() {
-    m_continue = true;
-    m_innerThread = std::thread(&ThreadJob::run, this);
+bool ThreadJob::steal(ThreadTask& task) {
+    std::lock_guard<std::mutex> lock(m_tasksMutex);
+
+    if (m_tasks.empty()) {
+        return false;
+    }
+
+    task = m_tasks.front();
+    m_tasks.pop_front();
+    return true;
 }
 
-void ThreadJob::stop() {
-    m_continue = false;
+bool ThreadJob::help() {
+    ThreadTask task;
+
+    if (pop(task) || m_pool.steal(*this, task)) {
+        execute(task);
+        return true;
+    }
+
+    return false;
 }
 
 void ThreadJob::run() {
-    while (m_continue) {
-        std::unique_lock<std::mutex> lock(m_syncData.mutex());
-        m_syncData.condition().wait(
-            lock,
-            [&]() { return m_syncData.waitFlag(); }
-        );
-        processSystems();
-        m_syncData.syncBarrier().arrive_and_wait();
+    CurrentThreadJob = this;
+    ThreadTask task;
+
+    // The placement is a hint: the thread still works if it fails.
+    if (!m_cores.empty()) {
+        Doom::CPUTopology::PinCurrentThread(m_cores);
     }
+
+    while (m_pool.isRunning()) {
+        if (pop(task) || m_pool.steal(*this, task)) {
+            execute(task);
+        }
+        else {
+            m_pool.sleep();
+        }
+    }
+
+    CurrentThreadJob = nullptr;
 }
 
-void ThreadJob::processSystems() {
-    for (auto& pair : m_fromToComponents) {
-        auto system = pair.first;
-        auto fromIndex = pair.second.fromIndex;
-        auto toIndex = pair.second.toIndex;
+void ThreadJob::execute(const ThreadTask& task) {
+    m_pool.onTaskTaken();
+    task.function(*this, task);
 
-        m_dropEntities = system -> process(fromIndex, toIndex);
+    if (task.group) {
+        task.group -> done();
     }
 }
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include "harmful/bane/jobs/ThreadPlacement.hpp"
+#include <algorithm>
+#include <map>
+#include <tuple>
+
+using namespace Bane;
+
+ThreadPlacement ThreadPlacement::Cores(const std::vector<uint32_t>& cores) {
+    ThreadPlacement placement;
+    placement.m_policy = Policy::Cores;
+    placement.m_cores = cores;
+    return placement;
+}
+
+ThreadPlacement ThreadPlacement::SpreadPhysicalCores() {
+    ThreadPlacement placement;
+    placement.m_policy = Policy::SpreadPhysicalCores;
+    return placement;
+}
+
+ThreadPlacement ThreadPlacement::AvoidSMT() {
+    ThreadPlacement placement;
+    placement.m_policy = Policy::AvoidSMT;
+    return placement;
+}
+
+ThreadPlacement ThreadPlacement::NumaNode(const uint32_t node) {
+    ThreadPlacement placement;
+    placement.m_policy = Policy::NumaNode;
+    placement.m_numaNode = node;
+    return placement;
+}
+
+std::vector<uint32_t> ThreadPlacement::coresOf(
+    const size_t threadIndex,
+    const Doom::CPUTopology& topology
+) const {
+    std::vector<uint32_t> cores;
+
+    switch (m_policy) {
+        case Policy::None:
+            break;
+
+        case Policy::Cores:
+            if (!m_cores.empty()) {
+                cores.push_back(m_cores[threadIndex % m_cores.size()]);
+            }
+
+            break;
+
+        case Policy::SpreadPhysicalCores:
+        case Policy::AvoidSMT: {
+            auto order = SpreadOrder(topology, m_policy == Policy::SpreadPhysicalCores);
+
+            if (!order.empty()) {
+                cores.push_back(order[threadIndex % order.size()]);
+            }
+
+            break;
+        }
+
+        case Policy::NumaNode:
+            for (auto& core : topology.cores()) {
+                if (core.numaNode == m_numaNode) {
+                    cores.push_back(core.index);
+                }
+            }
+
+            break;
+    }
+
+    return cores;
+}
+
+std::vector<uint32_t> ThreadPlacement::SpreadOrder(
+    const Doom::CPUTopology& topology,
+    const bool withSiblings
+) {
+    // Rank of each physical core in its package.
+    std::map<uint32_t, uint32_t> physicalRanks;
+    std::map<uint32_t, uint32_t> amountPerPackage;
+
+    for (auto& core : topology.cores()) {
+        if (core.siblingRank == 0) {
+            physicalRanks[core.physicalCore] = amountPerPackage[core.package]++;
+        }
+    }
+
+    std::vector<std::tuple<uint32_t, uint32_t, uint32_t, uint32_t>> sortedCores;
+
+    for (auto& core : topology.cores()) {
+        if (withSiblings || (core.siblingRank == 0)) {
+            sortedCores.emplace_back(core.siblingRank, physicalRanks[core.physicalCore], core.package, core.index);
+        }
+    }
+
+    std::sort(sortedCores.begin(), sortedCores.end());
+    std::vector<uint32_t> order;
+
+    for (auto& core : sortedCores) {
+        order.push_back(std::get<3>(core));
+    }
+
+    return order;
+}
\ No newline at end of file
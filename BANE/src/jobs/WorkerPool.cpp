@@ -0,0 +1,128 @@
+#include "harmful/bane/jobs/WorkerPool.hpp"
+#include <algorithm>
+#include <thread>
+
+using namespace Bane;
+
+WorkerPool::WorkerPool(
+    const uint8_t threadCount,
+    const ThreadPlacement& placement
+) {
+    const size_t amountThreads = std::max<size_t>(threadCount, 1);
+    auto& topology = Doom::CPUTopology::Get();
+
+    for (size_t index = 0; index < amountThreads; index++) {
+        auto cores = placement.coresOf(index, topology);
+        m_workers.push_back(std::make_unique<ThreadJob>(*this, index, cores));
+    }
+
+    for (auto& worker : m_workers) {
+        worker -> start();
+    }
+}
+
+WorkerPool::~WorkerPool() noexcept {
+    stop();
+}
+
+void WorkerPool::submit(const ThreadTask& task) {
+    m_pendingTasks.fetch_add(1, std::memory_order_acq_rel);
+    receiver().push(task);
+    wakeUp();
+}
+
+void WorkerPool::submit(std::span<const ThreadTask> tasks) {
+    if (tasks.empty()) {
+        return;
+    }
+
+    m_pendingTasks.fetch_add(tasks.size(), std::memory_order_acq_rel);
+    const size_t amountWorkers = m_workers.size();
+    const size_t firstWorker = m_nextWorker.fetch_add(tasks.size(), std::memory_order_relaxed);
+
+    for (size_t taskIndex = 0; taskIndex < tasks.size(); taskIndex++) {
+        auto& worker = m_workers[(firstWorker + taskIndex) % amountWorkers];
+        worker -> push(tasks[taskIndex]);
+    }
+
+    wakeUp();
+}
+
+void WorkerPool::wait(const TaskGroup& group) {
+    auto current = ThreadJob::Current();
+
+    if (!current || (&(current -> pool()) != this)) {
+        group.wait();
+        return;
+    }
+
+    // The awaited ThreadTasks may be running on other threads: yield while
+    // there is nothing left to help with.
+    while (!group.isFinished()) {
+        if (!current -> help()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void WorkerPool::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+
+        if (!m_running.exchange(false, std::memory_order_acq_rel)) {
+            return;
+        }
+    }
+
+    m_wakeUp.notify_all();
+
+    for (auto& worker : m_workers) {
+        worker -> join();
+    }
+}
+
+bool WorkerPool::steal(ThreadJob& thief, ThreadTask& task) {
+    const size_t amountWorkers = m_workers.size();
+
+    for (size_t offset = 1; offset < amountWorkers; offset++) {
+        auto& victim = m_workers[(thief.index() + offset) % amountWorkers];
+
+        if (victim -> steal(task)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void WorkerPool::sleep() {
+    std::unique_lock<std::mutex> lock(m_sleepMutex);
+    m_wakeUp.wait(
+        lock,
+        [&]() {
+            return !isRunning()
+                || (m_pendingTasks.load(std::memory_order_acquire) > 0);
+        }
+    );
+}
+
+ThreadJob& WorkerPool::receiver() {
+    auto current = ThreadJob::Current();
+
+    if (current && (&current -> pool() == this)) {
+        return *current;
+    }
+
+    auto index = m_nextWorker.fetch_add(1, std::memory_order_relaxed);
+    return *m_workers[index % m_workers.size()];
+}
+
+void WorkerPool::wakeUp() {
+    // Taking the mutex prevents a ThreadJob from missing the notification
+    // between its check of the pending ThreadTasks and its wait.
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+
+    m_wakeUp.notify_all();
+}
\ No newline at end of file
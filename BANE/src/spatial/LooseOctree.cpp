@@ -0,0 +1,304 @@
+#include "harmful/bane/spatial/LooseOctree.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+
+using namespace Bane;
+
+LooseOctree::LooseOctree(
+    const Mind::Point3Df& center,
+    const float halfSize,
+    const uint32_t maxDepth
+) : m_maxDepth(maxDepth) {
+    if (!(halfSize > 0.f)) {
+        throw std::runtime_error("");
+    }
+
+    Node root;
+    root.center = Coordinates(center);
+    root.halfSize = halfSize;
+    root.depth = 0;
+    m_nodes.push_back(std::move(root));
+}
+
+void LooseOctree::update(std::span<const Entry> entries) {
+    m_moves.clear();
+
+    for (auto& entry : entries) {
+        uint32_t entityIndex = Entity(entry.id).index();
+
+        if (entityIndex >= m_locations.size()) {
+            m_locations.resize(entityIndex + 1);
+        }
+
+        auto& location = m_locations[entityIndex];
+
+        // A destroyed Entity whose index has been reused is replaced.
+        if ((location.node != NoNode) && (m_nodes[location.node].entries[location.index].id != entry.id)) {
+            detach(location);
+            m_size--;
+        }
+
+        if ((location.node != NoNode) && fits(m_nodes[location.node], entry)) {
+            m_nodes[location.node].entries[location.index] = entry;
+            continue;
+        }
+
+        if (location.node != NoNode) {
+            detach(location);
+        }
+        else {
+            m_size++;
+        }
+
+        m_moves.push_back(entry);
+    }
+
+    for (auto& entry : m_moves) {
+        insert(entry);
+    }
+}
+
+void LooseOctree::remove(const id_t id) {
+    uint32_t entityIndex = Entity(id).index();
+
+    if (entityIndex >= m_locations.size()) {
+        return;
+    }
+
+    auto& location = m_locations[entityIndex];
+
+    if ((location.node != NoNode) && (m_nodes[location.node].entries[location.index].id == id)) {
+        detach(location);
+        m_size--;
+    }
+}
+
+void LooseOctree::clear() {
+    m_nodes.resize(1);
+    m_nodes[0].entries.clear();
+    m_nodes[0].firstChild = NoNode;
+    m_nodes[0].amountEntries = 0;
+    m_locations.clear();
+    m_size = 0;
+}
+
+void LooseOctree::queryBox(
+    const Mind::Point3Df& minimum,
+    const Mind::Point3Df& maximum,
+    std::vector<id_t>& results
+) const {
+    auto boxMinimum = Coordinates(minimum);
+    auto boxMaximum = Coordinates(maximum);
+
+    forEachNode(boxMinimum, boxMaximum, [&](const std::vector<Entry>& entries) {
+        for (auto& entry : entries) {
+            if (Intersects(entry, boxMinimum, boxMaximum)) {
+                results.push_back(entry.id);
+            }
+        }
+    });
+}
+
+void LooseOctree::querySphere(
+    const Mind::Point3Df& center,
+    const float radius,
+    std::vector<id_t>& results
+) const {
+    auto sphereCenter = Coordinates(center);
+    std::array<float, 3> boxMinimum;
+    std::array<float, 3> boxMaximum;
+
+    for (size_t axis = 0; axis < 3; axis++) {
+        boxMinimum[axis] = sphereCenter[axis] - radius;
+        boxMaximum[axis] = sphereCenter[axis] + radius;
+    }
+
+    forEachNode(boxMinimum, boxMaximum, [&](const std::vector<Entry>& entries) {
+        for (auto& entry : entries) {
+            if (Intersects(entry, sphereCenter, radius)) {
+                results.push_back(entry.id);
+            }
+        }
+    });
+}
+
+void LooseOctree::nearest(
+    const Mind::Point3Df& point,
+    const size_t amount,
+    std::vector<id_t>& results
+) const {
+    if ((amount == 0) || (m_size == 0)) {
+        return;
+    }
+
+    auto position = Coordinates(point);
+
+    // The best candidates, as a heap whose top is the farthest one.
+    std::vector<Neighbour> candidates;
+    candidates.reserve(std::min(amount, m_size) + 1);
+
+    // Nodes to visit, the nearest first. The positions stored in a node are
+    // in its cell, except the ones out of the bounds kept in the root.
+    using PendingNode = std::pair<float, uint32_t>;
+    std::priority_queue<PendingNode, std::vector<PendingNode>, std::greater<PendingNode>> pending;
+    pending.emplace(0.f, 0);
+
+    while (!pending.empty()) {
+        auto [nodeDistance, nodeIndex] = pending.top();
+        pending.pop();
+
+        if ((candidates.size() == amount) && (nodeDistance > candidates.front().distance)) {
+            break;
+        }
+
+        auto& node = m_nodes[nodeIndex];
+
+        for (auto& entry : node.entries) {
+            Neighbour candidate { Distance(entry.position, position), entry.id };
+
+            if (candidates.size() < amount) {
+                candidates.push_back(candidate);
+                std::push_heap(candidates.begin(), candidates.end());
+            }
+            else if (candidate < candidates.front()) {
+                std::pop_heap(candidates.begin(), candidates.end());
+                candidates.back() = candidate;
+                std::push_heap(candidates.begin(), candidates.end());
+            }
+        }
+
+        if (node.firstChild == NoNode) {
+            continue;
+        }
+
+        for (uint32_t child = node.firstChild; child < node.firstChild + 8; child++) {
+            auto& childNode = m_nodes[child];
+
+            if (childNode.amountEntries == 0) {
+                continue;
+            }
+            std::array<float, 3> cellMinimum;
+            std::array<float, 3> cellMaximum;
+
+            for (size_t axis = 0; axis < 3; axis++) {
+                cellMinimum[axis] = childNode.center[axis] - childNode.halfSize;
+                cellMaximum[axis] = childNode.center[axis] + childNode.halfSize;
+            }
+
+            pending.emplace(DistanceToBox(position, cellMinimum, cellMaximum), child);
+        }
+    }
+
+    std::sort_heap(candidates.begin(), candidates.end());
+
+    for (auto& candidate : candidates) {
+        results.push_back(candidate.id);
+    }
+}
+
+bool LooseOctree::fits(const Node& node, const Entry& entry) const {
+    auto isInCell = [&entry](const Node& cell) {
+        for (size_t axis = 0; axis < 3; axis++) {
+            if (std::abs(entry.position[axis] - cell.center[axis]) > cell.halfSize) {
+                return false;
+            }
+        }
+
+        return true;
+    };
+
+    // The positions out of the bounds are kept in the root.
+    if (!isInCell(m_nodes[0])) {
+        return node.depth == 0;
+    }
+
+    if (!isInCell(node) || ((node.depth > 0) && (entry.radius > node.halfSize))) {
+        return false;
+    }
+
+    // The Entry must not fit in a child.
+    return (node.depth == m_maxDepth) || (entry.radius > (node.halfSize * 0.5f));
+}
+
+void LooseOctree::insert(const Entry& entry) {
+    uint32_t nodeIndex = 0;
+
+    // The depth is checked too, in case of rounding errors on the borders
+    // of the cells.
+    while ((m_nodes[nodeIndex].depth < m_maxDepth) && !fits(m_nodes[nodeIndex], entry)) {
+        if (m_nodes[nodeIndex].firstChild == NoNode) {
+            auto parentCenter = m_nodes[nodeIndex].center;
+            float childHalfSize = m_nodes[nodeIndex].halfSize * 0.5f;
+            uint32_t childDepth = m_nodes[nodeIndex].depth + 1;
+            m_nodes[nodeIndex].firstChild = static_cast<uint32_t>(m_nodes.size());
+
+            for (uint32_t octant = 0; octant < 8; octant++) {
+                Node child;
+                child.halfSize = childHalfSize;
+                child.depth = childDepth;
+                child.parent = nodeIndex;
+
+                for (size_t axis = 0; axis < 3; axis++) {
+                    bool isUpper = (octant >> axis) & 1;
+                    child.center[axis] = parentCenter[axis] + (isUpper ? childHalfSize : -childHalfSize);
+                }
+
+                m_nodes.push_back(std::move(child));
+            }
+        }
+
+        auto& node = m_nodes[nodeIndex];
+        uint32_t octant = 0;
+
+        for (size_t axis = 0; axis < 3; axis++) {
+            if (entry.position[axis] >= node.center[axis]) {
+                octant |= 1u << axis;
+            }
+        }
+
+        nodeIndex = node.firstChild + octant;
+    }
+
+    auto& node = m_nodes[nodeIndex];
+    auto& location = m_locations[Entity(entry.id).index()];
+    location.node = nodeIndex;
+    location.index = static_cast<uint32_t>(node.entries.size());
+    node.entries.push_back(entry);
+
+    for (uint32_t ancestor = nodeIndex; ancestor != NoNode; ancestor = m_nodes[ancestor].parent) {
+        m_nodes[ancestor].amountEntries++;
+    }
+}
+
+void LooseOctree::detach(Location& location) {
+    auto& entries = m_nodes[location.node].entries;
+
+    if (location.index + 1 < entries.size()) {
+        entries[location.index] = entries.back();
+        m_locations[Entity(entries[location.index].id).index()].index = location.index;
+    }
+
+    entries.pop_back();
+
+    for (uint32_t ancestor = location.node; ancestor != NoNode; ancestor = m_nodes[ancestor].parent) {
+        m_nodes[ancestor].amountEntries--;
+    }
+
+    location.node = NoNode;
+}
+
+void LooseOctree::boundsOf(
+    const Node& node,
+    std::array<float, 3>& minimum,
+    std::array<float, 3>& maximum
+) const {
+    float reach = node.halfSize * 2.f;
+
+    for (size_t axis = 0; axis < 3; axis++) {
+        minimum[axis] = node.center[axis] - reach;
+        maximum[axis] = node.center[axis] + reach;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,264 @@
+#include "harmful/bane/spatial/SpatialHashGrid.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+
+using namespace Bane;
+
+SpatialHashGrid::SpatialHashGrid(const float cellSize)
+    : m_cellSize(cellSize) {
+    if (!(cellSize > 0.f)) {
+        throw std::runtime_error("");
+    }
+}
+
+void SpatialHashGrid::update(std::span<const Entry> entries) {
+    m_moves.clear();
+
+    for (auto& entry : entries) {
+        uint32_t entityIndex = Entity(entry.id).index();
+
+        if (entityIndex >= m_locations.size()) {
+            m_locations.resize(entityIndex + 1);
+        }
+
+        auto& location = m_locations[entityIndex];
+        uint64_t key = KeyOf(cellOf(entry.position));
+        m_maxRadius = std::max(m_maxRadius, entry.radius);
+
+        // A destroyed Entity whose index has been reused is replaced.
+        if (location.cell && ((*location.cell)[location.index].id != entry.id)) {
+            detach(location);
+            m_size--;
+        }
+
+        if (location.cell && (location.key == key)) {
+            (*location.cell)[location.index] = entry;
+            continue;
+        }
+
+        if (location.cell) {
+            detach(location);
+        }
+        else {
+            m_size++;
+        }
+
+        m_moves.emplace_back(key, entry);
+    }
+
+    // Group the moves by cell, so that each cell is found once.
+    std::sort(m_moves.begin(), m_moves.end(), [](const auto& first, const auto& second) {
+        return (first.first < second.first)
+            || ((first.first == second.first) && (first.second.id < second.second.id));
+    });
+
+    for (size_t moveIndex = 0; moveIndex < m_moves.size();) {
+        uint64_t key = m_moves[moveIndex].first;
+        auto& cell = m_cells[key];
+
+        for (; (moveIndex < m_moves.size()) && (m_moves[moveIndex].first == key); moveIndex++) {
+            append(cell, key, m_moves[moveIndex].second);
+        }
+    }
+}
+
+void SpatialHashGrid::remove(const id_t id) {
+    uint32_t entityIndex = Entity(id).index();
+
+    if (entityIndex >= m_locations.size()) {
+        return;
+    }
+
+    auto& location = m_locations[entityIndex];
+
+    if (location.cell && ((*location.cell)[location.index].id == id)) {
+        detach(location);
+        m_size--;
+    }
+}
+
+void SpatialHashGrid::clear() {
+    m_cells.clear();
+    m_locations.clear();
+    m_size = 0;
+    m_maxRadius = 0.f;
+}
+
+void SpatialHashGrid::queryBox(
+    const Mind::Point3Df& minimum,
+    const Mind::Point3Df& maximum,
+    std::vector<id_t>& results
+) const {
+    auto boxMinimum = Coordinates(minimum);
+    auto boxMaximum = Coordinates(maximum);
+    std::array<float, 3> reachMinimum;
+    std::array<float, 3> reachMaximum;
+
+    for (size_t axis = 0; axis < 3; axis++) {
+        reachMinimum[axis] = boxMinimum[axis] - m_maxRadius;
+        reachMaximum[axis] = boxMaximum[axis] + m_maxRadius;
+    }
+
+    forEachCell(cellOf(reachMinimum), cellOf(reachMaximum), [&](const std::vector<Entry>& cell) {
+        for (auto& entry : cell) {
+            if (Intersects(entry, boxMinimum, boxMaximum)) {
+                results.push_back(entry.id);
+            }
+        }
+    });
+}
+
+void SpatialHashGrid::querySphere(
+    const Mind::Point3Df& center,
+    const float radius,
+    std::vector<id_t>& results
+) const {
+    auto sphereCenter = Coordinates(center);
+    float reach = radius + m_maxRadius;
+    std::array<float, 3> reachMinimum;
+    std::array<float, 3> reachMaximum;
+
+    for (size_t axis = 0; axis < 3; axis++) {
+        reachMinimum[axis] = sphereCenter[axis] - reach;
+        reachMaximum[axis] = sphereCenter[axis] + reach;
+    }
+
+    forEachCell(cellOf(reachMinimum), cellOf(reachMaximum), [&](const std::vector<Entry>& cell) {
+        for (auto& entry : cell) {
+            if (Intersects(entry, sphereCenter, radius)) {
+                results.push_back(entry.id);
+            }
+        }
+    });
+}
+
+void SpatialHashGrid::nearest(
+    const Mind::Point3Df& point,
+    const size_t amount,
+    std::vector<id_t>& results
+) const {
+    if ((amount == 0) || (m_size == 0)) {
+        return;
+    }
+
+    auto position = Coordinates(point);
+    auto center = cellOf(position);
+
+    // The best candidates, as a heap whose top is the farthest one.
+    std::vector<Neighbour> candidates;
+    candidates.reserve(std::min(amount, m_size) + 1);
+    size_t amountVisited = 0;
+
+    auto visit = [&](const std::vector<Entry>& cell) {
+        amountVisited += cell.size();
+
+        for (auto& entry : cell) {
+            Neighbour candidate { Distance(entry.position, position), entry.id };
+
+            if (candidates.size() < amount) {
+                candidates.push_back(candidate);
+                std::push_heap(candidates.begin(), candidates.end());
+            }
+            else if (candidate < candidates.front()) {
+                std::pop_heap(candidates.begin(), candidates.end());
+                candidates.back() = candidate;
+                std::push_heap(candidates.begin(), candidates.end());
+            }
+        }
+    };
+
+    for (int32_t ring = 0;; ring++) {
+        // Once the rings cover more cells than the grid has, visiting all of
+        // them is cheaper.
+        double side = (2. * ring) + 1.;
+
+        if ((side * side * side) > static_cast<double>(m_cells.size())) {
+            candidates.clear();
+
+            for (auto& [key, cell] : m_cells) {
+                visit(cell);
+            }
+
+            break;
+        }
+
+        // Cells whose greatest offset from the center on an axis is the ring.
+        for (int32_t x = -ring; x <= ring; x++) {
+            for (int32_t y = -ring; y <= ring; y++) {
+                bool isOnBorder = (std::abs(x) == ring) || (std::abs(y) == ring);
+                int32_t step = (isOnBorder || (ring == 0)) ? 1 : (2 * ring);
+
+                for (int32_t z = -ring; z <= ring; z += step) {
+                    auto found = m_cells.find(KeyOf({ center[0] + x, center[1] + y, center[2] + z }));
+
+                    if (found != m_cells.end()) {
+                        visit(found -> second);
+                    }
+                }
+            }
+        }
+
+        if (amountVisited == m_size) {
+            break;
+        }
+
+        // The cells of the next rings are farther than the current one.
+        float reach = static_cast<float>(ring) * m_cellSize;
+
+        if ((candidates.size() == amount) && (candidates.front().distance <= (reach * reach))) {
+            break;
+        }
+    }
+
+    std::sort_heap(candidates.begin(), candidates.end());
+
+    for (auto& candidate : candidates) {
+        results.push_back(candidate.id);
+    }
+}
+
+std::array<int32_t, 3> SpatialHashGrid::cellOf(const std::array<float, 3>& position) const {
+    constexpr double Limit = static_cast<double>(1 << (CoordinateBits - 1));
+    std::array<int32_t, 3> cell;
+
+    for (size_t axis = 0; axis < 3; axis++) {
+        double coordinate = std::floor(static_cast<double>(position[axis]) / m_cellSize);
+        cell[axis] = static_cast<int32_t>(std::clamp(coordinate, -Limit, Limit - 1.));
+    }
+
+    return cell;
+}
+
+uint64_t SpatialHashGrid::KeyOf(const std::array<int32_t, 3>& cell) {
+    constexpr uint64_t Mask = (uint64_t(1) << CoordinateBits) - 1;
+    return ((static_cast<uint64_t>(cell[0]) & Mask) << (2 * CoordinateBits))
+        | ((static_cast<uint64_t>(cell[1]) & Mask) << CoordinateBits)
+        | (static_cast<uint64_t>(cell[2]) & Mask);
+}
+
+void SpatialHashGrid::append(std::vector<Entry>& cell, const uint64_t key, const Entry& entry) {
+    auto& location = m_locations[Entity(entry.id).index()];
+    location.key = key;
+    location.cell = &cell;
+    location.index = static_cast<uint32_t>(cell.size());
+    cell.push_back(entry);
+}
+
+void SpatialHashGrid::detach(Location& location) {
+    auto& cell = *location.cell;
+
+    if (location.index + 1 < cell.size()) {
+        cell[location.index] = cell.back();
+        m_locations[Entity(cell[location.index].id).index()].index = location.index;
+    }
+
+    cell.pop_back();
+
+    if (cell.empty()) {
+        m_cells.erase(location.key);
+    }
+
+    location.cell = nullptr;
+}
\ No newline at end of file
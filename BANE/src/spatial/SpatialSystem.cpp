@@ -0,0 +1,113 @@
+#include "harmful/bane/spatial/SpatialSystem.hpp"
+#include "harmful/bane/components/TypedComponentFactory.hpp"
+#include "harmful/bane/spatial/SpatialHashGrid.hpp"
+#include <stdexcept>
+
+using namespace Bane;
+
+class SpatialSystem::Processing final : public SystemProcessing {
+    public:
+        void onDelete(const Entity& entity) override {
+            static_cast<SpatialSystem*>(system()) -> m_index -> remove(entity.id());
+        }
+
+        void run(
+            const LinkedSystems&,
+            CommandBuffer&,
+            const size_t,
+            const size_t
+        ) override {
+            static_cast<SpatialSystem*>(system()) -> refresh();
+        }
+};
+
+SpatialSystem::SpatialSystem(const std::string& name)
+    : System(name),
+      m_index(std::make_unique<SpatialHashGrid>(DefaultCellSize)) {
+    // The index is updated in a single batch.
+    setMultithreadable(false);
+}
+
+void SpatialSystem::setIndex(std::unique_ptr<SpatialIndex> index) {
+    if (!index) {
+        throw std::runtime_error("");
+    }
+
+    m_index = std::move(index);
+    m_isIndexDirty = true;
+}
+
+void SpatialSystem::track(TransformSystem* transforms) {
+    m_transforms = transforms;
+    reads<Transform>();
+    m_isIndexDirty = true;
+}
+
+std::unique_ptr<ComponentFactory> SpatialSystem::createFactory() {
+    return std::make_unique<TypedComponentFactory<SpatialProxy>>();
+}
+
+std::unique_ptr<SystemProcessing> SpatialSystem::createProcessing() {
+    return std::make_unique<Processing>();
+}
+
+void SpatialSystem::followTransforms() {
+    auto& column = m_transforms -> components();
+    uint32_t lastRun = lastRunVersion();
+
+    for (size_t index = 0; index < column.size(); index++) {
+        if (((index % ComponentColumn::VersionChunkSize) == 0) && (column.chunkVersionAt(index) <= lastRun)) {
+            index += ComponentColumn::VersionChunkSize - 1;
+            continue;
+        }
+
+        if (column.changedVersionAt(index) <= lastRun) {
+            continue;
+        }
+
+        auto proxyIndex = factory() -> indexOf(Entity(column.entityAt(index)));
+
+        if (proxyIndex != SparseSet::InvalidIndex) {
+            factory() -> markChanged(proxyIndex);
+        }
+    }
+}
+
+void SpatialSystem::refresh() {
+    if (m_transforms) {
+        followTransforms();
+    }
+
+    auto& column = components();
+    auto data = proxies();
+    uint32_t lastRun = m_isIndexDirty ? 0 : lastRunVersion();
+    m_changes.clear();
+
+    for (size_t index = 0; index < column.size(); index++) {
+        if (((index % ComponentColumn::VersionChunkSize) == 0) && (column.chunkVersionAt(index) <= lastRun)) {
+            index += ComponentColumn::VersionChunkSize - 1;
+            continue;
+        }
+
+        if (column.changedVersionAt(index) <= lastRun) {
+            continue;
+        }
+
+        auto& proxy = data[index];
+
+        if (m_transforms) {
+            Entity entity(column.entityAt(index));
+            auto transformIndex = m_transforms -> factory() -> indexOf(entity);
+
+            if (transformIndex != SparseSet::InvalidIndex) {
+                auto& world = m_transforms -> components().as<Transform>()[transformIndex].world;
+                proxy.position = { world[0][3], world[1][3], world[2][3] };
+            }
+        }
+
+        m_changes.push_back({ column.entityAt(index), proxy.position, proxy.radius });
+    }
+
+    m_index -> update(m_changes);
+    m_isIndexDirty = false;
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "harmful/bane/systems/LinkedSystems.hpp"
+#include "harmful/bane/systems/System.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+using namespace Bane;
+
+void LinkedSystems::add(System* system) {
+    auto sameName = std::find_if(
+        m_systems.begin(),
+        m_systems.end(),
+        [system](const System* candidate) { return candidate -> name() == system -> name(); }
+    );
+
+    if (sameName != m_systems.end()) {
+        *sameName = system;
+    }
+    else {
+        m_systems.push_back(system);
+    }
+
+    indexTypes();
+}
+
+bool LinkedSystems::remove(const System* system) {
+    auto sameName = std::find_if(
+        m_systems.begin(),
+        m_systems.end(),
+        [system](const System* candidate) { return candidate -> name() == system -> name(); }
+    );
+
+    if (sameName == m_systems.end()) {
+        return false;
+    }
+
+    m_systems.erase(sameName);
+    indexTypes();
+    return true;
+}
+
+System* LinkedSystems::at(const std::string& name) const {
+    for (auto& system : m_systems) {
+        if (system -> name() == name) {
+            return system;
+        }
+    }
+
+    throw std::out_of_range(name);
+}
+
+bool LinkedSystems::contains(const System* system) const {
+    return std::find(m_systems.begin(), m_systems.end(), system) != m_systems.end();
+}
+
+void LinkedSystems::indexTypes() {
+    m_systemsByType.clear();
+
+    for (auto& system : m_systems) {
+        // A System not set up yet has no data type.
+        if (!system -> factory()) {
+            continue;
+        }
+
+        uint32_t typeId = system -> components().type().id;
+
+        if (typeId >= m_systemsByType.size()) {
+            m_systemsByType.resize(typeId + 1, nullptr);
+        }
+
+        if (!m_systemsByType[typeId]) {
+            m_systemsByType[typeId] = system;
+        }
+    }
+}
\ No newline at end of file
@@ -1,16 +1,24 @@
 #include "harmful/bane/systems/System.hpp"
+#include <algorithm>
 
 using namespace Bane;
 
 System::System(const std::string& name)
     : m_name(name) {}
 
+System::~System() noexcept {
+    for (auto task : m_tasks) {
+        task.destroy();
+    }
+}
+
 void System::setup() {
     m_components = createFactory();
     m_processing = createProcessing();
+    m_processing -> m_system = this;
 }
 
-Component* System::create(const Entity& entity) {
+Component System::create(const Entity& entity) {
     auto allowedQuantity = m_components -> allowedQuantity();
     auto componentCount = m_components -> countFor(entity);
 
@@ -20,23 +28,143 @@ Component* System::create(const Entity& entity) {
         }
     }
 
-    return m_components -> createComponentFor(entity);
+    auto component = m_components -> createComponentFor(entity);
+
+    if (m_registry) {
+        m_registry -> set(entity, m_registryBit);
+    }
+
+    return component;
+}
+
+size_t System::createMany(std::span<const Entity> entities) {
+    auto amountCreated = m_components -> createComponentsFor(entities);
+
+    if (m_registry) {
+        for (auto& entity : entities) {
+            m_registry -> set(entity, m_registryBit);
+        }
+    }
+
+    return amountCreated;
 }
 
 void System::destroy(const Entity& entity) {
     m_processing -> onDelete(entity);
     m_components -> destroyComponentsOf(entity);
+
+    if (m_registry) {
+        m_registry -> reset(entity, m_registryBit);
+    }
+}
+
+void System::clear() {
+    for (auto entity : m_components -> entities()) {
+        m_processing -> onDelete(Entity(entity));
+    }
+
+    m_components -> clear();
 }
 
 void System::link(System* system) {
-    auto systemName = system -> name();
-    m_linkedSystems[systemName] = system;
+    m_linkedSystems.add(system);
+    m_accessVersion++;
 }
 
 void System::unlink(System* system) {
-    auto systemName = system->name();
+    if (m_linkedSystems.remove(system)) {
+        m_accessVersion++;
+    }
+}
+
+void System::spawn(SystemTask task, CommandBuffer& commands) {
+    auto handle = task.release();
+    handle.promise().system = this;
+
+    {
+        std::lock_guard<std::mutex> lock(m_tasksMutex);
+        m_tasks.push_back(handle);
+    }
+
+    resume(handle, commands);
+}
+
+void System::schedule(SystemTask::Handle task) {
+    std::lock_guard<std::mutex> lock(m_tasksMutex);
+    m_readyTasks.push_back(task);
+}
+
+void System::takeReadyTasks(std::vector<SystemTask::Handle>& tasks) {
+    std::lock_guard<std::mutex> lock(m_tasksMutex);
+    tasks.insert(tasks.end(), m_readyTasks.begin(), m_readyTasks.end());
+    m_readyTasks.clear();
+}
+
+void System::resume(SystemTask::Handle task, CommandBuffer& commands) {
+    auto finish = [this](SystemTask::Handle finished) {
+        {
+            std::lock_guard<std::mutex> lock(m_tasksMutex);
+            m_tasks.erase(std::find(m_tasks.begin(), m_tasks.end(), finished));
+        }
+
+        finished.destroy();
+    };
+
+    task.promise().commands = &commands;
+
+    try {
+        task.resume();
+    }
+    catch (...) {
+        finish(task);
+        throw;
+    }
+
+    if (task.done()) {
+        finish(task);
+    }
+}
+
+bool System::conflictsWith(const System& other) const {
+    return writesAccessedBy(other) || other.writesAccessedBy(*this);
+}
+
+void System::addAccess(
+    std::vector<std::type_index>& types,
+    const std::type_index& type
+) {
+    if (std::find(types.begin(), types.end(), type) == types.end()) {
+        types.push_back(type);
+        m_accessVersion++;
+    }
+}
+
+bool System::isWriting(const std::type_index& type) const {
+    if (type == ownType()) {
+        return true;
+    }
+
+    return std::find(m_writeTypes.begin(), m_writeTypes.end(), type) != m_writeTypes.end();
+}
+
+bool System::writesAccessedBy(const System& other) const {
+    if (other.isAccessing(ownType())) {
+        return true;
+    }
 
-    if (m_linkedSystems.contains(systemName)) {
-        m_linkedSystems.erase(systemName);
+    for (auto& type : m_writeTypes) {
+        if (other.isAccessing(type)) {
+            return true;
+        }
     }
+
+    return false;
+}
+
+bool System::isAccessing(const std::type_index& type) const {
+    if (isWriting(type)) {
+        return true;
+    }
+
+    return std::find(m_readTypes.begin(), m_readTypes.end(), type) != m_readTypes.end();
 }
\ No newline at end of file
@@ -0,0 +1,430 @@
+#include "harmful/bane/transforms/TransformSystem.hpp"
+#include "harmful/bane/components/TypedComponentFactory.hpp"
+#include "harmful/bane/jobs/WorkerPool.hpp"
+#include <harmful/mind/simd/SIMDVector.hpp>
+#include <algorithm>
+#include <stdexcept>
+
+using namespace Bane;
+using Mind::SIMD::Vector4f;
+
+class TransformSystem::Processing final : public SystemProcessing {
+    public:
+        void onDelete(const Entity&) override {
+            static_cast<TransformSystem*>(system()) -> m_isHierarchyDirty = true;
+        }
+
+        void run(
+            const LinkedSystems&,
+            CommandBuffer&,
+            const size_t,
+            const size_t
+        ) override {
+            static_cast<TransformSystem*>(system()) -> propagate();
+        }
+};
+
+TransformSystem::TransformSystem(const std::string& name)
+    : System(name) {
+    // The levels are spread over the threads by the System itself.
+    setMultithreadable(false);
+}
+
+void TransformSystem::setParent(const Entity& child, const Entity& parent) {
+    size_t childIndex = indexOf(child);
+    id_t parentId = Entity::InvalidID;
+
+    if (parent.isValid()) {
+        indexOf(parent);
+        auto data = transforms();
+
+        // The child must not become its own ancestor.
+        for (id_t ancestor = parent.id(); ancestor != Entity::InvalidID;) {
+            if (ancestor == child.id()) {
+                throw std::runtime_error("");
+            }
+
+            auto ancestorIndex = factory() -> indexOf(Entity(ancestor));
+            ancestor = (ancestorIndex == SparseSet::InvalidIndex)
+                ? Entity::InvalidID
+                : data[ancestorIndex].parent;
+        }
+
+        parentId = parent.id();
+    }
+
+    factory() -> markChanged(childIndex);
+    transforms()[childIndex].parent = parentId;
+    m_isHierarchyDirty = true;
+}
+
+void TransformSystem::setLocal(
+    const Entity& entity,
+    const Mind::Vector3f& translation,
+    const Mind::Quaternion& rotation,
+    const Mind::Vector3f& scale
+) {
+    size_t index = indexOf(entity);
+    factory() -> markChanged(index);
+
+    auto& transform = transforms()[index];
+    transform.translation = { translation[0], translation[1], translation[2] };
+    transform.scale = { scale[0], scale[1], scale[2] };
+    transform.rotation = {
+        rotation[Mind::Quaternion::X],
+        rotation[Mind::Quaternion::Y],
+        rotation[Mind::Quaternion::Z],
+        rotation[Mind::Quaternion::W]
+    };
+}
+
+Mind::Matrix4x4f TransformSystem::worldMatrix(const Entity& entity) const {
+    auto& transform = transforms()[indexOf(entity)];
+    Mind::Matrix4x4f matrix;
+
+    for (int row = 0; row < 4; row++) {
+        matrix[row].set(transform.world[row]);
+    }
+
+    return matrix;
+}
+
+std::unique_ptr<ComponentFactory> TransformSystem::createFactory() {
+    return std::make_unique<TypedComponentFactory<Transform>>();
+}
+
+std::unique_ptr<SystemProcessing> TransformSystem::createProcessing() {
+    return std::make_unique<Processing>();
+}
+
+size_t TransformSystem::indexOf(const Entity& entity) const {
+    auto index = factory() -> indexOf(entity);
+
+    if (index == SparseSet::InvalidIndex) {
+        throw std::runtime_error("");
+    }
+
+    return index;
+}
+
+void TransformSystem::propagate() {
+    if (isHierarchyChanged()) {
+        sortHierarchy();
+    }
+
+    m_recomputed.resize(componentsCount());
+    auto worker = ThreadJob::Current();
+    auto pool = worker ? &(worker -> pool()) : nullptr;
+    bool isParallel = pool && (pool -> size() > 1);
+
+    for (size_t level = 0; (level + 1) < m_levels.size(); level++) {
+        const size_t levelStart = m_levels[level];
+        const size_t levelEnd = m_levels[level + 1];
+        const size_t levelSize = levelEnd - levelStart;
+
+        if (!isParallel || (levelSize < (2 * MinimalTaskSize))) {
+            propagateRange(levelStart, levelEnd);
+            continue;
+        }
+
+        // The current thread processes the first range and helps with the
+        // others while waiting, as it belongs to the pool.
+        const size_t amountTasks = std::min(pool -> size(), levelSize / MinimalTaskSize);
+        const size_t taskSize = (levelSize + amountTasks - 1) / amountTasks;
+        TaskGroup group;
+        m_tasks.clear();
+
+        for (size_t taskStart = levelStart + taskSize; taskStart < levelEnd; taskStart += taskSize) {
+            ThreadTask task;
+            task.function = &TransformSystem::PropagateTask;
+            task.context = this;
+            task.fromIndex = taskStart;
+            task.toIndex = std::min(taskStart + taskSize, levelEnd);
+            task.group = &group;
+            m_tasks.push_back(task);
+        }
+
+        group.add(m_tasks.size());
+        pool -> submit(m_tasks);
+        propagateRange(levelStart, levelStart + taskSize);
+        pool -> wait(group);
+    }
+}
+
+bool TransformSystem::isHierarchyChanged() const {
+    const size_t count = componentsCount();
+
+    // The new Transforms are appended: the last one is new if any, unless
+    // Transforms have also been destroyed, which is flagged by onDelete().
+    return m_isHierarchyDirty
+        || (count != m_amountSorted)
+        || ((count > 0) && (components().addedVersionAt(count - 1) >= m_sortVersion));
+}
+
+void TransformSystem::sortHierarchy() {
+    const size_t count = componentsCount();
+    auto depths = computeDepths();
+
+    // Children of each Transform, packed by parent.
+    std::vector<uint32_t> firstChildren(count + 1, 0);
+    std::vector<uint32_t> children(count);
+
+    for (size_t index = 0; index < count; index++) {
+        if (m_parentIndices[index] != NoParent) {
+            firstChildren[m_parentIndices[index] + 1]++;
+        }
+    }
+
+    for (size_t index = 0; index < count; index++) {
+        firstChildren[index + 1] += firstChildren[index];
+    }
+
+    std::vector<uint32_t> filledChildren(firstChildren.begin(), firstChildren.end() - 1);
+
+    for (uint32_t index = 0; index < count; index++) {
+        if (m_parentIndices[index] != NoParent) {
+            children[filledChildren[m_parentIndices[index]]++] = index;
+        }
+    }
+
+    // Breadth-first order: the roots, then the children of each Transform of
+    // the order, so that the depth never decreases.
+    std::vector<uint32_t> order;
+    order.reserve(count);
+
+    for (uint32_t index = 0; index < count; index++) {
+        if (m_parentIndices[index] == NoParent) {
+            order.push_back(index);
+        }
+    }
+
+    for (size_t orderIndex = 0; orderIndex < order.size(); orderIndex++) {
+        auto parent = order[orderIndex];
+
+        for (auto child = firstChildren[parent]; child < firstChildren[parent + 1]; child++) {
+            order.push_back(children[child]);
+        }
+    }
+
+    std::vector<uint32_t> newIndices(count);
+    std::vector<uint32_t> parentIndices(count);
+    m_levels.clear();
+
+    for (uint32_t index = 0; index < count; index++) {
+        newIndices[order[index]] = index;
+    }
+
+    for (uint32_t index = 0; index < count; index++) {
+        auto parent = m_parentIndices[order[index]];
+        parentIndices[index] = (parent == NoParent) ? NoParent : newIndices[parent];
+
+        if ((index == 0) || (depths[order[index]] != depths[order[index - 1]])) {
+            m_levels.push_back(index);
+        }
+    }
+
+    m_levels.push_back(count);
+    factory() -> reorder(order);
+    m_parentIndices.swap(parentIndices);
+    m_isHierarchyDirty = false;
+    m_amountSorted = count;
+    m_sortVersion = components().version();
+}
+
+std::vector<uint32_t> TransformSystem::computeDepths() {
+    constexpr uint32_t Unknown = std::numeric_limits<uint32_t>::max();
+    constexpr uint32_t Visiting = Unknown - 1;
+
+    const size_t count = componentsCount();
+    auto data = transforms();
+    std::vector<uint32_t> depths(count, Unknown);
+    std::vector<uint32_t> path;
+    m_parentIndices.resize(count);
+
+    for (uint32_t index = 0; index < count; index++) {
+        auto& transform = data[index];
+        auto parentIndex = (transform.parent == Entity::InvalidID)
+            ? SparseSet::InvalidIndex
+            : factory() -> indexOf(Entity(transform.parent));
+
+        // The children of a destroyed parent become roots, with their world
+        // matrix computed again.
+        if ((transform.parent != Entity::InvalidID) && (parentIndex == SparseSet::InvalidIndex)) {
+            transform.parent = Entity::InvalidID;
+            factory() -> markChanged(index);
+        }
+
+        m_parentIndices[index] = (parentIndex == SparseSet::InvalidIndex)
+            ? NoParent
+            : static_cast<uint32_t>(parentIndex);
+    }
+
+    for (uint32_t index = 0; index < count; index++) {
+        // Walk up to an ancestor of known depth, then down again.
+        uint32_t current = index;
+
+        while ((current != NoParent) && (depths[current] == Unknown)) {
+            depths[current] = Visiting;
+            path.push_back(current);
+            current = m_parentIndices[current];
+        }
+
+        if ((current != NoParent) && (depths[current] == Visiting)) {
+            data[current].parent = Entity::InvalidID;
+            m_parentIndices[current] = NoParent;
+            factory() -> markChanged(current);
+        }
+
+        while (!path.empty()) {
+            auto node = path.back();
+            auto parent = m_parentIndices[node];
+            depths[node] = (parent == NoParent) ? 0 : (depths[parent] + 1);
+            path.pop_back();
+        }
+    }
+
+    return depths;
+}
+
+void TransformSystem::propagateRange(const size_t fromIndex, const size_t toIndex) {
+    auto& column = components();
+    const uint32_t lastRun = lastRunVersion();
+    uint32_t batch[BatchSize];
+    size_t batchSize = 0;
+
+    for (size_t index = fromIndex; index < toIndex; index++) {
+        // Clean chunks without a recomputed parent are skipped at once.
+        if (((index % ComponentColumn::VersionChunkSize) == 0)
+            && ((index + ComponentColumn::VersionChunkSize) <= toIndex)
+            && (column.chunkVersionAt(index) <= lastRun)) {
+            bool isParentRecomputed = false;
+
+            for (size_t offset = 0; offset < ComponentColumn::VersionChunkSize; offset++) {
+                auto parent = m_parentIndices[index + offset];
+                isParentRecomputed |= (parent != NoParent) && (m_recomputed[parent] != 0);
+            }
+
+            if (!isParentRecomputed) {
+                std::fill_n(m_recomputed.begin() + index, ComponentColumn::VersionChunkSize, 0);
+                index += ComponentColumn::VersionChunkSize - 1;
+                continue;
+            }
+        }
+
+        auto parent = m_parentIndices[index];
+        bool isDirty = (column.changedVersionAt(index) > lastRun)
+            || ((parent != NoParent) && (m_recomputed[parent] != 0));
+        m_recomputed[index] = isDirty ? 1 : 0;
+
+        if (!isDirty) {
+            continue;
+        }
+
+        batch[batchSize++] = static_cast<uint32_t>(index);
+
+        if (batchSize == BatchSize) {
+            computeBatch(batch);
+            batchSize = 0;
+        }
+    }
+
+    if (batchSize > 0) {
+        // The last Transform is computed several times to fill the batch.
+        std::fill(batch + batchSize, batch + BatchSize, batch[batchSize - 1]);
+        computeBatch(batch);
+    }
+}
+
+void TransformSystem::computeBatch(const uint32_t* indices) {
+    auto data = transforms();
+    auto& first = data[indices[0]];
+    auto& second = data[indices[1]];
+    auto& third = data[indices[2]];
+    auto& fourth = data[indices[3]];
+
+    // Transpose the local transforms: each vector holds a coordinate of the
+    // four Transforms.
+    Vector4f qx, qy, qz, qw;
+    qx.set(first.rotation);
+    qy.set(second.rotation);
+    qz.set(third.rotation);
+    qw.set(fourth.rotation);
+    Vector4f::transposeMatrix(qx, qy, qz, qw);
+
+    auto load = [](const std::array<float, 3>& values) {
+        return Vector4f(values[0], values[1], values[2], 0.f);
+    };
+
+    Vector4f tx = load(first.translation);
+    Vector4f ty = load(second.translation);
+    Vector4f tz = load(third.translation);
+    Vector4f tw = load(fourth.translation);
+    Vector4f::transposeMatrix(tx, ty, tz, tw);
+
+    Vector4f sx = load(first.scale);
+    Vector4f sy = load(second.scale);
+    Vector4f sz = load(third.scale);
+    Vector4f sw = load(fourth.scale);
+    Vector4f::transposeMatrix(sx, sy, sz, sw);
+
+    // Rotation matrix of the quaternions, with the scale on the columns.
+    const Vector4f one(1.f);
+    Vector4f x2 = qx + qx;
+    Vector4f y2 = qy + qy;
+    Vector4f z2 = qz + qz;
+    Vector4f xx = qx * x2, yy = qy * y2, zz = qz * z2;
+    Vector4f xy = qx * y2, xz = qx * z2, yz = qy * z2;
+    Vector4f wx = qw * x2, wy = qw * y2, wz = qw * z2;
+
+    // Rows of the local matrices, transposed back to one vector per
+    // Transform and row.
+    Vector4f rows[3][BatchSize] = {
+        { (one - (yy + zz)) * sx, (xy - wz) * sy, (xz + wy) * sz, tx },
+        { (xy + wz) * sx, (one - (xx + zz)) * sy, (yz - wx) * sz, ty },
+        { (xz - wy) * sx, (yz + wx) * sy, (one - (xx + yy)) * sz, tz }
+    };
+
+    for (auto& row : rows) {
+        Vector4f::transposeMatrix(row[0], row[1], row[2], row[3]);
+    }
+
+    const Vector4f lastRow(0.f, 0.f, 0.f, 1.f);
+
+    for (size_t lane = 0; lane < BatchSize; lane++) {
+        auto& transform = data[indices[lane]];
+        auto parent = m_parentIndices[indices[lane]];
+        Vector4f world[4];
+
+        if (parent == NoParent) {
+            world[0] = rows[0][lane];
+            world[1] = rows[1][lane];
+            world[2] = rows[2][lane];
+            world[3] = lastRow;
+        }
+        else {
+            // Each row of the product combines the rows of the local matrix.
+            auto& parentWorld = data[parent].world;
+
+            for (size_t row = 0; row < 4; row++) {
+                auto& parentRow = parentWorld[row];
+                Vector4f product = Vector4f::mul_add(Vector4f(parentRow[0]), rows[0][lane], lastRow * Vector4f(parentRow[3]));
+                product = Vector4f::mul_add(Vector4f(parentRow[1]), rows[1][lane], product);
+                world[row] = Vector4f::mul_add(Vector4f(parentRow[2]), rows[2][lane], product);
+            }
+        }
+
+        for (size_t row = 0; row < 4; row++) {
+            world[row].get(transform.world[row]);
+        }
+    }
+
+    // The consumers of the world matrices see them as changed.
+    for (size_t lane = 0; lane < BatchSize; lane++) {
+        factory() -> markChanged(indices[lane]);
+    }
+}
+
+void TransformSystem::PropagateTask(ThreadJob&, const ThreadTask& task) {
+    auto system = static_cast<TransformSystem*>(task.context);
+    system -> propagateRange(task.fromIndex, task.toIndex);
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include "harmful/bane/world/CommandBuffer.hpp"
+#include <algorithm>
+
+using namespace Bane;
+
+Entity CommandBuffer::create() {
+    auto entity = newEntity();
+    m_commands.push_back({ Type::CreateEntity, entity, nullptr, 0, 0 });
+    return entity;
+}
+
+Entity CommandBuffer::instantiate(const Prefab& prefab) {
+    auto entity = newEntity();
+    m_commands.push_back({ Type::Instantiate, entity, nullptr, 0, 0, &prefab });
+    return entity;
+}
+
+void CommandBuffer::instantiate(const Prefab& prefab, std::span<Entity> entities) {
+    if (m_stream == NoStream) {
+        m_entities -> create(entities);
+    }
+    else {
+        for (auto& entity : entities) {
+            entity = m_entities -> reserve(m_stream);
+        }
+    }
+
+    m_commands.reserve(m_commands.size() + entities.size());
+
+    for (auto& entity : entities) {
+        m_commands.push_back({ Type::Instantiate, entity, nullptr, 0, 0, &prefab });
+    }
+}
+
+void CommandBuffer::append(const CommandBuffer& other) {
+    auto payloadOffset = static_cast<uint32_t>(m_payloads.size());
+    m_payloads.insert(m_payloads.end(), other.m_payloads.begin(), other.m_payloads.end());
+
+    for (auto command : other.m_commands) {
+        command.payloadOffset += payloadOffset;
+        m_commands.push_back(command);
+    }
+
+    for (auto event : other.m_events) {
+        event.payloadOffset += payloadOffset;
+        m_events.push_back(event);
+    }
+}
+
+void CommandBuffer::sort() {
+    std::stable_sort(
+        m_commands.begin(),
+        m_commands.end(),
+        [](const Command& first, const Command& second) {
+            if (first.type != second.type) {
+                return first.type < second.type;
+            }
+
+            return first.entity.index() < second.entity.index();
+        }
+    );
+}
+
+Entity CommandBuffer::newEntity() {
+    return (m_stream == NoStream) ? m_entities -> create() : m_entities -> reserve(m_stream);
+}
\ No newline at end of file
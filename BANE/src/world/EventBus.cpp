@@ -0,0 +1,56 @@
+#include "harmful/bane/world/EventBus.hpp"
+#include "harmful/bane/world/CommandBuffer.hpp"
+#include <algorithm>
+
+using namespace Bane;
+
+void EventBus::publish(const CommandBuffer& commands, const uint32_t version) {
+    for (auto& event : commands.events()) {
+        if (event.type >= m_queues.size()) {
+            m_queues.resize(event.type + 1);
+        }
+
+        auto& queue = m_queues[event.type];
+        queue.eventSize = event.payloadSize;
+
+        if (queue.batches.empty() || (queue.batches.back().version != version)) {
+            queue.batches.push_back({ version, queue.events.size() / queue.eventSize });
+        }
+
+        auto payload = commands.payloadOf(event);
+        queue.events.insert(queue.events.end(), payload, payload + event.payloadSize);
+    }
+}
+
+void EventBus::prune(const uint32_t version) {
+    for (auto& queue : m_queues) {
+        auto firstKept = std::find_if(
+            queue.batches.begin(),
+            queue.batches.end(),
+            [version](const Batch& batch) { return batch.version > version; }
+        );
+
+        if (firstKept == queue.batches.begin()) {
+            continue;
+        }
+
+        size_t removedEvents = (firstKept == queue.batches.end())
+            ? (queue.events.size() / queue.eventSize)
+            : firstKept -> firstEvent;
+
+        // The capacity is kept for the next events.
+        queue.events.erase(queue.events.begin(), queue.events.begin() + (removedEvents * queue.eventSize));
+        queue.batches.erase(queue.batches.begin(), firstKept);
+
+        for (auto& batch : queue.batches) {
+            batch.firstEvent -= removedEvents;
+        }
+    }
+}
+
+void EventBus::clear() {
+    for (auto& queue : m_queues) {
+        queue.events.clear();
+        queue.batches.clear();
+    }
+}
\ No newline at end of file
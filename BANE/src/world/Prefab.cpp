@@ -0,0 +1,37 @@
+#include "harmful/bane/world/Prefab.hpp"
+#include <stdexcept>
+#include "harmful/bane/systems/System.hpp"
+
+using namespace Bane;
+
+Prefab::Prefab(const Prototype& prototype) {
+    for (auto& part : prototype.parts()) {
+        auto system = part.system;
+
+        if (!system || !system -> factory() || !system -> m_registry) {
+            throw std::runtime_error("");
+        }
+
+        if (m_registry && (m_registry != system -> m_registry)) {
+            throw std::runtime_error("");
+        }
+
+        auto& type = system -> components().type();
+        bool hasPayload = part.payloadSize > 0;
+
+        if (hasPayload && ((part.payloadSize != type.size) || !type.trivial)) {
+            throw std::runtime_error("");
+        }
+
+        m_registry = system -> m_registry;
+        m_signature.set(system -> m_registryBit);
+
+        auto offset = static_cast<uint32_t>(m_payloads.size());
+        m_parts.push_back({ system, offset, part.payloadSize });
+
+        if (hasPayload) {
+            auto payload = prototype.payloadOf(part);
+            m_payloads.insert(m_payloads.end(), payload, payload + part.payloadSize);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,359 @@
+#include "harmful/bane/world/Snapshot.hpp"
+#include "harmful/bane/world/World.hpp"
+#include <harmful/spite/files/MappedFile.hpp>
+#include <harmful/spite/writers/CPUEndiannessBinaryFileWriter.hpp>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace Bane;
+
+namespace {
+    /// <summary>
+    /// First bytes of a snapshot file.
+    /// </summary>
+    constexpr std::array<char, 4> Magic { 'B', 'A', 'N', 'E' };
+
+    /// <summary>
+    /// Write a blob, preceded by the padding aligning it on
+    /// Snapshot::BlobAlignment bytes.
+    /// </summary>
+    void writeBlob(
+        std::fstream& stream,
+        Spite::BinaryFileWriter& writer,
+        const void* blob,
+        const size_t size
+    ) {
+        static const std::array<char, Snapshot::BlobAlignment> Padding {};
+        auto position = static_cast<size_t>(stream.tellp());
+        size_t misalignment = position % Snapshot::BlobAlignment;
+
+        if (misalignment > 0) {
+            writer.writeBytes(Padding.data(), Snapshot::BlobAlignment - misalignment);
+        }
+
+        if (size > 0) {
+            writer.writeBytes(static_cast<const char*>(blob), size);
+        }
+    }
+
+    /// <summary>
+    /// Bounds-checked reading position in a mapped snapshot file.
+    /// </summary>
+    class Cursor final {
+        private:
+            const std::byte* m_data;
+            size_t m_size;
+            size_t m_offset = 0;
+
+        public:
+            Cursor(const std::byte* data, const size_t size)
+                : m_data(data), m_size(size) {}
+
+            template <typename T>
+            T read() {
+                T value;
+                std::memcpy(&value, take(sizeof(T)), sizeof(T));
+                return value;
+            }
+
+            std::string readString(const size_t length) {
+                auto text = reinterpret_cast<const char*>(take(length));
+                return std::string(text, length);
+            }
+
+            template <typename T>
+            std::span<const T> readBlob(const size_t amount) {
+                size_t misalignment = m_offset % Snapshot::BlobAlignment;
+
+                if (misalignment > 0) {
+                    take(Snapshot::BlobAlignment - misalignment);
+                }
+
+                if (amount > (m_size / sizeof(T))) {
+                    throw std::runtime_error("");
+                }
+
+                // The mapping starts on a page boundary, so the blob is
+                // aligned for T.
+                auto first = reinterpret_cast<const T*>(take(amount * sizeof(T)));
+                return std::span<const T>(first, amount);
+            }
+
+            const std::byte* readBytes(const size_t amount, const size_t size) {
+                size_t misalignment = m_offset % Snapshot::BlobAlignment;
+
+                if (misalignment > 0) {
+                    take(Snapshot::BlobAlignment - misalignment);
+                }
+
+                if ((size == 0) || (amount > (m_size / size))) {
+                    throw std::runtime_error("");
+                }
+
+                return take(amount * size);
+            }
+
+        private:
+            const std::byte* take(const size_t size) {
+                if (size > (m_size - m_offset)) {
+                    throw std::runtime_error("");
+                }
+
+                const std::byte* position = m_data + m_offset;
+                m_offset += size;
+                return position;
+            }
+    };
+
+    /// <summary>
+    /// Components of a System read from a snapshot file.
+    /// </summary>
+    struct SystemSection {
+        System* system;
+        size_t bit;
+        std::span<const id_t> entities;
+        const std::byte* data;
+    };
+
+    /// <summary>
+    /// Find the System matching a saved one, whose Components have not been
+    /// read yet.
+    /// </summary>
+    SystemSection findMatching(
+        std::span<System* const> systems,
+        const std::vector<SystemSection>& sections,
+        const std::string& name,
+        const size_t dataSize
+    ) {
+        auto system = std::find_if(
+            systems.begin(),
+            systems.end(),
+            [&name](System* candidate) { return candidate -> name() == name; }
+        );
+
+        auto isAlreadyRead = [&system](const SystemSection& section) {
+            return section.system == *system;
+        };
+
+        bool isMatching = (system != systems.end())
+            && std::none_of(sections.begin(), sections.end(), isAlreadyRead)
+            && (*system) -> factory()
+            && (*system) -> components().type().trivial
+            && ((*system) -> components().type().size == dataSize);
+
+        if (!isMatching) {
+            throw std::runtime_error("");
+        }
+
+        SystemSection section;
+        section.system = *system;
+        section.bit = static_cast<size_t>(system - systems.begin());
+        return section;
+    }
+
+    /// <summary>
+    /// Convert packed Entity IDs to Entities.
+    /// </summary>
+    std::vector<Entity> toEntities(std::span<const id_t> ids) {
+        std::vector<Entity> entities;
+        entities.reserve(ids.size());
+
+        for (auto id : ids) {
+            entities.emplace_back(id);
+        }
+
+        return entities;
+    }
+}
+
+void Snapshot::Save(const World& world, const std::filesystem::path& path) {
+    std::vector<System*> systems;
+
+    for (auto& system : world.m_systemOrder) {
+        if (system -> factory()) {
+            if (!system -> components().type().trivial) {
+                throw std::runtime_error("");
+            }
+
+            systems.push_back(system);
+        }
+    }
+
+    std::fstream stream(path, std::ios::out | std::ios::binary | std::ios::trunc);
+
+    if (!stream.is_open()) {
+        throw std::ios_base::failure(path.string());
+    }
+
+    std::vector<uint32_t> states;
+    std::vector<uint32_t> freeIndices;
+    world.m_entities.snapshot(states, freeIndices);
+    auto living = world.m_registry.entities();
+
+    Spite::CPUEndiannessBinaryFileWriter writer;
+    writer.setFileStream(&stream);
+    writer.writeBytes(Magic.data(), Magic.size());
+    writer.writeInt32(FormatVersion);
+    writer.writeInt32(static_cast<int32_t>(world.version()));
+    writer.writeInt64(static_cast<int64_t>(states.size()));
+    writer.writeInt64(static_cast<int64_t>(freeIndices.size()));
+    writer.writeInt64(static_cast<int64_t>(living.size()));
+    writer.writeInt64(static_cast<int64_t>(systems.size()));
+
+    writeBlob(stream, writer, states.data(), states.size() * sizeof(uint32_t));
+    writeBlob(stream, writer, freeIndices.data(), freeIndices.size() * sizeof(uint32_t));
+    writeBlob(stream, writer, living.data(), living.size() * sizeof(id_t));
+
+    for (auto& system : systems) {
+        auto& components = system -> components();
+        writer.writeInt32(static_cast<int32_t>(system -> name().size()));
+        writer.writeString(system -> name());
+        writer.writeInt64(static_cast<int64_t>(components.type().size));
+        writer.writeInt64(static_cast<int64_t>(components.size()));
+
+        auto entities = components.entities();
+        writeBlob(stream, writer, entities.data(), entities.size() * sizeof(id_t));
+
+        if (components.size() > 0) {
+            writeBlob(stream, writer, components.dataAt(0), components.size() * components.type().size);
+        }
+    }
+
+    stream.flush();
+
+    if (!stream.good()) {
+        throw std::ios_base::failure(path.string());
+    }
+}
+
+void Snapshot::Load(World& world, const std::filesystem::path& path) {
+    Spite::MappedFile file(path);
+    Cursor cursor(file.data(), file.size());
+
+    // Read and check the whole file before touching the World.
+    auto magic = cursor.readString(Magic.size());
+
+    if (!std::equal(magic.begin(), magic.end(), Magic.begin())) {
+        throw std::runtime_error("");
+    }
+
+    if (cursor.read<int32_t>() != FormatVersion) {
+        throw std::runtime_error("");
+    }
+
+    auto version = static_cast<uint32_t>(cursor.read<int32_t>());
+    auto amountIndices = static_cast<size_t>(cursor.read<int64_t>());
+    auto amountFreeIndices = static_cast<size_t>(cursor.read<int64_t>());
+    auto amountLiving = static_cast<size_t>(cursor.read<int64_t>());
+    auto amountSystems = static_cast<size_t>(cursor.read<int64_t>());
+
+    auto states = cursor.readBlob<uint32_t>(amountIndices);
+    auto freeIndices = cursor.readBlob<uint32_t>(amountFreeIndices);
+    auto living = cursor.readBlob<id_t>(amountLiving);
+    std::vector<SystemSection> sections;
+
+    EntityFactory::Validate(states, freeIndices);
+
+    // The living Entities must be alive in the states, and each one is
+    // registered once.
+    std::vector<bool> isLiving(states.size(), false);
+
+    for (auto id : living) {
+        Entity entity(id);
+
+        if (!EntityFactory::IsAlive(states, entity) || isLiving[entity.index()]) {
+            throw std::runtime_error("");
+        }
+
+        isLiving[entity.index()] = true;
+    }
+
+    for (size_t systemIndex = 0; systemIndex < amountSystems; systemIndex++) {
+        auto name = cursor.readString(static_cast<size_t>(cursor.read<int32_t>()));
+        auto dataSize = static_cast<size_t>(cursor.read<int64_t>());
+        auto amountComponents = static_cast<size_t>(cursor.read<int64_t>());
+
+        auto section = findMatching(world.m_systemOrder, sections, name, dataSize);
+        section.entities = cursor.readBlob<id_t>(amountComponents);
+        section.data = (amountComponents > 0)
+            ? cursor.readBytes(amountComponents, dataSize)
+            : nullptr;
+
+        // The Components belong to living Entities, checked above.
+        for (auto id : section.entities) {
+            Entity entity(id);
+
+            if (!EntityFactory::IsAlive(states, entity) || !isLiving[entity.index()]) {
+                throw std::runtime_error("");
+            }
+        }
+
+        sections.push_back(section);
+    }
+
+    world.clear();
+    world.m_entities.restore(states, freeIndices);
+    world.m_version.store(version, std::memory_order_relaxed);
+    world.bindVersion();
+    world.m_registry.insert(toEntities(living));
+
+    for (auto& section : sections) {
+        auto entities = toEntities(section.entities);
+        section.system -> factory() -> restoreComponents(entities, section.data);
+
+        for (auto& entity : entities) {
+            world.m_registry.set(entity, section.bit);
+        }
+    }
+}
+
+void Snapshot::Copy(const World& source, World& target) {
+    if (&source == &target) {
+        return;
+    }
+
+    std::vector<SystemSection> sections;
+
+    for (auto& system : source.m_systemOrder) {
+        if (!system -> factory()) {
+            continue;
+        }
+
+        auto& components = system -> components();
+
+        if (!components.type().trivial) {
+            throw std::runtime_error("");
+        }
+
+        auto section = findMatching(target.m_systemOrder, sections, system -> name(), components.type().size);
+        section.entities = components.entities();
+        section.data = (components.size() > 0)
+            ? reinterpret_cast<const std::byte*>(components.dataAt(0))
+            : nullptr;
+        sections.push_back(section);
+    }
+
+    std::vector<uint32_t> states;
+    std::vector<uint32_t> freeIndices;
+    source.m_entities.snapshot(states, freeIndices);
+    target.clear();
+    target.m_entities.restore(states, freeIndices);
+    target.m_version.store(source.version(), std::memory_order_relaxed);
+    target.bindVersion();
+    target.m_registry.insert(toEntities(source.m_registry.entities()));
+
+    for (auto& section : sections) {
+        auto entities = toEntities(section.entities);
+        section.system -> factory() -> restoreComponents(entities, section.data);
+
+        for (auto& entity : entities) {
+            target.m_registry.set(entity, section.bit);
+        }
+    }
+}
\ No newline at end of file
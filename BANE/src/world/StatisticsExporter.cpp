@@ -0,0 +1,147 @@
+#include "harmful/bane/world/StatisticsExporter.hpp"
+#include "harmful/bane/world/World.hpp"
+#include <cstdio>
+#include <string>
+
+using namespace Bane;
+
+namespace {
+    /// <summary>
+    /// Write a text as a CSV field, quoted if needed.
+    /// </summary>
+    void writeCSVField(std::ostream& stream, const std::string& text) {
+        if (text.find_first_of(",\"\n\r") == std::string::npos) {
+            stream << text;
+            return;
+        }
+
+        stream << '"';
+
+        for (char character : text) {
+            if (character == '"') {
+                stream << '"';
+            }
+
+            stream << character;
+        }
+
+        stream << '"';
+    }
+
+    /// <summary>
+    /// Write a text as a JSON string.
+    /// </summary>
+    void writeJSONString(std::ostream& stream, const std::string& text) {
+        stream << '"';
+
+        for (char character : text) {
+            switch (character) {
+                case '"':
+                    stream << "\\\"";
+                    break;
+
+                case '\\':
+                    stream << "\\\\";
+                    break;
+
+                case '\n':
+                    stream << "\\n";
+                    break;
+
+                case '\r':
+                    stream << "\\r";
+                    break;
+
+                case '\t':
+                    stream << "\\t";
+                    break;
+
+                default:
+                    if (static_cast<unsigned char>(character) < 0x20) {
+                        char escaped[8];
+                        std::snprintf(escaped, sizeof(escaped), "\\u%04x", character);
+                        stream << escaped;
+                    }
+                    else {
+                        stream << character;
+                    }
+
+                    break;
+            }
+        }
+
+        stream << '"';
+    }
+}
+
+void StatisticsExporter::WriteCSV(const World& world, std::ostream& stream) {
+    stream << "job,system,thread,busyTime,waitTime,amountComponents,amountChunks\n";
+
+    for (auto& job : world.m_jobOrder) {
+        auto& statistics = job -> statistics();
+        auto& threads = statistics.threads();
+
+        for (size_t threadIndex = 0; threadIndex < threads.size(); threadIndex++) {
+            auto& thread = threads[threadIndex];
+            writeCSVField(stream, job -> name());
+            stream << ",," << threadIndex
+                   << ',' << thread.busyTime
+                   << ',' << thread.waitTime
+                   << ',' << thread.amountComponents
+                   << ',' << thread.amountChunks << '\n';
+        }
+
+        for (auto& system : statistics.systems()) {
+            writeCSVField(stream, job -> name());
+            stream << ',';
+            writeCSVField(stream, system.system -> name());
+            stream << ',' << system.thread
+                   << ',' << system.busyTime
+                   << ','
+                   << ',' << system.amountComponents
+                   << ',' << system.amountChunks << '\n';
+        }
+    }
+}
+
+void StatisticsExporter::WriteJSON(const World& world, std::ostream& stream) {
+    stream << '[';
+
+    for (size_t jobIndex = 0; jobIndex < world.m_jobOrder.size(); jobIndex++) {
+        auto job = world.m_jobOrder[jobIndex];
+        auto& statistics = job -> statistics();
+        auto& threads = statistics.threads();
+        auto& systems = statistics.systems();
+
+        stream << ((jobIndex > 0) ? "," : "") << "{\"name\":";
+        writeJSONString(stream, job -> name());
+        stream << ",\"wallTime\":" << statistics.wallTime()
+               << ",\"amountExecutions\":" << statistics.amountExecutions()
+               << ",\"threads\":[";
+
+        for (size_t threadIndex = 0; threadIndex < threads.size(); threadIndex++) {
+            auto& thread = threads[threadIndex];
+            stream << ((threadIndex > 0) ? "," : "")
+                   << "{\"busyTime\":" << thread.busyTime
+                   << ",\"waitTime\":" << thread.waitTime
+                   << ",\"amountComponents\":" << thread.amountComponents
+                   << ",\"amountChunks\":" << thread.amountChunks << '}';
+        }
+
+        stream << "],\"systems\":[";
+
+        for (size_t systemIndex = 0; systemIndex < systems.size(); systemIndex++) {
+            auto& system = systems[systemIndex];
+            stream << ((systemIndex > 0) ? "," : "") << "{\"name\":";
+            writeJSONString(stream, system.system -> name());
+            stream << ",\"thread\":" << system.thread
+                   << ",\"busyTime\":" << system.busyTime
+                   << ",\"amountComponents\":" << system.amountComponents
+                   << ",\"amountChunks\":" << system.amountChunks << '}';
+        }
+
+        stream << "]}";
+    }
+
+    stream << "]\n";
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include "harmful/bane/world/SystemGraph.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+using namespace Bane;
+
+void SystemGraph::build(const std::vector<System*>& systems) {
+    m_systems = systems;
+    m_successors.assign(m_systems.size(), {});
+    m_stages.clear();
+
+    computeEdges();
+    computeStages();
+}
+
+std::vector<System*> SystemGraph::order() const {
+    std::vector<System*> ordered;
+
+    for (auto& stage : m_stages) {
+        ordered.insert(ordered.end(), stage.begin(), stage.end());
+    }
+
+    return ordered;
+}
+
+void SystemGraph::computeEdges() {
+    const size_t amountSystems = m_systems.size();
+
+    for (size_t first = 0; first < amountSystems; first++) {
+        for (size_t second = first + 1; second < amountSystems; second++) {
+            auto firstSystem = m_systems[first];
+            auto secondSystem = m_systems[second];
+            bool firstDependsOnSecond = firstSystem -> isLinkedTo(secondSystem);
+            bool secondDependsOnFirst = secondSystem -> isLinkedTo(firstSystem);
+
+            if (firstDependsOnSecond) {
+                m_successors[second].push_back(first);
+            }
+
+            if (secondDependsOnFirst || (!firstDependsOnSecond && firstSystem -> conflictsWith(*secondSystem))) {
+                m_successors[first].push_back(second);
+            }
+        }
+    }
+}
+
+void SystemGraph::computeStages() {
+    const size_t amountSystems = m_systems.size();
+    std::vector<size_t> amountPredecessors(amountSystems, 0);
+
+    for (auto& successors : m_successors) {
+        for (auto successor : successors) {
+            amountPredecessors[successor]++;
+        }
+    }
+
+    std::vector<size_t> currentStage;
+
+    for (size_t index = 0; index < amountSystems; index++) {
+        if (amountPredecessors[index] == 0) {
+            currentStage.push_back(index);
+        }
+    }
+
+    size_t amountStaged = 0;
+
+    while (!currentStage.empty()) {
+        std::vector<System*> stage;
+        std::vector<size_t> nextStage;
+
+        for (auto index : currentStage) {
+            stage.push_back(m_systems[index]);
+
+            for (auto successor : m_successors[index]) {
+                if (--amountPredecessors[successor] == 0) {
+                    nextStage.push_back(successor);
+                }
+            }
+        }
+
+        amountStaged += stage.size();
+        m_stages.push_back(std::move(stage));
+
+        // Keep the registration order inside each stage.
+        std::sort(nextStage.begin(), nextStage.end());
+        currentStage = std::move(nextStage);
+    }
+
+    if (amountStaged != amountSystems) {
+        throw std::runtime_error("");
+    }
+}
\ No newline at end of file
@@ -1,4 +1,8 @@
 #include "harmful/bane/world/World.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
 
 using namespace Bane;
 
@@ -7,23 +11,85 @@ World::~World() noexcept {
 }
 
 void World::clear() {
-    for (auto& entity : m_entityList) {
-        removeEntity(entity);
+    for (auto& system : m_systemOrder) {
+        if (system -> factory()) {
+            system -> clear();
+        }
+    }
+
+    for (auto entity : m_registry.entities()) {
+        m_entities.destroy(entity);
     }
 
-    m_entityList.clear();
+    m_registry.clear();
+    m_events.clear();
 }
 
 Entity World::createEntity() {
     auto newEntity = m_entities.create();
-    m_entityList.insert(newEntity);
+    m_registry.insert(newEntity);
     return newEntity;
 }
 
+std::vector<Entity> World::createEntities(
+    const size_t amount,
+    const Prototype& prototype
+) {
+    bindWorkers();
+    std::vector<Entity> entities(amount);
+    m_entities.create(entities);
+    m_registry.insert(entities);
+
+    for (auto& part : prototype.parts()) {
+        auto system = part.system;
+        size_t amountCreated = system -> createMany(entities);
+        bool hasPayload = part.payloadSize == system -> components().type().size;
+
+        if ((amountCreated > 0) && hasPayload) {
+            size_t toIndex = system -> componentsCount();
+            fillComponents(system, toIndex - amountCreated, toIndex, prototype.payloadOf(part));
+        }
+    }
+
+    return entities;
+}
+
+std::vector<Entity> World::instantiate(
+    const Prefab& prefab,
+    const size_t amount
+) {
+    if (!prefab.belongsTo(m_registry)) {
+        throw std::runtime_error("");
+    }
+
+    bindWorkers();
+    std::vector<Entity> entities(amount);
+    m_entities.create(entities);
+    instantiate(prefab, std::span<const Entity>(entities));
+    return entities;
+}
+
+void World::instantiate(const Prefab& prefab, std::span<const Entity> entities) {
+    m_registry.insert(entities, prefab.signature());
+
+    for (auto& part : prefab.parts()) {
+        auto factory = part.system -> factory();
+        auto payload = prefab.payloadOf(part);
+
+        if (payload) {
+            factory -> cloneComponentsFor(entities, payload);
+        }
+        else {
+            factory -> createComponentsFor(entities);
+        }
+    }
+}
+
 void World::addJob(
     const std::string& name,
     std::list<std::string>& systemNames,
-    const uint8_t threadCount
+    const uint8_t threadCount,
+    const ThreadPlacement& placement
 ) {
     if (m_jobs.contains(name)) {
         return;
@@ -37,39 +103,530 @@ void World::addJob(
         }
     }
 
-    m_jobs[name] = std::make_unique<Job>(name, systems, threadCount);
+    if (m_threads) {
+        m_jobs[name] = std::make_unique<Job>(name, systems, m_threads, m_entities);
+    }
+    else {
+        m_jobs[name] = std::make_unique<Job>(name, systems, threadCount, m_entities, placement);
+    }
+
+    m_jobs[name] -> setDeterministic(m_isDeterministic);
+    m_jobOrder.push_back(m_jobs[name].get());
+    m_jobPacing.push_back(JobPacing());
+    m_isScheduleDirty = true;
 }
 
 void World::destroy(const Entity& entity) {
-    removeEntity(entity);
-    m_entityList.erase(entity);
+    if (m_registry.contains(entity)) {
+        removeEntity(entity);
+    }
+}
+
+void World::apply(CommandBuffer& commands) {
+    if (!commands.events().empty()) {
+        m_version.fetch_add(1, std::memory_order_relaxed);
+        m_events.publish(commands, version());
+    }
+
+    pruneEvents();
+    commands.sort();
+    applyInstances(commands);
+
+    for (auto& command : commands.commands()) {
+        switch (command.type) {
+            case CommandBuffer::Type::CreateEntity:
+                m_registry.insert(command.entity);
+                break;
+
+            case CommandBuffer::Type::Instantiate:
+                // Already created by applyInstances().
+                break;
+
+            case CommandBuffer::Type::AddComponent: {
+                if (!m_entities.contains(command.entity)) {
+                    break;
+                }
+
+                auto component = command.system -> create(command.entity);
+                auto dataSize = command.system -> components().type().size;
+
+                if (component.isValid() && (command.payloadSize == dataSize)) {
+                    std::memcpy(component.data(), commands.payloadOf(command), dataSize);
+                }
+
+                break;
+            }
+
+            case CommandBuffer::Type::RemoveComponents:
+                if (m_entities.contains(command.entity)) {
+                    command.system -> destroy(command.entity);
+                }
+
+                break;
+
+            case CommandBuffer::Type::DestroyEntity:
+                if (m_entities.contains(command.entity)) {
+                    destroy(command.entity);
+                }
+
+                break;
+        }
+    }
+
+    commands.clear();
 }
 
 void World::run() {
-    for (auto const& [name, job] : m_jobs) {
-        job -> execute();
+    m_dueJobs.assign(m_jobOrder.size(), true);
+    runStages(m_dueJobs);
+}
+
+size_t World::tick() {
+    if (!m_clock.isStarted()) {
+        m_clock.start();
+        m_lastTickTime = 0;
+    }
+
+    auto now = m_clock.runningTime<std::chrono::nanoseconds>();
+    m_accumulator += std::chrono::nanoseconds(now - m_lastTickTime);
+    m_lastTickTime = now;
+
+    // Drop the time that cannot be caught up with.
+    m_accumulator = std::min(m_accumulator, m_timestep * static_cast<int64_t>(m_maxCatchUpSteps));
+    size_t amountSteps = 0;
+
+    while (m_accumulator >= m_timestep) {
+        step();
+        m_accumulator -= m_timestep;
+        amountSteps++;
+    }
+
+    m_interpolation = static_cast<double>(m_accumulator.count()) / static_cast<double>(m_timestep.count());
+    return amountSteps;
+}
+
+void World::runFor(const std::chrono::nanoseconds duration) {
+    Doom::Chrono chrono;
+    chrono.start();
+
+    while (true) {
+        tick();
+
+        auto elapsed = std::chrono::nanoseconds(chrono.runningTime<std::chrono::nanoseconds>());
+
+        if (elapsed >= duration) {
+            break;
+        }
+
+        // Wait for the next step to be due instead of spinning.
+        std::this_thread::sleep_for(std::min(m_timestep - m_accumulator, duration - elapsed));
+    }
+}
+
+void World::setTimestep(const std::chrono::nanoseconds timestep) {
+    if (timestep.count() <= 0) {
+        throw std::runtime_error("");
+    }
+
+    m_timestep = timestep;
+}
+
+void World::setTickRate(const std::string& jobName, const double hertz) {
+    auto job = std::find_if(
+        m_jobOrder.begin(),
+        m_jobOrder.end(),
+        [&jobName](const Job* candidate) { return candidate -> name() == jobName; }
+    );
+
+    if (job == m_jobOrder.end()) {
+        return;
+    }
+
+    auto& pacing = m_jobPacing[job - m_jobOrder.begin()];
+    pacing.period = (hertz > 0.)
+        ? std::chrono::nanoseconds(static_cast<int64_t>(1e9 / hertz))
+        : std::chrono::nanoseconds(0);
+    pacing.accumulated = std::chrono::nanoseconds(0);
+}
+
+std::chrono::nanoseconds World::tickPeriod(const std::string& jobName) const {
+    for (size_t jobIndex = 0; jobIndex < m_jobOrder.size(); jobIndex++) {
+        if (m_jobOrder[jobIndex] -> name() == jobName) {
+            return std::max(m_jobPacing[jobIndex].period, m_timestep);
+        }
+    }
+
+    return m_timestep;
+}
+
+void World::step() {
+    paceJobs();
+    runStages(m_dueJobs);
+    m_amountSteps++;
+}
+
+void World::paceJobs() {
+    m_dueJobs.resize(m_jobOrder.size());
 
-        // Clear the entities before running the next job.
-        auto& clearEntitiesList = job -> dropEntities();
+    for (size_t jobIndex = 0; jobIndex < m_jobOrder.size(); jobIndex++) {
+        auto& pacing = m_jobPacing[jobIndex];
+        pacing.accumulated += m_timestep;
+        m_dueJobs[jobIndex] = pacing.accumulated >= pacing.period;
 
-        for (auto& entity : clearEntitiesList) {
-            destroy(entity);
+        if (m_dueJobs[jobIndex]) {
+            // A Job runs at most once per step: it does not accumulate late
+            // runs.
+            pacing.accumulated = std::min(pacing.accumulated - pacing.period, pacing.period);
         }
     }
 }
 
+void World::runStages(const std::vector<bool>& dueJobs) {
+    updateSchedule();
+
+    for (size_t stageIndex = 0; stageIndex < m_stagesPerJob.size(); stageIndex++) {
+        submitStage(stageIndex, dueJobs);
+        finishStage(stageIndex, dueJobs);
+    }
+
+    finishStages(dueJobs);
+}
+
+void World::submitStage(const size_t stageIndex, const std::vector<bool>& dueJobs) {
+    auto& stage = m_stagesPerJob[stageIndex];
+    m_version.fetch_add(1, std::memory_order_relaxed);
+    uint64_t stageSeed = RandomStream::Mix(m_seed, version());
+
+    uint32_t amountStreams = 0;
+
+    for (size_t jobIndex = 0; jobIndex < m_jobOrder.size(); jobIndex++) {
+        if (dueJobs[jobIndex]) {
+            m_jobOrder[jobIndex] -> seed(RandomStream::Mix(stageSeed, jobIndex));
+            amountStreams += m_jobOrder[jobIndex] -> prepare(stage[jobIndex], amountStreams);
+        }
+    }
+
+    // The chunks of all the Jobs create their Entities from a same
+    // reservation, each from its own stream.
+    if (m_isDeterministic) {
+        m_entities.beginReservation(amountStreams);
+    }
+
+    for (size_t jobIndex = 0; jobIndex < m_jobOrder.size(); jobIndex++) {
+        if (dueJobs[jobIndex]) {
+            m_jobOrder[jobIndex] -> launch();
+        }
+    }
+}
+
+void World::finishStage(const size_t stageIndex, const std::vector<bool>& dueJobs) {
+    auto& stage = m_stagesPerJob[stageIndex];
+
+    for (size_t jobIndex = 0; jobIndex < m_jobOrder.size(); jobIndex++) {
+        if (dueJobs[jobIndex]) {
+            m_jobOrder[jobIndex] -> wait();
+
+            for (auto& system : stage[jobIndex]) {
+                system -> setLastRunVersion(version());
+            }
+        }
+    }
+
+    if (m_isDeterministic) {
+        m_entities.endReservation();
+    }
+
+    // Apply the structural changes before running the next stage.
+    for (auto& job : m_jobOrder) {
+        job -> collectCommands(m_commands);
+    }
+
+    apply(m_commands);
+}
+
+void World::finishStages(const std::vector<bool>& dueJobs) {
+    for (size_t jobIndex = 0; jobIndex < m_jobOrder.size(); jobIndex++) {
+        if (dueJobs[jobIndex]) {
+            m_jobOrder[jobIndex] -> endFrame();
+        }
+    }
+
+    // The changes made between two frames get a newer version than the last
+    // run of the Systems of the last stage.
+    m_version.fetch_add(1, std::memory_order_relaxed);
+}
+
+const JobStatistics* World::statistics(const std::string& jobName) const {
+    auto job = m_jobs.find(jobName);
+    return (job != m_jobs.end()) ? &(job -> second -> statistics()) : nullptr;
+}
+
+AsyncSignal* World::completion(const std::string& jobName) {
+    auto job = m_jobs.find(jobName);
+    return (job != m_jobs.end()) ? &(job -> second -> completion()) : nullptr;
+}
+
+void World::setDeterministic(const bool deterministic, const uint64_t seed) {
+    m_isDeterministic = deterministic;
+    m_seed = seed;
+
+    for (auto& job : m_jobOrder) {
+        job -> setDeterministic(deterministic);
+    }
+}
+
+const std::vector<std::vector<System*>>& World::stages() {
+    updateSchedule();
+    return m_schedule.stages();
+}
+
 void World::stop() {
-    for (auto const& [name, job] : m_jobs) {
+    for (auto& job : m_jobOrder) {
         job -> stop();
     }
 }
 
 void World::removeEntity(const Entity& entity) {
-    for (auto const& [name, system] : m_systems) {
-        if (m_entities.contains(entity)) {
-            system -> destroy(entity);
+    auto signature = m_registry.erase(entity);
+
+    for (size_t bit = 0; signature.any(); bit++) {
+        if (signature.test(bit)) {
+            m_systemOrder[bit] -> destroy(entity);
+            signature.reset(bit);
         }
     }
 
     m_entities.destroy(entity);
+}
+
+namespace {
+    /// <summary>
+    /// What a chunk of Components to fill needs.
+    /// </summary>
+    struct FillContext {
+        std::byte* data;
+        const std::byte* payload;
+        size_t size;
+    };
+
+    /// <summary>
+    /// Copy the initial data in a range of Components.
+    /// </summary>
+    void fill(const FillContext& context, const size_t fromIndex, const size_t toIndex) {
+        for (size_t index = fromIndex; index < toIndex; index++) {
+            std::memcpy(context.data + (index * context.size), context.payload, context.size);
+        }
+    }
+}
+
+void World::fillComponents(
+    System* system,
+    const size_t fromIndex,
+    const size_t toIndex,
+    const std::byte* payload
+) {
+    FillContext context {
+        reinterpret_cast<std::byte*>(system -> components().dataAt(0)),
+        payload,
+        system -> components().type().size
+    };
+
+    WorkerPool* pool = nullptr;
+
+    for (auto& job : m_jobOrder) {
+        if (job -> contains(system)) {
+            pool = &(job -> threads());
+            break;
+        }
+    }
+
+    size_t amount = toIndex - fromIndex;
+
+    if (!pool || (pool -> size() < 2) || (amount < 2 * MinimalFillSize)) {
+        fill(context, fromIndex, toIndex);
+        return;
+    }
+
+    size_t amountChunks = std::min(pool -> size(), amount / MinimalFillSize);
+    size_t chunkSize = (amount + amountChunks - 1) / amountChunks;
+    std::vector<ThreadTask> chunks;
+    TaskGroup group;
+    ThreadTask chunk;
+    chunk.function = &World::FillChunk;
+    chunk.context = &context;
+
+    for (size_t chunkStart = fromIndex; chunkStart < toIndex; chunkStart += chunkSize) {
+        chunk.fromIndex = chunkStart;
+        chunk.toIndex = std::min(chunkStart + chunkSize, toIndex);
+        chunk.group = &group;
+        chunks.push_back(chunk);
+    }
+
+    group.add(chunks.size());
+    pool -> submit(chunks);
+    group.wait();
+}
+
+void World::FillChunk(ThreadJob&, const ThreadTask& task) {
+    fill(*static_cast<const FillContext*>(task.context), task.fromIndex, task.toIndex);
+}
+
+ComponentFactory* World::factoryOf(const uint32_t typeId) {
+    if (typeId < m_systemsByType.size()) {
+        auto system = m_systemsByType[typeId];
+
+        // The System may have been set up again since the first lookup.
+        if (system && system -> factory() && (system -> factory() -> components().type().id == typeId)) {
+            return system -> factory();
+        }
+    }
+
+    for (auto& system : m_systemOrder) {
+        auto factory = system -> factory();
+
+        if (factory && (factory -> components().type().id == typeId)) {
+            if (typeId >= m_systemsByType.size()) {
+                m_systemsByType.resize(typeId + 1, nullptr);
+            }
+
+            m_systemsByType[typeId] = system;
+            return factory;
+        }
+    }
+
+    return nullptr;
+}
+
+void World::bindVersion() {
+    for (auto& system : m_systemOrder) {
+        if (system -> factory()) {
+            system -> factory() -> bindVersion(m_version);
+        }
+    }
+}
+
+void World::bindWorkers() {
+    for (auto& system : m_systemOrder) {
+        if (!system -> factory()) {
+            continue;
+        }
+
+        WorkerPool* workers = nullptr;
+
+        for (auto& job : m_jobOrder) {
+            bool isPlaced = job -> placement().policy() != ThreadPlacement::Policy::None;
+
+            if (isPlaced && job -> contains(system)) {
+                workers = &(job -> threads());
+                break;
+            }
+        }
+
+        system -> factory() -> bindWorkers(workers);
+    }
+}
+
+void World::pruneEvents() {
+    if (m_scheduledSystems.empty()) {
+        return;
+    }
+
+    uint32_t oldestRun = m_scheduledSystems.front() -> lastRunVersion();
+
+    for (auto& system : m_scheduledSystems) {
+        oldestRun = std::min(oldestRun, system -> lastRunVersion());
+    }
+
+    m_events.prune(oldestRun);
+}
+
+void World::applyInstances(const CommandBuffer& commands) {
+    // Instances of each Prefab, in the order of their first command.
+    std::vector<std::pair<const Prefab*, std::vector<Entity>>> instances;
+
+    for (auto& command : commands.commands()) {
+        if (command.type < CommandBuffer::Type::Instantiate) {
+            continue;
+        }
+
+        if (command.type > CommandBuffer::Type::Instantiate) {
+            break;
+        }
+
+        auto prefabInstances = std::find_if(
+            instances.begin(),
+            instances.end(),
+            [&command](const auto& candidate) { return candidate.first == command.prefab; }
+        );
+
+        if (prefabInstances == instances.end()) {
+            instances.emplace_back(command.prefab, std::vector<Entity>());
+            prefabInstances = instances.end() - 1;
+        }
+
+        prefabInstances -> second.push_back(command.entity);
+    }
+
+    for (auto& [prefab, entities] : instances) {
+        if (!prefab -> belongsTo(m_registry)) {
+            throw std::runtime_error("");
+        }
+    }
+
+    for (auto& [prefab, entities] : instances) {
+        instantiate(*prefab, std::span<const Entity>(entities));
+    }
+}
+
+void World::updateSchedule() {
+    auto currentAccessVersion = accessVersion();
+
+    if (!m_isScheduleDirty && (currentAccessVersion == m_scheduleAccessVersion)) {
+        return;
+    }
+
+    // Only the Systems run by a Job are scheduled.
+    m_scheduledSystems.clear();
+
+    for (auto& system : m_systemOrder) {
+        for (auto& job : m_jobOrder) {
+            if (job -> contains(system)) {
+                m_scheduledSystems.push_back(system);
+                break;
+            }
+        }
+    }
+
+    bindVersion();
+    bindWorkers();
+    m_schedule.build(m_scheduledSystems);
+    m_stagesPerJob.clear();
+
+    for (auto& stage : m_schedule.stages()) {
+        std::vector<std::vector<System*>> stagePerJob(m_jobOrder.size());
+
+        for (auto& system : stage) {
+            for (size_t jobIndex = 0; jobIndex < m_jobOrder.size(); jobIndex++) {
+                if (m_jobOrder[jobIndex] -> contains(system)) {
+                    stagePerJob[jobIndex].push_back(system);
+                    break;
+                }
+            }
+        }
+
+        m_stagesPerJob.push_back(std::move(stagePerJob));
+    }
+
+    m_isScheduleDirty = false;
+    m_scheduleAccessVersion = currentAccessVersion;
+}
+
+uint64_t World::accessVersion() const {
+    uint64_t version = 0;
+
+    for (auto& system : m_systemOrder) {
+        version += system -> accessVersion();
+    }
+
+    return version;
 }
\ No newline at end of file
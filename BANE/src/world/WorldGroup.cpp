@@ -0,0 +1,108 @@
+#include "harmful/bane/world/WorldGroup.hpp"
+#include "harmful/bane/world/Snapshot.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+using namespace Bane;
+
+WorldGroup::WorldGroup(
+    const uint8_t threadCount,
+    Definition definition,
+    std::shared_ptr<const Assets> assets,
+    const ThreadPlacement& placement
+) : m_threads(std::make_shared<WorkerPool>(threadCount, placement)),
+    m_assets(std::move(assets)),
+    m_definition(std::move(definition)) {
+    if (!m_definition) {
+        throw std::runtime_error("");
+    }
+}
+
+WorldGroup::~WorldGroup() noexcept {
+    m_worlds.clear();
+    m_threads -> stop();
+}
+
+World* WorldGroup::create() {
+    auto world = std::make_unique<World>();
+    world -> setThreads(m_threads);
+    world -> setAssets(m_assets);
+    m_definition(*world);
+    m_worlds.push_back(std::move(world));
+    return m_worlds.back().get();
+}
+
+World* WorldGroup::fork(const World& source) {
+    auto world = std::make_unique<World>();
+    world -> setThreads(m_threads);
+    world -> setAssets(m_assets);
+    m_definition(*world);
+    Snapshot::Copy(source, *world);
+    m_worlds.push_back(std::move(world));
+    return m_worlds.back().get();
+}
+
+void WorldGroup::destroy(const World* world) {
+    auto found = std::find_if(
+        m_worlds.begin(),
+        m_worlds.end(),
+        [world](const std::unique_ptr<World>& candidate) { return candidate.get() == world; }
+    );
+
+    if (found != m_worlds.end()) {
+        m_worlds.erase(found);
+    }
+}
+
+void WorldGroup::run() {
+    for (auto& world : m_worlds) {
+        world -> m_dueJobs.assign(world -> m_jobOrder.size(), true);
+    }
+
+    runStages();
+}
+
+void WorldGroup::step() {
+    for (auto& world : m_worlds) {
+        world -> paceJobs();
+    }
+
+    runStages();
+
+    for (auto& world : m_worlds) {
+        world -> m_amountSteps++;
+    }
+}
+
+void WorldGroup::runStages() {
+    size_t amountStages = 0;
+
+    for (auto& world : m_worlds) {
+        world -> updateSchedule();
+        amountStages = std::max(amountStages, world -> m_stagesPerJob.size());
+
+        if (!world -> m_stagesPerJob.empty()) {
+            world -> submitStage(0, world -> m_dueJobs);
+        }
+    }
+
+    for (size_t stageIndex = 0; stageIndex < amountStages; stageIndex++) {
+        for (auto& world : m_worlds) {
+            size_t amountWorldStages = world -> m_stagesPerJob.size();
+
+            if (stageIndex >= amountWorldStages) {
+                continue;
+            }
+
+            world -> finishStage(stageIndex, world -> m_dueJobs);
+
+            if (stageIndex + 1 < amountWorldStages) {
+                world -> submitStage(stageIndex + 1, world -> m_dueJobs);
+            }
+        }
+    }
+
+    for (auto& world : m_worlds) {
+        world -> finishStages(world -> m_dueJobs);
+    }
+}
\ No newline at end of file
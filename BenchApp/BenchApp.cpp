@@ -0,0 +1,1035 @@
+// BenchApp.cpp : Microbenchmarks of the BANE ECS.
+//
+// Usage:
+//   BenchApp [--entities 1000,10000,100000,1000000] [--threads 1,2,4]
+//            [--frames 20] [--filter name] [--csv file] [--json file] [--help]
+//
+// A bad, unknown or incomplete option prints the usage and exits with 1.
+//
+// Benchmarks (--filter keeps those whose name contains the given text):
+//   entities     World::createEntity(), World::destroy() and
+//                World::createEntities()
+//   factory      ComponentFactory insertion, bulk insertion and removal
+//   world_run    World::run() frame time with synthetic Systems
+//   job_execute  Job::execute() synchronisation overhead on empty work
+//   snapshot     Snapshot::Save() and Snapshot::Load() of a whole World
+//   transforms   TransformSystem world matrices of a scene graph, all of
+//                them then 1% of the local transforms changed per frame
+//   spatial      SpatialHashGrid and LooseOctree re-insertion of moving
+//                Entities and k-nearest queries, against a linear scan
+//   worlds       Frame time of 16 Worlds sharing the Entities, run one
+//                after the other with their own threads, then together in
+//                a WorldGroup
+//   prefab       Spawn waves of Entities with three Components, one
+//                Component at a time, with World::createEntities() and
+//                with World::instantiate()
+//   lookup       Find a System by name and by type, in the World and among
+//                the linked Systems (LinkedSystems against a map of names)
+//
+// Each benchmark is run for each amount of Entities and, when relevant,
+// each amount of threads. The results are printed and can be written as
+// CSV and/or JSON to compare the storage and scheduler changes.
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <harmful/doom/utils/Chrono.hpp>
+#include <harmful/bane/components/TypedComponentFactory.hpp>
+#include <harmful/bane/jobs/Job.hpp>
+#include <harmful/bane/spatial/LooseOctree.hpp>
+#include <harmful/bane/spatial/SpatialHashGrid.hpp>
+#include <harmful/bane/systems/System.hpp>
+#include <harmful/bane/transforms/TransformSystem.hpp>
+#include <harmful/bane/world/Snapshot.hpp>
+#include <harmful/bane/world/World.hpp>
+#include <harmful/bane/world/WorldGroup.hpp>
+
+using namespace Bane;
+
+namespace {
+    /// <summary>
+    /// Result of a benchmark for an amount of Entities and threads.
+    /// </summary>
+    struct Result {
+        std::string benchmark;
+        size_t entities;
+        size_t threads;
+        size_t operations;
+        std::intmax_t totalNanoseconds;
+
+        double nanosecondsPerOperation() const {
+            return static_cast<double>(totalNanoseconds) / static_cast<double>(std::max<size_t>(operations, 1));
+        }
+
+        double operationsPerSecond() const {
+            return (totalNanoseconds > 0)
+                ? (static_cast<double>(operations) * 1e9) / static_cast<double>(totalNanoseconds)
+                : 0.;
+        }
+    };
+
+    /// <summary>
+    /// Options from the command line.
+    /// </summary>
+    struct Options {
+        std::vector<size_t> entities { 1000, 10000, 100000, 1000000 };
+        std::vector<size_t> threads;
+        size_t frames = 20;
+        std::string filter;
+        std::string csvPath;
+        std::string jsonPath;
+        bool help = false;
+    };
+
+    // ---------------------------------------------------------------------
+    // Synthetic Components and Systems.
+    // ---------------------------------------------------------------------
+
+    struct Position : ComponentData {
+        float x = 0.f, y = 0.f, z = 0.f;
+
+        static Quantity AllowedQuantity() {
+            return Quantity::One;
+        }
+    };
+
+    struct Velocity : ComponentData {
+        float x = 1.f, y = 0.5f, z = 0.25f;
+
+        static Quantity AllowedQuantity() {
+            return Quantity::One;
+        }
+    };
+
+    struct Health : ComponentData {
+        float value = 100.f;
+
+        static Quantity AllowedQuantity() {
+            return Quantity::One;
+        }
+    };
+
+    /// <summary>
+    /// Moves the Positions by the Velocities of the linked System.
+    /// </summary>
+    class MoveProcessing final : public SystemProcessing {
+        public:
+            void run(
+                const LinkedSystems& linkedSystems,
+                CommandBuffer&,
+                const size_t fromIndex,
+                const size_t toIndex
+            ) override {
+                auto velocitySystem = linkedSystems.of<Velocity>();
+                auto velocities = velocitySystem -> components().as<Velocity>();
+                auto velocityFactory = velocitySystem -> factory();
+                auto& positionColumn = system() -> components();
+                auto positions = positionColumn.as<Position>();
+
+                for (size_t index = fromIndex; index < toIndex; index++) {
+                    auto velocityIndex = velocityFactory -> indexOf(Entity(positionColumn.entityAt(index)));
+
+                    if (velocityIndex == SparseSet::InvalidIndex) {
+                        continue;
+                    }
+
+                    positions[index].x += velocities[velocityIndex].x;
+                    positions[index].y += velocities[velocityIndex].y;
+                    positions[index].z += velocities[velocityIndex].z;
+                }
+            }
+    };
+
+    /// <summary>
+    /// Damps the Velocities.
+    /// </summary>
+    class DampProcessing final : public SystemProcessing {
+        public:
+            void run(
+                const LinkedSystems&,
+                CommandBuffer&,
+                const size_t fromIndex,
+                const size_t toIndex
+            ) override {
+                auto velocities = system() -> components().as<Velocity>();
+
+                for (size_t index = fromIndex; index < toIndex; index++) {
+                    velocities[index].x *= 0.99f;
+                    velocities[index].y *= 0.99f;
+                    velocities[index].z *= 0.99f;
+                }
+            }
+    };
+
+    /// <summary>
+    /// Regenerates the Health.
+    /// </summary>
+    class HealthProcessing final : public SystemProcessing {
+        public:
+            void run(
+                const LinkedSystems&,
+                CommandBuffer&,
+                const size_t fromIndex,
+                const size_t toIndex
+            ) override {
+                auto healths = system() -> components().as<Health>();
+
+                for (size_t index = fromIndex; index < toIndex; index++) {
+                    healths[index].value = std::min(healths[index].value + 0.1f, 100.f);
+                }
+            }
+    };
+
+    /// <summary>
+    /// Does nothing, to measure the cost of the scheduling alone.
+    /// </summary>
+    class EmptyProcessing final : public SystemProcessing {
+        public:
+            void run(
+                const LinkedSystems&,
+                CommandBuffer&,
+                const size_t,
+                const size_t
+            ) override {}
+    };
+
+    /// <summary>
+    /// System with a given data type and processing.
+    /// </summary>
+    template <class DataClass, class ProcessingClass>
+    class BenchSystem final : public System {
+        public:
+            BenchSystem(const std::string& name) : System(name) {}
+
+        protected:
+            std::unique_ptr<ComponentFactory> createFactory() override {
+                return std::make_unique<TypedComponentFactory<DataClass>>();
+            }
+
+            std::unique_ptr<SystemProcessing> createProcessing() override {
+                return std::make_unique<ProcessingClass>();
+            }
+    };
+
+    using MoveSystem = BenchSystem<Position, MoveProcessing>;
+    using DampSystem = BenchSystem<Velocity, DampProcessing>;
+    using HealthSystem = BenchSystem<Health, HealthProcessing>;
+    using EmptySystem = BenchSystem<Position, EmptyProcessing>;
+
+    // ---------------------------------------------------------------------
+    // Benchmarks.
+    // ---------------------------------------------------------------------
+
+    /// <summary>
+    /// Measure the execution time of a function, in nanoseconds.
+    /// </summary>
+    std::intmax_t measure(const std::function<void()>& function) {
+        Doom::Chrono chrono;
+        chrono.start();
+        function();
+        chrono.stop();
+        return chrono.elapsedTime<std::chrono::nanoseconds>();
+    }
+
+    /// <summary>
+    /// Entity creation then destruction through the World.
+    /// </summary>
+    void benchEntities(const size_t amountEntities, std::vector<Result>& results) {
+        World world;
+        std::vector<Entity> entities(amountEntities);
+
+        auto createTime = measure([&]() {
+            for (auto& entity : entities) {
+                entity = world.createEntity();
+            }
+        });
+
+        auto destroyTime = measure([&]() {
+            for (auto& entity : entities) {
+                world.destroy(entity);
+            }
+        });
+
+        auto bulkCreateTime = measure([&]() {
+            world.createEntities(amountEntities);
+        });
+
+        results.push_back({ "world_create_entity", amountEntities, 1, amountEntities, createTime });
+        results.push_back({ "world_destroy_entity", amountEntities, 1, amountEntities, destroyTime });
+        results.push_back({ "world_create_entities_bulk", amountEntities, 1, amountEntities, bulkCreateTime });
+    }
+
+    /// <summary>
+    /// Component insertion, bulk insertion and removal in a
+    /// ComponentFactory.
+    /// </summary>
+    void benchFactory(const size_t amountEntities, std::vector<Result>& results) {
+        std::vector<Entity> entities;
+        entities.reserve(amountEntities);
+
+        for (size_t index = 0; index < amountEntities; index++) {
+            entities.emplace_back(static_cast<uint32_t>(index), 1);
+        }
+
+        TypedComponentFactory<Position> factory;
+
+        auto insertTime = measure([&]() {
+            for (auto& entity : entities) {
+                factory.createComponentFor(entity);
+            }
+        });
+
+        // Remove in a random order so that the swap and pop moves data.
+        std::vector<Entity> shuffled = entities;
+        std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(42));
+
+        auto removeTime = measure([&]() {
+            for (auto& entity : shuffled) {
+                factory.destroyComponentsOf(entity);
+            }
+        });
+
+        TypedComponentFactory<Position> bulkFactory;
+
+        auto bulkInsertTime = measure([&]() {
+            bulkFactory.createComponentsFor(entities);
+        });
+
+        results.push_back({ "factory_insert", amountEntities, 1, amountEntities, insertTime });
+        results.push_back({ "factory_remove", amountEntities, 1, amountEntities, removeTime });
+        results.push_back({ "factory_bulk_insert", amountEntities, 1, amountEntities, bulkInsertTime });
+    }
+
+    /// <summary>
+    /// Frame time of World::run() with three synthetic Systems on two
+    /// stages.
+    /// </summary>
+    void benchWorldRun(
+        const size_t amountEntities,
+        const size_t amountThreads,
+        const size_t amountFrames,
+        std::vector<Result>& results
+    ) {
+        World world;
+        auto move = world.system<MoveSystem>("move");
+        auto damp = world.system<DampSystem>("velocity");
+        auto health = world.system<HealthSystem>("health");
+        move -> setup();
+        damp -> setup();
+        health -> setup();
+        move -> link(damp);
+
+        std::vector<Entity> entities(amountEntities);
+
+        for (auto& entity : entities) {
+            entity = world.createEntity();
+        }
+
+        move -> createMany(entities);
+        damp -> createMany(entities);
+        health -> createMany(entities);
+
+        std::list<std::string> systemNames { "move", "velocity", "health" };
+        world.addJob("bench", systemNames, static_cast<uint8_t>(amountThreads));
+
+        // Warm up, so that the chunks are balanced from measures.
+        world.run();
+
+        auto runTime = measure([&]() {
+            for (size_t frame = 0; frame < amountFrames; frame++) {
+                world.run();
+            }
+        });
+
+        world.stop();
+        results.push_back({ "world_run_frame", amountEntities, amountThreads, amountFrames, runTime });
+    }
+
+    /// <summary>
+    /// Frame time of several small Worlds with the Systems of
+    /// benchWorldRun(): each World with its own threads, run one after the
+    /// other, then all of them together on the threads of a WorldGroup.
+    /// </summary>
+    void benchWorlds(
+        const size_t amountEntities,
+        const size_t amountThreads,
+        const size_t amountFrames,
+        std::vector<Result>& results
+    ) {
+        constexpr size_t AmountWorlds = 16;
+
+        auto define = [amountThreads](World& world) {
+            auto move = world.system<MoveSystem>("move");
+            auto damp = world.system<DampSystem>("velocity");
+            auto health = world.system<HealthSystem>("health");
+            move -> setup();
+            damp -> setup();
+            health -> setup();
+            move -> link(damp);
+
+            std::list<std::string> systemNames { "move", "velocity", "health" };
+            world.addJob("bench", systemNames, static_cast<uint8_t>(amountThreads));
+        };
+
+        auto populate = [amountEntities](World& world) {
+            Prototype prototype;
+            prototype.add(world.system<MoveSystem>("move"))
+                .add(world.system<DampSystem>("velocity"))
+                .add(world.system<HealthSystem>("health"));
+            world.createEntities(std::max<size_t>(amountEntities / AmountWorlds, 1), prototype);
+        };
+
+        std::vector<std::unique_ptr<World>> worlds;
+
+        for (size_t worldIndex = 0; worldIndex < AmountWorlds; worldIndex++) {
+            worlds.push_back(std::make_unique<World>());
+            define(*worlds.back());
+            populate(*worlds.back());
+            worlds.back() -> run();
+        }
+
+        auto separateTime = measure([&]() {
+            for (size_t frame = 0; frame < amountFrames; frame++) {
+                for (auto& world : worlds) {
+                    world -> run();
+                }
+            }
+        });
+
+        for (auto& world : worlds) {
+            world -> stop();
+        }
+
+        WorldGroup group(static_cast<uint8_t>(amountThreads), define);
+
+        for (size_t worldIndex = 0; worldIndex < AmountWorlds; worldIndex++) {
+            populate(*group.create());
+        }
+
+        group.run();
+
+        auto groupTime = measure([&]() {
+            for (size_t frame = 0; frame < amountFrames; frame++) {
+                group.run();
+            }
+        });
+
+        results.push_back({ "worlds_run_separate", amountEntities, amountThreads, amountFrames, separateTime });
+        results.push_back({ "worlds_run_group", amountEntities, amountThreads, amountFrames, groupTime });
+    }
+
+    /// <summary>
+    /// Spawn waves of Entities with three Components given initial data:
+    /// Component by Component, from a Prototype and from a Prefab.
+    /// </summary>
+    void benchPrefab(const size_t amountEntities, std::vector<Result>& results) {
+        constexpr size_t WaveSize = 1000;
+
+        World world;
+        auto move = world.system<MoveSystem>("move");
+        auto damp = world.system<DampSystem>("velocity");
+        auto health = world.system<HealthSystem>("health");
+        move -> setup();
+        damp -> setup();
+        health -> setup();
+
+        Position position;
+        position.x = 1.f;
+        Velocity velocity;
+        velocity.y = 2.f;
+        Health life;
+        life.value = 50.f;
+
+        Prototype prototype;
+        prototype.add(move, position).add(damp, velocity).add(health, life);
+        Prefab prefab(prototype);
+
+        auto spawn = [&](const std::function<void(const size_t)>& wave) {
+            world.clear();
+
+            return measure([&]() {
+                for (size_t amountSpawned = 0; amountSpawned < amountEntities; amountSpawned += WaveSize) {
+                    wave(std::min(WaveSize, amountEntities - amountSpawned));
+                }
+            });
+        };
+
+        auto componentTime = spawn([&](const size_t amount) {
+            for (size_t index = 0; index < amount; index++) {
+                auto entity = world.createEntity();
+                *static_cast<Position*>(move -> create(entity).data()) = position;
+                *static_cast<Velocity*>(damp -> create(entity).data()) = velocity;
+                *static_cast<Health*>(health -> create(entity).data()) = life;
+            }
+        });
+
+        auto prototypeTime = spawn([&](const size_t amount) {
+            world.createEntities(amount, prototype);
+        });
+
+        auto prefabTime = spawn([&](const size_t amount) {
+            world.instantiate(prefab, amount);
+        });
+
+        results.push_back({ "prefab_spawn_components", amountEntities, 1, amountEntities, componentTime });
+        results.push_back({ "prefab_spawn_prototype", amountEntities, 1, amountEntities, prototypeTime });
+        results.push_back({ "prefab_spawn_instantiate", amountEntities, 1, amountEntities, prefabTime });
+    }
+
+    /// <summary>
+    /// Find a System as many times as there are Entities: in the World by
+    /// its name then by its class, and among linked Systems in a map keyed
+    /// by name, by name then by the type of its Components.
+    /// </summary>
+    void benchLookup(const size_t amountEntities, std::vector<Result>& results) {
+        World world;
+        auto move = world.system<MoveSystem>("move");
+        auto damp = world.system<DampSystem>("velocity");
+        auto health = world.system<HealthSystem>("health");
+        move -> setup();
+        damp -> setup();
+        health -> setup();
+
+        LinkedSystems linkedSystems;
+        linkedSystems.add(health);
+        linkedSystems.add(damp);
+
+        std::unordered_map<std::string, System*> namedSystems {
+            { health -> name(), health },
+            { damp -> name(), damp }
+        };
+
+        // Summed so that the lookups are not optimized out.
+        uintptr_t checksum = 0;
+
+        auto worldNameTime = measure([&]() {
+            for (size_t index = 0; index < amountEntities; index++) {
+                checksum += reinterpret_cast<uintptr_t>(world.system<DampSystem>("velocity"));
+            }
+        });
+
+        auto worldClassTime = measure([&]() {
+            for (size_t index = 0; index < amountEntities; index++) {
+                checksum += reinterpret_cast<uintptr_t>(world.system<DampSystem>());
+            }
+        });
+
+        auto mapTime = measure([&]() {
+            for (size_t index = 0; index < amountEntities; index++) {
+                checksum += reinterpret_cast<uintptr_t>(namedSystems.at("velocity"));
+            }
+        });
+
+        auto linkedNameTime = measure([&]() {
+            for (size_t index = 0; index < amountEntities; index++) {
+                checksum += reinterpret_cast<uintptr_t>(linkedSystems.at("velocity"));
+            }
+        });
+
+        auto linkedTypeTime = measure([&]() {
+            for (size_t index = 0; index < amountEntities; index++) {
+                checksum += reinterpret_cast<uintptr_t>(linkedSystems.of<Velocity>());
+            }
+        });
+
+        if (checksum == 0) {
+            throw std::runtime_error("");
+        }
+
+        results.push_back({ "lookup_world_name", amountEntities, 1, amountEntities, worldNameTime });
+        results.push_back({ "lookup_world_class", amountEntities, 1, amountEntities, worldClassTime });
+        results.push_back({ "lookup_linked_map", amountEntities, 1, amountEntities, mapTime });
+        results.push_back({ "lookup_linked_name", amountEntities, 1, amountEntities, linkedNameTime });
+        results.push_back({ "lookup_linked_type", amountEntities, 1, amountEntities, linkedTypeTime });
+    }
+
+    /// <summary>
+    /// Checkpoint and restore of a World with three Systems through a
+    /// temporary file.
+    /// </summary>
+    void benchSnapshot(const size_t amountEntities, std::vector<Result>& results) {
+        World world;
+        auto move = world.system<MoveSystem>("move");
+        auto damp = world.system<DampSystem>("velocity");
+        auto health = world.system<HealthSystem>("health");
+        move -> setup();
+        damp -> setup();
+        health -> setup();
+
+        Prototype prototype;
+        prototype.add(move).add(damp).add(health);
+        world.createEntities(amountEntities, prototype);
+
+        auto path = std::filesystem::temp_directory_path() / "bane_bench_snapshot.bin";
+
+        auto saveTime = measure([&]() {
+            Snapshot::Save(world, path);
+        });
+
+        auto loadTime = measure([&]() {
+            Snapshot::Load(world, path);
+        });
+
+        std::filesystem::remove(path);
+        results.push_back({ "snapshot_save", amountEntities, 1, amountEntities, saveTime });
+        results.push_back({ "snapshot_load", amountEntities, 1, amountEntities, loadTime });
+    }
+
+    /// <summary>
+    /// World matrices of a scene graph where each node has four children:
+    /// first all of them, then after changing 1% of the local transforms
+    /// (leaves) per frame.
+    /// </summary>
+    void benchTransforms(
+        const size_t amountEntities,
+        const size_t amountThreads,
+        const size_t amountFrames,
+        std::vector<Result>& results
+    ) {
+        World world;
+        auto transforms = world.system<TransformSystem>("transforms");
+        transforms -> setup();
+
+        std::vector<Entity> entities(amountEntities);
+
+        for (auto& entity : entities) {
+            entity = world.createEntity();
+        }
+
+        transforms -> createMany(entities);
+
+        for (size_t index = 1; index < amountEntities; index++) {
+            transforms -> setParent(entities[index], entities[(index - 1) / 4]);
+        }
+
+        std::list<std::string> systemNames { "transforms" };
+        world.addJob("bench", systemNames, static_cast<uint8_t>(amountThreads));
+        Mind::Quaternion rotation(Mind::Vector3f(0.f, 1.f, 0.f), 0.1f);
+        Mind::Vector3f scale(1.f, 1.f, 1.f);
+
+        // The changed nodes are taken among the leaves (the last 3/4 of the
+        // nodes), as in a scene where some objects move.
+        auto changeLocals = [&]() {
+            for (size_t index = amountEntities / 4; index < amountEntities; index += 75) {
+                transforms -> setLocal(entities[index], Mind::Vector3f(1.f, 0.f, 0.f), rotation, scale);
+            }
+        };
+
+        // The first frame sorts the hierarchy.
+        world.run();
+
+        auto fullTime = measure([&]() {
+            for (size_t frame = 0; frame < amountFrames; frame++) {
+                transforms -> markChanged(0, transforms -> componentsCount());
+                world.run();
+            }
+        });
+
+        auto partialTime = measure([&]() {
+            for (size_t frame = 0; frame < amountFrames; frame++) {
+                changeLocals();
+                world.run();
+            }
+        });
+
+        world.stop();
+        results.push_back({ "transforms_full_frame", amountEntities, amountThreads, amountFrames, fullTime });
+        results.push_back({ "transforms_partial_frame", amountEntities, amountThreads, amountFrames, partialTime });
+    }
+
+    /// <summary>
+    /// Entities moving in a 1000 units wide space, re-inserted in a
+    /// SpatialIndex at each frame, then the 8 nearest ones of 1000 points.
+    /// The linear scan is the cost of the queries without an index.
+    /// </summary>
+    void benchSpatial(
+        const size_t amountEntities,
+        const size_t amountFrames,
+        std::vector<Result>& results
+    ) {
+        constexpr size_t AmountQueries = 1000;
+        constexpr size_t AmountNeighbours = 8;
+
+        std::mt19937 generator(7);
+        std::uniform_real_distribution<float> position(-500.f, 500.f);
+        std::uniform_real_distribution<float> step(-1.f, 1.f);
+        std::vector<SpatialIndex::Entry> entries(amountEntities);
+
+        for (size_t index = 0; index < amountEntities; index++) {
+            entries[index] = {
+                Entity(static_cast<uint32_t>(index + 1), 1).id(),
+                { position(generator), position(generator), position(generator) },
+                0.5f
+            };
+        }
+
+        std::vector<Mind::Point3Df> queries;
+
+        for (size_t index = 0; index < AmountQueries; index++) {
+            queries.emplace_back(position(generator), position(generator), position(generator));
+        }
+
+        auto benchIndex = [&](const std::string& name, SpatialIndex& index) {
+            index.update(entries);
+            std::vector<SpatialIndex::Entry> moved = entries;
+
+            auto updateTime = measure([&]() {
+                for (size_t frame = 0; frame < amountFrames; frame++) {
+                    for (auto& entry : moved) {
+                        entry.position[0] += step(generator);
+                        entry.position[1] += step(generator);
+                    }
+
+                    index.update(moved);
+                }
+            });
+
+            std::vector<id_t> neighbours;
+            size_t amountFound = 0;
+
+            auto nearestTime = measure([&]() {
+                for (auto& query : queries) {
+                    neighbours.clear();
+                    index.nearest(query, AmountNeighbours, neighbours);
+                    amountFound += neighbours.size();
+                }
+            });
+
+            if (amountFound != std::min(amountEntities, AmountNeighbours) * AmountQueries) {
+                std::cerr << name << ": wrong amount of neighbours" << std::endl;
+            }
+
+            results.push_back({ name + "_update", amountEntities, 1, amountEntities * amountFrames, updateTime });
+            results.push_back({ name + "_nearest", amountEntities, 1, AmountQueries, nearestTime });
+        };
+
+        SpatialHashGrid grid(16.f);
+        benchIndex("spatial_grid", grid);
+
+        LooseOctree octree(Mind::Point3Df(0.f, 0.f, 0.f), 512.f, 6);
+        benchIndex("spatial_octree", octree);
+
+        std::vector<std::pair<float, id_t>> distances;
+
+        auto linearTime = measure([&]() {
+            for (auto& query : queries) {
+                distances.clear();
+
+                for (auto& entry : entries) {
+                    float x = entry.position[0] - query[0];
+                    float y = entry.position[1] - query[1];
+                    float z = entry.position[2] - query[2];
+                    distances.emplace_back((x * x) + (y * y) + (z * z), entry.id);
+                }
+
+                auto amount = std::min(distances.size(), AmountNeighbours);
+                std::partial_sort(distances.begin(), distances.begin() + amount, distances.end());
+            }
+        });
+
+        results.push_back({ "spatial_linear_nearest", amountEntities, 1, AmountQueries, linearTime });
+    }
+
+    /// <summary>
+    /// Cost of Job::execute() on empty work: dispatching the chunks to the
+    /// threads and waiting for them.
+    /// </summary>
+    void benchJobSync(
+        const size_t amountThreads,
+        const size_t amountFrames,
+        std::vector<Result>& results
+    ) {
+        EntityFactory entityFactory;
+        EmptySystem system("empty");
+        system.setup();
+
+        // Enough Components for each thread to get several chunks.
+        std::vector<Entity> entities(amountThreads * 1024);
+
+        for (auto& entity : entities) {
+            entity = entityFactory.create();
+        }
+
+        system.createMany(entities);
+
+        Job job("sync", { &system }, static_cast<uint8_t>(amountThreads), entityFactory);
+        job.setBalancing(ChunkBalancer::Mode::Static);
+        job.execute();
+
+        const size_t amountExecutions = amountFrames * 50;
+
+        auto executeTime = measure([&]() {
+            for (size_t execution = 0; execution < amountExecutions; execution++) {
+                job.execute();
+            }
+        });
+
+        job.stop();
+        results.push_back({ "job_execute_sync", entities.size(), amountThreads, amountExecutions, executeTime });
+    }
+
+    // ---------------------------------------------------------------------
+    // Command line and output.
+    // ---------------------------------------------------------------------
+
+    const char* Usage =
+        "Usage: BenchApp [options]\n"
+        "  --entities N[,N...]  Amounts of Entities (default 1000,10000,100000,1000000)\n"
+        "  --threads N[,N...]   Amounts of threads (default powers of 2 up to the cores)\n"
+        "  --frames N           Frames run by the frame time benchmarks (default 20)\n"
+        "  --filter TEXT        Only run the benchmarks whose name contains TEXT\n"
+        "  --csv FILE           Write the results as CSV to FILE\n"
+        "  --json FILE          Write the results as JSON to FILE\n"
+        "  --help               Print this text\n"
+        "Benchmarks: entities, factory, world_run, job_execute, snapshot, transforms,\n"
+        "            spatial, worlds, prefab, lookup\n";
+
+    /// <summary>
+    /// Parse a strictly positive number. Throw std::invalid_argument or
+    /// std::out_of_range if the whole text is not such a number.
+    /// </summary>
+    size_t parseSize(const std::string& text) {
+        if (text.empty() || !std::isdigit(static_cast<unsigned char>(text.front()))) {
+            throw std::invalid_argument(text);
+        }
+
+        size_t parsedLength = 0;
+        size_t value = std::stoull(text, &parsedLength);
+
+        if ((parsedLength != text.size()) || (value == 0)) {
+            throw std::invalid_argument(text);
+        }
+
+        return value;
+    }
+
+    std::vector<size_t> parseList(const std::string& text) {
+        std::vector<size_t> values;
+        std::stringstream stream(text);
+        std::string item;
+
+        while (std::getline(stream, item, ',')) {
+            values.push_back(parseSize(item));
+        }
+
+        if (values.empty()) {
+            throw std::invalid_argument(text);
+        }
+
+        return values;
+    }
+
+    /// <summary>
+    /// Read the command line into options. Report the first bad, unknown or
+    /// incomplete argument on the error output and return false.
+    /// </summary>
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int argIndex = 1; argIndex < argc; argIndex++) {
+            std::string argument = argv[argIndex];
+
+            if (argument == "--help") {
+                options.help = true;
+                return true;
+            }
+
+            bool isKnown = (argument == "--entities") || (argument == "--threads")
+                || (argument == "--frames") || (argument == "--filter")
+                || (argument == "--csv") || (argument == "--json");
+
+            if (!isKnown) {
+                std::cerr << "Unknown option " << argument << std::endl;
+                return false;
+            }
+
+            if ((argIndex + 1) >= argc) {
+                std::cerr << "Missing value for " << argument << std::endl;
+                return false;
+            }
+
+            std::string value = argv[++argIndex];
+
+            try {
+                if (argument == "--entities") {
+                    options.entities = parseList(value);
+                }
+                else if (argument == "--threads") {
+                    options.threads = parseList(value);
+                }
+                else if (argument == "--frames") {
+                    options.frames = parseSize(value);
+                }
+                else if (argument == "--filter") {
+                    options.filter = value;
+                }
+                else if (argument == "--csv") {
+                    options.csvPath = value;
+                }
+                else {
+                    options.jsonPath = value;
+                }
+            }
+            catch (const std::logic_error&) {
+                // std::invalid_argument and std::out_of_range from parseSize().
+                std::cerr << "Bad value for " << argument << ": " << value << std::endl;
+                return false;
+            }
+        }
+
+        if (options.threads.empty()) {
+            size_t hardwareThreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+            for (size_t threads = 1; threads < hardwareThreads; threads *= 2) {
+                options.threads.push_back(threads);
+            }
+
+            options.threads.push_back(hardwareThreads);
+        }
+
+        return true;
+    }
+
+    void writeCSV(const std::string& path, const std::vector<Result>& results) {
+        std::ofstream file(path);
+        file << "benchmark,entities,threads,operations,total_ns,ns_per_op,ops_per_second\n";
+
+        for (auto& result : results) {
+            file << result.benchmark << ','
+                 << result.entities << ','
+                 << result.threads << ','
+                 << result.operations << ','
+                 << result.totalNanoseconds << ','
+                 << result.nanosecondsPerOperation() << ','
+                 << result.operationsPerSecond() << '\n';
+        }
+    }
+
+    void writeJSON(const std::string& path, const std::vector<Result>& results) {
+        std::ofstream file(path);
+        file << "[\n";
+
+        for (size_t index = 0; index < results.size(); index++) {
+            auto& result = results[index];
+            file << "  {"
+                 << "\"benchmark\": \"" << result.benchmark << "\", "
+                 << "\"entities\": " << result.entities << ", "
+                 << "\"threads\": " << result.threads << ", "
+                 << "\"operations\": " << result.operations << ", "
+                 << "\"total_ns\": " << result.totalNanoseconds << ", "
+                 << "\"ns_per_op\": " << result.nanosecondsPerOperation() << ", "
+                 << "\"ops_per_second\": " << result.operationsPerSecond()
+                 << ((index + 1 < results.size()) ? "},\n" : "}\n");
+        }
+
+        file << "]\n";
+    }
+
+    void print(const Result& result) {
+        std::cout << result.benchmark
+                  << "\tentities=" << result.entities
+                  << "\tthreads=" << result.threads
+                  << "\tns/op=" << result.nanosecondsPerOperation()
+                  << "\tops/s=" << result.operationsPerSecond()
+                  << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << Usage;
+        return 1;
+    }
+
+    if (options.help) {
+        std::cout << Usage;
+        return 0;
+    }
+
+    std::vector<Result> results;
+
+    auto isSelected = [&](const std::string& name) {
+        return options.filter.empty() || (name.find(options.filter) != std::string::npos);
+    };
+
+    auto run = [&](const std::function<void()>& benchmark) {
+        size_t firstNewResult = results.size();
+        benchmark();
+
+        for (size_t index = firstNewResult; index < results.size(); index++) {
+            print(results[index]);
+        }
+    };
+
+    for (auto amountEntities : options.entities) {
+        if (isSelected("entities")) {
+            run([&]() { benchEntities(amountEntities, results); });
+        }
+
+        if (isSelected("factory")) {
+            run([&]() { benchFactory(amountEntities, results); });
+        }
+
+        if (isSelected("world_run")) {
+            for (auto amountThreads : options.threads) {
+                run([&]() { benchWorldRun(amountEntities, amountThreads, options.frames, results); });
+            }
+        }
+
+        if (isSelected("snapshot")) {
+            run([&]() { benchSnapshot(amountEntities, results); });
+        }
+
+        if (isSelected("transforms")) {
+            for (auto amountThreads : options.threads) {
+                run([&]() { benchTransforms(amountEntities, amountThreads, options.frames, results); });
+            }
+        }
+
+        if (isSelected("spatial")) {
+            run([&]() { benchSpatial(amountEntities, options.frames, results); });
+        }
+
+        if (isSelected("worlds")) {
+            for (auto amountThreads : options.threads) {
+                run([&]() { benchWorlds(amountEntities, amountThreads, options.frames, results); });
+            }
+        }
+
+        if (isSelected("prefab")) {
+            run([&]() { benchPrefab(amountEntities, results); });
+        }
+
+        if (isSelected("lookup")) {
+            run([&]() { benchLookup(amountEntities, results); });
+        }
+    }
+
+    if (isSelected("job_execute")) {
+        for (auto amountThreads : options.threads) {
+            run([&]() { benchJobSync(amountThreads, options.frames, results); });
+        }
+    }
+
+    if (!options.csvPath.empty()) {
+        writeCSV(options.csvPath, results);
+    }
+
+    if (!options.jsonPath.empty()) {
+        writeJSON(options.jsonPath, results);
+    }
+
+    return 0;
+}
@@ -0,0 +1,123 @@
+#ifndef __DOOM_CPU_TOPOLOGY__
+#define __DOOM_CPU_TOPOLOGY__
+
+#include "harmful/doom/utils/Platform.hpp"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Doom {
+    /// <summary>
+    /// Layout of the logical cores the process can run on: physical core,
+    /// package (socket) and NUMA node of each of them.
+    /// </summary>
+    class CPUTopology final {
+        public:
+            /// <summary>
+            /// A logical core (hardware thread) of the system.
+            /// </summary>
+            struct LogicalCore {
+                /// <summary>
+                /// Index of the logical core in the system, as used by
+                /// PinCurrentThread(). On Windows, processor group * 64 +
+                /// index in the group.
+                /// </summary>
+                uint32_t index ;
+
+                /// <summary>
+                /// Index of its physical core, unique in the system.
+                /// </summary>
+                uint32_t physicalCore ;
+
+                /// <summary>
+                /// Index of its package (socket).
+                /// </summary>
+                uint32_t package ;
+
+                /// <summary>
+                /// Index of its NUMA node.
+                /// </summary>
+                uint32_t numaNode ;
+
+                /// <summary>
+                /// Rank among the logical cores of its physical core: 0 for the
+                /// first one, 1 for its first SMT sibling...
+                /// </summary>
+                uint32_t siblingRank ;
+            } ;
+
+        private:
+            /// <summary>
+            /// Logical cores available to the process, sorted by index.
+            /// </summary>
+            std::vector<LogicalCore> m_cores ;
+
+            /// <summary>
+            /// Amount of physical cores among the available logical cores.
+            /// </summary>
+            size_t m_amountPhysicalCores = 0 ;
+
+            /// <summary>
+            /// Amount of NUMA nodes of the available logical cores (highest
+            /// index + 1).
+            /// </summary>
+            size_t m_amountNumaNodes = 0 ;
+
+        public:
+            /// <summary>
+            /// Read the topology of the system. If it cannot be read, each
+            /// logical core is considered as a physical core of a single node.
+            /// </summary>
+            exported CPUTopology() ;
+
+            /// <summary>
+            /// Get the logical cores available to the process.
+            /// </summary>
+            /// <returns>Logical cores, sorted by index.</returns>
+            exported const std::vector<LogicalCore>& cores() const {
+                return m_cores ;
+            }
+
+            /// <summary>
+            /// Get the amount of physical cores available to the process.
+            /// </summary>
+            /// <returns>Amount of physical cores.</returns>
+            exported size_t amountPhysicalCores() const {
+                return m_amountPhysicalCores ;
+            }
+
+            /// <summary>
+            /// Get the amount of NUMA nodes.
+            /// </summary>
+            /// <returns>Amount of NUMA nodes, at least 1.</returns>
+            exported size_t amountNumaNodes() const {
+                return m_amountNumaNodes ;
+            }
+
+            /// <summary>
+            /// Get the topology of the system, read once.
+            /// </summary>
+            /// <returns>Topology of the system.</returns>
+            exported static const CPUTopology& Get() ;
+
+            /// <summary>
+            /// Restrict the current thread to some logical cores.
+            /// </summary>
+            /// <param name="cores">
+            /// Indices of the logical cores (see LogicalCore::index). On
+            /// Windows, only the cores of the processor group of the first
+            /// one are used.
+            /// </param>
+            /// <returns>true on success; false otherwise.</returns>
+            exported static bool PinCurrentThread(std::span<const uint32_t> cores) ;
+
+        private:
+            /// <summary>
+            /// Compute the amounts of physical cores and nodes and the sibling
+            /// ranks from the cores.
+            /// </summary>
+            void index() ;
+    } ;
+}
+
+#endif
\ No newline at end of file
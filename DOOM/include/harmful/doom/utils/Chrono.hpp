@@ -7,9 +7,16 @@
 
 namespace Doom {
     /// <summary>
-    /// Measure elapsed time.
+    /// Measure elapsed time, with a monotonic clock: the measures are not
+    /// affected by the changes of the system time.
     /// </summary>
     class Chrono final {
+        public:
+            /// <summary>
+            /// Clock used for the measures.
+            /// </summary>
+            using Clock = std::chrono::steady_clock ;
+
         private:
             /// <summary>
             /// true if the chrono is started, false if stopped.
@@ -19,12 +26,12 @@ namespace Doom {
             /// <summary>
             /// Time point at which the chrono has been started.
             /// </summary>
-            std::chrono::time_point<std::chrono::system_clock> m_start ;
+            std::chrono::time_point<Clock> m_start ;
 
             /// <summary>
             /// Time point at which the chrono has been stopped.
             /// </summary>
-            std::chrono::time_point<std::chrono::system_clock> m_end ;
+            std::chrono::time_point<Clock> m_end ;
 
         public:
             /// <summary>
@@ -56,6 +63,26 @@ namespace Doom {
                 return std::chrono::duration_cast<ToDuration>(m_end - m_start).count() ;
             }
 
+            /// <summary>
+            /// Get the time elapsed since the chrono has been started, without
+            /// stopping it.
+            /// </summary>
+            /// <typeparam name="ToDuration">
+            /// Type of std::chrono::duration to convert the measured time.
+            /// </typeparam>
+            /// <returns>
+            /// Amount of elapsed time since the start of the current Chrono
+            /// session. Zero is returned if the Chrono is not started.
+            /// </returns>
+            template <class ToDuration>
+            exported std::intmax_t runningTime() const {
+                if (!isStarted()) {
+                    return 0 ;
+                }
+
+                return std::chrono::duration_cast<ToDuration>(Clock::now() - m_start).count() ;
+            }
+
             /// <summary>
             /// To know if the chrono is started.
             /// </summary>
@@ -0,0 +1,233 @@
+#include "harmful/doom/utils/CPUTopology.hpp"
+#include <algorithm>
+#include <map>
+#include <thread>
+#include <utility>
+
+#ifdef LinuxPlatform
+    #include <cctype>
+    #include <filesystem>
+    #include <fstream>
+    #include <string>
+    #include <pthread.h>
+    #include <sched.h>
+#elif defined(WindowsPlatform)
+    #include <windows.h>
+#endif
+
+namespace Doom {
+    #ifdef LinuxPlatform
+        namespace {
+            /// <summary>
+            /// Read a number in a file of the sysfs.
+            /// </summary>
+            /// <returns>The number; -1 if it cannot be read.</returns>
+            long ReadNumber(const std::filesystem::path& path) {
+                std::ifstream file(path) ;
+                long value = -1 ;
+
+                if (!(file >> value)) {
+                    return -1 ;
+                }
+
+                return value ;
+            }
+
+            /// <summary>
+            /// Check if a file name is the one of a NUMA node ("nodeN").
+            /// </summary>
+            bool IsNodeName(const std::string& name) {
+                auto isDigit = [](char character) {
+                    return std::isdigit(static_cast<unsigned char>(character)) != 0 ;
+                } ;
+
+                return (name.size() > 4)
+                    && (name.rfind("node", 0) == 0)
+                    && std::all_of(name.begin() + 4, name.end(), isDigit) ;
+            }
+        }
+
+        CPUTopology::CPUTopology() {
+            cpu_set_t available ;
+            CPU_ZERO(&available) ;
+
+            if (sched_getaffinity(0, sizeof(available), &available) != 0) {
+                for (uint32_t cpu = 0; cpu < std::max(std::thread::hardware_concurrency(), 1u); cpu++) {
+                    CPU_SET(cpu, &available) ;
+                }
+            }
+
+            const std::filesystem::path CPUsDirectory = "/sys/devices/system/cpu" ;
+            std::map<std::pair<long, long>, uint32_t> physicalCores ;
+
+            for (uint32_t cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+                if (!CPU_ISSET(cpu, &available)) {
+                    continue ;
+                }
+
+                auto directory = CPUsDirectory / ("cpu" + std::to_string(cpu)) ;
+                long package = ReadNumber(directory / "topology" / "physical_package_id") ;
+                long core = ReadNumber(directory / "topology" / "core_id") ;
+
+                // Without topology, a logical core is its own physical core.
+                auto key = (core < 0)
+                    ? std::make_pair(-1l, static_cast<long>(cpu))
+                    : std::make_pair(package, core) ;
+                auto physicalCore = physicalCores.try_emplace(key, static_cast<uint32_t>(physicalCores.size())).first ;
+
+                // The node of a CPU is a "nodeN" link in its directory.
+                uint32_t numaNode = 0 ;
+                std::error_code error ;
+
+                for (auto& entry : std::filesystem::directory_iterator(directory, error)) {
+                    auto name = entry.path().filename().string() ;
+
+                    if (IsNodeName(name)) {
+                        numaNode = static_cast<uint32_t>(std::stoul(name.substr(4))) ;
+                        break ;
+                    }
+                }
+
+                m_cores.push_back({
+                    cpu,
+                    physicalCore -> second,
+                    static_cast<uint32_t>(std::max(package, 0l)),
+                    numaNode,
+                    0
+                }) ;
+            }
+
+            index() ;
+        }
+
+        bool CPUTopology::PinCurrentThread(std::span<const uint32_t> cores) {
+            cpu_set_t affinity ;
+            CPU_ZERO(&affinity) ;
+
+            for (auto core : cores) {
+                if (core < CPU_SETSIZE) {
+                    CPU_SET(core, &affinity) ;
+                }
+            }
+
+            if (CPU_COUNT(&affinity) == 0) {
+                return false ;
+            }
+
+            return pthread_setaffinity_np(pthread_self(), sizeof(affinity), &affinity) == 0 ;
+        }
+    #elif defined(WindowsPlatform)
+        CPUTopology::CPUTopology() {
+            DWORD length = 0 ;
+            GetLogicalProcessorInformationEx(RelationAll, nullptr, &length) ;
+            std::vector<std::byte> buffer(length) ;
+            auto information = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data()) ;
+
+            if ((length > 0) && GetLogicalProcessorInformationEx(RelationAll, information, &length)) {
+                std::map<uint32_t, uint32_t> packages ;
+                std::map<uint32_t, uint32_t> numaNodes ;
+                uint32_t physicalCore = 0 ;
+                uint32_t package = 0 ;
+
+                for (DWORD offset = 0; offset < length;) {
+                    auto entry = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data() + offset) ;
+
+                    auto forEachCore = [](const GROUP_AFFINITY& group, auto&& function) {
+                        for (uint32_t bit = 0; bit < 64; bit++) {
+                            if (group.Mask & (KAFFINITY(1) << bit)) {
+                                function((static_cast<uint32_t>(group.Group) * 64) + bit) ;
+                            }
+                        }
+                    } ;
+
+                    switch (entry -> Relationship) {
+                        case RelationProcessorCore:
+                            for (WORD group = 0; group < entry -> Processor.GroupCount; group++) {
+                                forEachCore(entry -> Processor.GroupMask[group], [&](uint32_t core) {
+                                    m_cores.push_back({ core, physicalCore, 0, 0, 0 }) ;
+                                }) ;
+                            }
+
+                            physicalCore++ ;
+                            break ;
+
+                        case RelationProcessorPackage:
+                            for (WORD group = 0; group < entry -> Processor.GroupCount; group++) {
+                                forEachCore(entry -> Processor.GroupMask[group], [&](uint32_t core) {
+                                    packages[core] = package ;
+                                }) ;
+                            }
+
+                            package++ ;
+                            break ;
+
+                        case RelationNumaNode:
+                            forEachCore(entry -> NumaNode.GroupMask, [&](uint32_t core) {
+                                numaNodes[core] = static_cast<uint32_t>(entry -> NumaNode.NodeNumber) ;
+                            }) ;
+                            break ;
+
+                        default:
+                            break ;
+                    }
+
+                    offset += entry -> Size ;
+                }
+
+                for (auto& core : m_cores) {
+                    core.package = packages[core.index] ;
+                    core.numaNode = numaNodes[core.index] ;
+                }
+            }
+            else {
+                for (uint32_t core = 0; core < std::max(std::thread::hardware_concurrency(), 1u); core++) {
+                    m_cores.push_back({ core, core, 0, 0, 0 }) ;
+                }
+            }
+
+            index() ;
+        }
+
+        bool CPUTopology::PinCurrentThread(std::span<const uint32_t> cores) {
+            if (cores.empty()) {
+                return false ;
+            }
+
+            GROUP_AFFINITY affinity {} ;
+            affinity.Group = static_cast<WORD>(cores.front() / 64) ;
+
+            for (auto core : cores) {
+                if ((core / 64) == affinity.Group) {
+                    affinity.Mask |= KAFFINITY(1) << (core % 64) ;
+                }
+            }
+
+            return SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr) != 0 ;
+        }
+    #endif
+
+    const CPUTopology& CPUTopology::Get() {
+        static const CPUTopology Topology ;
+        return Topology ;
+    }
+
+    void CPUTopology::index() {
+        std::sort(
+            m_cores.begin(),
+            m_cores.end(),
+            [](const LogicalCore& first, const LogicalCore& second) {
+                return first.index < second.index ;
+            }
+        ) ;
+
+        std::map<uint32_t, uint32_t> amountSiblings ;
+        m_amountNumaNodes = 1 ;
+
+        for (auto& core : m_cores) {
+            core.siblingRank = amountSiblings[core.physicalCore]++ ;
+            m_amountNumaNodes = std::max<size_t>(m_amountNumaNodes, core.numaNode + 1) ;
+        }
+
+        m_amountPhysicalCores = amountSiblings.size() ;
+    }
+}
\ No newline at end of file
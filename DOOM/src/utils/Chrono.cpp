@@ -2,12 +2,12 @@
 
 namespace Doom {
     void Chrono::start() {
-        m_start = std::chrono::system_clock::now() ;
+        m_start = Clock::now() ;
         m_isStarted = true ;
     }
 
     void Chrono::stop() {
-        m_end = std::chrono::system_clock::now() ;
+        m_end = Clock::now() ;
         m_isStarted = false ;
     }
 
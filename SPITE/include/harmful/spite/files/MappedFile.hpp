@@ -0,0 +1,78 @@
+#ifndef __SPITE__MAPPED_FILE__
+#define __SPITE__MAPPED_FILE__
+
+#include <cstddef>
+#include <filesystem>
+#include <harmful/doom/utils/Platform.hpp>
+
+namespace fs = std::filesystem ;
+
+namespace Spite {
+    /// <summary>
+    /// Read-only view of a whole file mapped in memory. The content is loaded
+    /// by the operating system on demand, without being copied in a buffer.
+    /// </summary>
+    class MappedFile final {
+        private:
+            /// <summary>
+            /// First byte of the mapped file; nullptr if empty.
+            /// </summary>
+            const std::byte* m_data = nullptr ;
+
+            /// <summary>
+            /// Size of the file in bytes.
+            /// </summary>
+            size_t m_size = 0 ;
+
+            #ifdef WindowsPlatform
+                /// <summary>
+                /// Handle of the file.
+                /// </summary>
+                void* m_file = nullptr ;
+
+                /// <summary>
+                /// Handle of the mapping of the file.
+                /// </summary>
+                void* m_mapping = nullptr ;
+            #endif
+
+        public:
+            /// <summary>
+            /// Map a file in memory.
+            /// </summary>
+            /// <param name="path">Path to the file.</param>
+            /// <exception cref="std::ios_base::failure">
+            /// The file cannot be opened or mapped.
+            /// </exception>
+            exported MappedFile(const fs::path& path) ;
+
+            /// <summary>
+            /// Destruction of the MappedFile, unmapping the file.
+            /// </summary>
+            exported ~MappedFile() noexcept ;
+
+            /// <summary>
+            /// Get the content of the file.
+            /// </summary>
+            /// <returns>First byte of the file; nullptr if empty.</returns>
+            exported const std::byte* data() const {
+                return m_data ;
+            }
+
+            /// <summary>
+            /// Get the size of the file.
+            /// </summary>
+            /// <returns>Size of the file in bytes.</returns>
+            exported size_t size() const {
+                return m_size ;
+            }
+
+            // Remove copy/move operations.
+            MappedFile(const MappedFile& copied) = delete ;
+            MappedFile(MappedFile&& moved) = delete ;
+            MappedFile& operator=(const MappedFile& copied) = delete ;
+            MappedFile& operator=(MappedFile&& moved) = delete ;
+    } ;
+}
+
+#endif
\ No newline at end of file
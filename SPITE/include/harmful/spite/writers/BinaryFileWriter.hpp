@@ -65,6 +65,15 @@ namespace Spite {
             exported virtual void writeString(
                 const std::string& text
             ) = 0 ;
+
+            /// <summary>
+            /// Write a blob of bytes at once, as they are in memory.
+            /// </summary>
+            /// <param name="blob">Bytes to write in the File.</param>
+            /// <param name="size">Amount of bytes to write.</param>
+            exported void writeBytes(const char* blob, const size_t size) {
+                m_stream -> write(blob, size) ;
+            }
     } ;
 }
 
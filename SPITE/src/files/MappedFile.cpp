@@ -0,0 +1,109 @@
+#include "harmful/spite/files/MappedFile.hpp"
+#include "harmful/spite/SPITEStrings.hpp"
+#include <ios>
+
+#ifdef LinuxPlatform
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#elif defined(WindowsPlatform)
+    #include <windows.h>
+#endif
+
+using namespace Spite ;
+
+#ifdef LinuxPlatform
+    MappedFile::MappedFile(const fs::path& path) {
+        int file = open(path.c_str(), O_RDONLY) ;
+
+        if (file < 0) {
+            throw std::ios_base::failure(FileMsg::Error::UnableToOpen + path.string()) ;
+        }
+
+        struct stat status ;
+
+        if (fstat(file, &status) != 0) {
+            close(file) ;
+            throw std::ios_base::failure(FileMsg::Error::UnableToOpen + path.string()) ;
+        }
+
+        m_size = static_cast<size_t>(status.st_size) ;
+
+        if (m_size > 0) {
+            void* mapping = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0) ;
+
+            if (mapping == MAP_FAILED) {
+                close(file) ;
+                throw std::ios_base::failure(FileMsg::Error::FailureOnOpening + path.string()) ;
+            }
+
+            m_data = static_cast<const std::byte*>(mapping) ;
+        }
+
+        // The mapping stays valid once the file is closed.
+        close(file) ;
+    }
+
+    MappedFile::~MappedFile() noexcept {
+        if (m_data) {
+            munmap(const_cast<std::byte*>(m_data), m_size) ;
+        }
+    }
+#elif defined(WindowsPlatform)
+    MappedFile::MappedFile(const fs::path& path) {
+        m_file = CreateFileW(
+            path.c_str(),
+            GENERIC_READ,
+            FILE_SHARE_READ,
+            nullptr,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+            nullptr
+        ) ;
+
+        if (m_file == INVALID_HANDLE_VALUE) {
+            m_file = nullptr ;
+            throw std::ios_base::failure(FileMsg::Error::UnableToOpen + path.string()) ;
+        }
+
+        LARGE_INTEGER fileSize ;
+
+        if (!GetFileSizeEx(m_file, &fileSize)) {
+            CloseHandle(m_file) ;
+            throw std::ios_base::failure(FileMsg::Error::UnableToOpen + path.string()) ;
+        }
+
+        m_size = static_cast<size_t>(fileSize.QuadPart) ;
+
+        if (m_size > 0) {
+            m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr) ;
+            void* view = m_mapping ? MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr ;
+
+            if (!view) {
+                if (m_mapping) {
+                    CloseHandle(m_mapping) ;
+                }
+
+                CloseHandle(m_file) ;
+                throw std::ios_base::failure(FileMsg::Error::FailureOnOpening + path.string()) ;
+            }
+
+            m_data = static_cast<const std::byte*>(view) ;
+        }
+    }
+
+    MappedFile::~MappedFile() noexcept {
+        if (m_data) {
+            UnmapViewOfFile(m_data) ;
+        }
+
+        if (m_mapping) {
+            CloseHandle(m_mapping) ;
+        }
+
+        if (m_file) {
+            CloseHandle(m_file) ;
+        }
+    }
+#endif
\ No newline at end of file